@@ -0,0 +1,129 @@
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+/*
+Example: 		adaptive_ventilation.ino
+Library:		AcksenPump
+Author: 		Acksen Ltd
+
+Created:		16 Oct 2026
+Last Modified:		16 Oct 2026
+
+Description:
+End Pump Ventilation as soon as a flow meter shows steady flow, using an AcksenPrimeMonitor.
+Ventilation is extended while an air lock persists, and the pump is stopped if it never primes.
+The time to full flow, and the time saved against the fixed Ventilation, are reported after each start.
+
+*/
+
+#include <AcksenPump.h>
+
+// ***********************************
+// Serial Debug
+// ***********************************
+#define DEBUG_BAUD_RATE			115200
+
+
+// ***********************************
+// I/O  
+// ***********************************
+#define PUMP_OUT_IO					13
+#define FLOW_METER_IN_IO			2		// Hall effect flow meter, on an interrupt capable pin
+
+
+// ***********************************
+// Constants
+// ***********************************
+#define FLOW_PRIMED_PULSES			3		// Fewest flow meter pulses per sample period counted as flowing
+
+
+// ***********************************
+// Variables
+// ***********************************
+AcksenPump WaterPump(PUMP_OUT_IO, -1);
+AcksenPrimeMonitor WaterPumpPriming;
+AcksenPumpEventQueue PumpEvents;
+
+
+// ************************************************
+// Flow Meter Interrupt
+// ************************************************
+void flowMeterPulse()
+{
+	WaterPumpPriming.countPulse();
+}
+
+
+// ************************************************
+// Setup 
+// ************************************************
+void setup()
+{
+
+	// Initialise Serial Port
+	Serial.begin(DEBUG_BAUD_RATE);
+
+	// Count flow meter pulses
+	pinMode(FLOW_METER_IN_IO, INPUT_PULLUP);
+	attachInterrupt(digitalPinToInterrupt(FLOW_METER_IN_IO), flowMeterPulse, FALLING);
+
+	// Adapt Pump Ventilation to the flow meter
+	WaterPumpPriming.ui8Source = PRIME_SOURCE_FLOW_PULSES;
+	WaterPumpPriming.uiPrimedLevel = FLOW_PRIMED_PULSES;
+
+	WaterPump.bEnablePumpVentilation = true;
+	WaterPump.attachPrimeMonitor(&WaterPumpPriming);
+	WaterPump.attachEventQueue(&PumpEvents, 0);
+
+	// Start the Pump
+	WaterPump.ToggleState();
+
+	Serial.println("Startup Complete!");
+	
+}
+
+// ************************************************
+// Main Control Loop
+// ************************************************
+void loop()
+{
+
+	// Run the Pump Control Loop
+	WaterPump.process();
+
+	// Report priming results
+	AcksenPumpEvent evEvent;
+
+	while (PumpEvents.pop(evEvent) == true)
+	{
+
+		if (evEvent.ui8Type == PUMP_EVENT_PRIMED)
+		{
+			Serial.print("*** Primed - time to full flow = ");
+			Serial.print(WaterPumpPriming.timeToFullFlow());
+			Serial.print(" ms, saved = ");
+			Serial.print(WaterPumpPriming.timeSaved());
+			Serial.print(" ms, extra cycles = ");
+			Serial.println(WaterPumpPriming.extraCycles());
+		}
+		else if (evEvent.ui8Type == PUMP_EVENT_DRY_RUN)
+		{
+			Serial.println((evEvent.ui8Value != 0) ? "*** Air lock never cleared - Pump stopped!" : "*** No flow - Pump stopped to prevent running dry!");
+		}
+
+	}
+
+}
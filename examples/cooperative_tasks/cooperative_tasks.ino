@@ -0,0 +1,126 @@
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+/*
+Example: 		cooperative_tasks.ino
+Library:		AcksenPump
+Author: 		Acksen Ltd
+
+Created:		16 Oct 2026
+Last Modified:		16 Oct 2026
+
+Description:
+Run two pumps as tasks in a minimal cooperative scheduler, using AcksenPump::step().
+Each task is only run when its wake time is reached, and neither pump ever blocks the other, or the rest of the loop.
+
+*/
+
+#include <AcksenPump.h>
+
+// ***********************************
+// Serial Debug
+// ***********************************
+#define DEBUG_BAUD_RATE			115200
+
+
+// ***********************************
+// I/O  
+// ***********************************
+#define MASH_PUMP_OUT_IO				12
+#define WORT_PUMP_OUT_IO				13
+
+
+// ***********************************
+// Constants
+// ***********************************
+#define PUMP_TASK_COUNT					2
+
+
+// ***********************************
+// Variables
+// ***********************************
+AcksenPump MashPump(MASH_PUMP_OUT_IO, -1);
+AcksenPump WortPump(WORT_PUMP_OUT_IO, -1);
+
+AcksenPump *pPumpTasks[PUMP_TASK_COUNT] = { &MashPump, &WortPump };
+unsigned long ulPumpTaskWake[PUMP_TASK_COUNT];		// Time each pump task should next be run
+uint8_t ui8PumpTaskReason[PUMP_TASK_COUNT];			// Reason each pump task last yielded
+
+
+// ************************************************
+// Setup 
+// ************************************************
+void setup()
+{
+
+	// Initialise Serial Port
+	Serial.begin(DEBUG_BAUD_RATE);
+
+	// Vent both pumps when starting
+	MashPump.bEnablePumpVentilation = true;
+	WortPump.bEnablePumpVentilation = true;
+
+	// Start both pumps, and run each task straight away
+	for (uint8_t i = 0; i < PUMP_TASK_COUNT; i++)
+	{
+		pPumpTasks[i]->ToggleState();
+		ulPumpTaskWake[i] = millis();
+		ui8PumpTaskReason[i] = PUMP_YIELD_READY;
+	}
+
+	Serial.println("Startup Complete!");
+	
+}
+
+// ************************************************
+// Main Control Loop
+// ************************************************
+void loop()
+{
+
+	// Run each pump task that is due
+	for (uint8_t i = 0; i < PUMP_TASK_COUNT; i++)
+	{
+
+		if ((long)(millis() - ulPumpTaskWake[i]) >= 0)
+		{
+
+			uint8_t ui8Reason = pPumpTasks[i]->step(ulPumpTaskWake[i]);
+
+			if (ui8Reason != ui8PumpTaskReason[i])
+			{
+
+				Serial.print("Pump ");
+				Serial.print(i);
+				Serial.print(" yielded, reason = ");
+				Serial.print(ui8Reason);
+				Serial.print(", wake in ");
+				Serial.print(ulPumpTaskWake[i] - millis());
+				Serial.println(" ms");
+
+				ui8PumpTaskReason[i] = ui8Reason;
+
+			}
+
+		}
+
+	}
+
+	// Any input change (ToggleState(), updatePumpTemperature(), etc) should set that task's wake time to millis(), so it runs straight away
+
+	// Other cooperative tasks run here
+
+}
@@ -0,0 +1,122 @@
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+/*
+Example: 		pump_sequence.ino
+Library:		AcksenPump
+Author: 		Acksen Ltd
+
+Created:		16 Oct 2026
+Last Modified:		16 Oct 2026
+
+Description:
+Run a custom Pump Sequence, stored in flash, using the AcksenPump library.
+The pump is primed with three short pulses, then pulse recirculates until the Pump Temperature reaches 70C.
+
+*/
+
+#include <AcksenPump.h>
+
+// ***********************************
+// Serial Debug
+// ***********************************
+#define DEBUG_BAUD_RATE			115200
+
+
+// ***********************************
+// I/O  
+// ***********************************
+#define PUMP_OUT_IO					13
+
+
+// ***********************************
+// Constants
+// ***********************************
+#define SERIAL_DEBUG_OUTPUT_TIMER_MS			1000	// How often pump status will be output via debug serial, in milliseconds
+
+
+// ***********************************
+// Sequences
+// ***********************************
+const AcksenPumpStep PrimeAndRecirculate[] PROGMEM =
+{
+	// Prime - 3 x (1.5s ON, 1s OFF)
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_MILLIS,		1500,	0,							0,	PUMP_STEP_EXIT_NONE,				0 },
+	{ PUMP_OUTPUT_STATE_OFF,	PUMP_STEP_DURATION_MILLIS,		1000,	3,							0,	PUMP_STEP_EXIT_NONE,				0 },
+
+	// Pulse Recirculation - 30s ON, 90s OFF, until the Pump Temperature reaches 70C
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_SECONDS,		30,		0,							0,	PUMP_STEP_EXIT_TEMPERATURE_ABOVE,	70 },
+	{ PUMP_OUTPUT_STATE_OFF,	PUMP_STEP_DURATION_SECONDS,		90,		PUMP_STEP_REPEAT_FOREVER,	2,	PUMP_STEP_EXIT_TEMPERATURE_ABOVE,	70 },
+
+	// Then run continuously
+	{ PUMP_STEP_END,			0,								PUMP_CONTROL_ON,	0,			0,	PUMP_STEP_EXIT_NONE,				0 }
+};
+
+
+// ***********************************
+// Variables
+// ***********************************
+AcksenPump WaterPump(PUMP_OUT_IO, -1);
+
+unsigned long ulPumpDebugOutputTimer;	// Timer used to output pump status via debug serial periodically
+
+
+// ************************************************
+// Setup 
+// ************************************************
+void setup()
+{
+
+	// Initialise Serial Port
+	Serial.begin(DEBUG_BAUD_RATE);
+
+	// Setup Timers
+	ulPumpDebugOutputTimer = millis() + SERIAL_DEBUG_OUTPUT_TIMER_MS;
+
+	// Start the Sequence
+	WaterPump.runSequence(PrimeAndRecirculate);
+	Serial.println("*** Sequence started!");
+
+	Serial.println("Startup Complete!");
+	
+}
+
+// ************************************************
+// Main Control Loop
+// ************************************************
+void loop()
+{
+
+	// Run the Pump Control Loop (advancing the Sequence, max temperature checks, etc)
+	WaterPump.process();
+
+	// Update the Pump Temperature here from a probe, using WaterPump.updatePumpTemperature()
+
+	// Check if time to output debug serial status on pump
+	if (ulPumpDebugOutputTimer <= millis())
+	{
+
+		Serial.print("Pump Control State = ");
+		Serial.print(WaterPump.iControlState);
+		Serial.print(", Pump Output = ");
+		Serial.println((WaterPump.iOutputStateActual == PUMP_OUTPUT_STATE_ON) ? "ON" : "OFF");
+
+		// Update Timer for next execution
+		ulPumpDebugOutputTimer = millis() + SERIAL_DEBUG_OUTPUT_TIMER_MS;
+
+	}
+
+}
@@ -0,0 +1,116 @@
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+/*
+Example: 		pump_telemetry.ino
+Library:		AcksenPump
+Author: 		Acksen Ltd
+
+Created:		16 Oct 2026
+Last Modified:		16 Oct 2026
+
+Description:
+Report pump status as a compact binary telemetry stream, rather than formatted text.
+Snapshots are sent each second, with unchanged fields left out, and every Output/Control State transition is sent as an event.
+The transmit buffer is only drained as fast as the serial port accepts bytes, so the pump control loop never waits on the UART.
+Decode the stream with extras/host/telemetry_decode.cpp.
+
+*/
+
+#include <AcksenPump.h>
+#include <AcksenPumpTelemetry.h>
+
+// ***********************************
+// Serial Telemetry
+// ***********************************
+#define TELEMETRY_BAUD_RATE			115200
+
+
+// ***********************************
+// I/O  
+// ***********************************
+#define PUMP_OUT_IO					13
+
+
+// ***********************************
+// Constants
+// ***********************************
+#define PUMP_ID								0		// Id of the pump in telemetry frames and events
+#define TELEMETRY_SNAPSHOT_TIMER_MS			1000	// How often pump snapshots are sent, in milliseconds
+
+
+// ***********************************
+// Variables
+// ***********************************
+AcksenPump WaterPump(PUMP_OUT_IO, -1);
+
+AcksenPumpEventQueue PumpEvents;
+AcksenPumpTelemetry Telemetry;
+
+unsigned long ulTelemetrySnapshotTimer;		// Timer used to send pump snapshots periodically
+
+
+// ************************************************
+// Setup 
+// ************************************************
+void setup()
+{
+
+	// Initialise Serial Port
+	Serial.begin(TELEMETRY_BAUD_RATE);
+
+	// Report every transition, and periodic snapshots
+	WaterPump.attachEventQueue(&PumpEvents, PUMP_ID);
+	Telemetry.addPump(&WaterPump, PUMP_ID);
+
+	// Enable Pump Ventilation System
+	WaterPump.bEnablePumpVentilation = true;
+
+	// Setup Timers
+	ulTelemetrySnapshotTimer = millis();
+
+	// Turn the Pump ON, at the start
+	WaterPump.ToggleState();
+	
+}
+
+// ************************************************
+// Main Control Loop
+// ************************************************
+void loop()
+{
+
+	// Run the Pump Control Loop (automatically updating pump ventilation state, max temperature checks, etc)
+	WaterPump.process();
+
+	// Queue any transitions as event frames
+	Telemetry.sendEvents(PumpEvents);
+
+	// Check if time to send pump snapshots
+	if ((long)(millis() - ulTelemetrySnapshotTimer) >= 0)
+	{
+
+		Telemetry.sendSnapshots();
+
+		// Update Timer for next execution
+		ulTelemetrySnapshotTimer += TELEMETRY_SNAPSHOT_TIMER_MS;
+
+	}
+
+	// Write whatever the serial port will take without blocking
+	Telemetry.drain(Serial);
+
+}
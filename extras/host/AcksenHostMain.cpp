@@ -0,0 +1,63 @@
+/*!
+@file AcksenHostMain.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+//
+// Entry point for sketches built natively on a Linux host.
+//
+// Usage: <sketch> [run time limit, in seconds]
+// The optional limit ends the program cleanly, as sketches often halt in an endless loop when complete.
+//
+
+#include "Arduino.h"
+
+#include <signal.h>
+#include <stdlib.h>
+
+AcksenHostSerial Serial;
+
+void setup();
+void loop();
+
+static void runTimeLimitElapsed(int)
+{
+	_exit(0);
+}
+
+int main(int argc, char **argv)
+{
+
+	if (argc > 1)
+	{
+		signal(SIGALRM, runTimeLimitElapsed);
+		alarm((unsigned int)atoi(argv[1]));
+	}
+
+	setup();
+
+	while (true)
+	{
+		loop();
+	}
+
+	return 0;
+
+}
@@ -0,0 +1,105 @@
+/*!
+@file Arduino.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Minimal Arduino core stand-in for building sketches natively on a Linux host.
+// All GPIO and timing calls are forwarded to the AcksenHalHost backend, so sketch and library share the same simulated pins and clock.
+//
+
+#ifndef AcksenHostArduino_h
+#define AcksenHostArduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "AcksenPumpHalHost.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline void pinMode(int iPin, int iMode) { AcksenHalHost::setPinMode(iPin, iMode); }
+inline int digitalRead(int iPin) { return AcksenHalHost::readPin(iPin); }
+inline void digitalWrite(int iPin, int iLevel) { AcksenHalHost::writePin(iPin, iLevel); }
+
+inline unsigned long millis() { return AcksenHalHost::timeMillis(); }
+inline unsigned long micros() { return AcksenHalHost::timeMicros(); }
+inline void delay(unsigned long ulMillis) { AcksenHalHost::sleepMillis(ulMillis); }
+inline void delayMicroseconds(unsigned int uiMicros) { AcksenHalHost::sleepMicros(uiMicros); }
+
+inline int digitalPinToInterrupt(int iPin) { return AcksenHalHost::pinInterrupt(iPin); }
+inline void attachInterrupt(int iInterrupt, void (*isr)(), int iMode) { AcksenHalHost::attachPinInterrupt(iInterrupt, isr, iMode); }
+inline void detachInterrupt(int iInterrupt) { AcksenHalHost::detachPinInterrupt(iInterrupt); }
+inline void noInterrupts() {}
+inline void yield() {}
+inline void interrupts() {}
+
+/**************************************************************************/
+/*! 
+    @brief  Serial stand-in that writes to stdout, unbuffered
+*/
+/**************************************************************************/
+class AcksenHostSerial
+{
+
+public:
+
+	void begin(unsigned long) {}
+	void end() {}
+	int available() { return 0; }
+	int read() { return -1; }
+	int availableForWrite() { return 64; }
+	void flush() {}
+
+	size_t write(uint8_t ui8Byte) { return (::write(1, &ui8Byte, 1) == 1) ? 1 : 0; }
+	size_t write(const uint8_t *pBuffer, size_t size) { ssize_t iWritten = ::write(1, pBuffer, size); return (iWritten > 0) ? (size_t)iWritten : 0; }
+
+	size_t print(const char *pText) { return write((const uint8_t *)pText, strlen(pText)); }
+	size_t print(char cValue) { return write((uint8_t)cValue); }
+	size_t print(int iValue) { return printFormat("%d", iValue); }
+	size_t print(unsigned int uiValue) { return printFormat("%u", uiValue); }
+	size_t print(long lValue) { return printFormat("%ld", lValue); }
+	size_t print(unsigned long ulValue) { return printFormat("%lu", ulValue); }
+	size_t print(double dValue, int iDigits = 2) { return printFormat("%.*f", iDigits, dValue); }
+
+	size_t println() { return print("\r\n"); }
+	template <typename T> size_t println(T value) { size_t size = print(value); return size + println(); }
+
+	operator bool() { return true; }
+
+protected:
+
+	template <typename... Args> size_t printFormat(const char *pFormat, Args... args)
+	{
+		char cBuffer[48];
+		int iLength = snprintf(cBuffer, sizeof(cBuffer), pFormat, args...);
+		return write((const uint8_t *)cBuffer, (iLength < (int)sizeof(cBuffer)) ? iLength : (sizeof(cBuffer) - 1));
+	}
+
+};
+
+extern AcksenHostSerial Serial;
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+@file EEPROM.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Minimal Arduino EEPROM library stand-in for building natively on a Linux host, so AcksenEepromStorage (AcksenPumpEeprom.h) can be built and tested.
+// Holds ACKSEN_HOST_EEPROM_SIZE bytes in RAM, erased to 0xFF.  Contents are lost when the program exits - use AcksenHostFileStorage to keep settings between runs.
+//
+
+#ifndef AcksenHostEEPROM_h
+#define AcksenHostEEPROM_h
+
+#include <stdint.h>
+#include <string.h>
+
+#define ACKSEN_HOST_EEPROM_SIZE		1024	///< Size of the simulated EEPROM, in Bytes (as an ATmega328P).
+
+/**************************************************************************/
+/*! 
+    @brief  EEPROM stand-in, with the read()/write()/update()/length() calls used by AcksenEepromStorage
+*/
+/**************************************************************************/
+class AcksenHostEEPROM
+{
+
+public:
+
+	uint8_t read(int iAddress) { return cells()[iAddress % ACKSEN_HOST_EEPROM_SIZE]; }
+	void write(int iAddress, uint8_t ui8Value) { cells()[iAddress % ACKSEN_HOST_EEPROM_SIZE] = ui8Value; }
+	void update(int iAddress, uint8_t ui8Value) { if (read(iAddress) != ui8Value) { write(iAddress, ui8Value); } }
+	uint16_t length() { return ACKSEN_HOST_EEPROM_SIZE; }
+
+	// Host only - return every cell to the erased state
+	void erase() { memset(cells(), 0xFF, ACKSEN_HOST_EEPROM_SIZE); }
+
+protected:
+
+	// One shared array, however many translation units include this header
+	static uint8_t *cells()
+	{
+		static struct Cells
+		{
+			uint8_t ui8Data[ACKSEN_HOST_EEPROM_SIZE];
+			Cells() { memset(ui8Data, 0xFF, sizeof(ui8Data)); }
+		} clCells;
+
+		return clCells.ui8Data;
+	}
+
+};
+
+static AcksenHostEEPROM EEPROM;
+
+#endif
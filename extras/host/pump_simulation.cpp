@@ -0,0 +1,148 @@
+/*!
+@file pump_simulation.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+//
+// Simulate a week of brew days on two pumps with AcksenPumpSim, then print the start of the timeline and check the invariants.
+//
+// Usage: make sim
+//
+
+#include "AcksenPumpSim.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define MASH_PUMP_OUT_IO				12
+#define WORT_PUMP_OUT_IO				13
+#define PHASE_SYNC_IN_IO				2
+
+#define SIM_HOUR_MS						3600000UL
+#define SIM_DAY_MS						(24UL * SIM_HOUR_MS)
+#define SIM_DAYS						7
+#define SIM_START_MICROS				((0x100000000ULL - (3ULL * SIM_DAY_MS)) * 1000ULL)	// millis() rolls over on day 3
+
+// One brew day, repeated each day
+static const AcksenPumpSimEvent BrewDay[] =
+{
+	// Mash - vent and run the mash pump, heating from 20C to 67C
+	{ 6 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TEMPERATURE,		0,	2000 },
+	{ 6 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TOGGLE,				0,	0 },
+	{ 6 * SIM_HOUR_MS + 1200000UL,		PUMP_SIM_ACTION_TEMPERATURE,		0,	5200 },
+	{ 6 * SIM_HOUR_MS + 2400000UL,		PUMP_SIM_ACTION_TEMPERATURE,		0,	6700 },
+
+	// Element fault - temperature runs away past the 93C limit, then recovers
+	{ 8 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TEMPERATURE,		0,	9000 },
+	{ 8 * SIM_HOUR_MS + 60000UL,		PUMP_SIM_ACTION_TEMPERATURE,		0,	9550 },
+	{ 8 * SIM_HOUR_MS + 600000UL,		PUMP_SIM_ACTION_TEMPERATURE,		0,	6700 },
+	{ 8 * SIM_HOUR_MS + 660000UL,		PUMP_SIM_ACTION_TOGGLE,				0,	0 },
+
+	// Wort transfer - phase synchronised pump, at half flow for the first 20 minutes
+	{ 9 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TOGGLE,				1,	0 },
+	{ 9 * SIM_HOUR_MS,					PUMP_SIM_ACTION_FLOW,				1,	50 },
+	{ 9 * SIM_HOUR_MS + 1200000UL,		PUMP_SIM_ACTION_FLOW,				1,	100 },
+	{ 10 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TOGGLE,				1,	0 },
+
+	// Mains dropout during the boil, then both pumps stopped for the day
+	{ 11 * SIM_HOUR_MS,					PUMP_SIM_ACTION_PHASE_FREQUENCY,	0,	0 },
+	{ 11 * SIM_HOUR_MS + 5000UL,		PUMP_SIM_ACTION_PHASE_FREQUENCY,	0,	50 },
+	{ 12 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TURN_OFF,			0,	0 },
+	{ 12 * SIM_HOUR_MS,					PUMP_SIM_ACTION_TURN_OFF,			1,	0 }
+};
+
+AcksenPump MashPump(MASH_PUMP_OUT_IO, -1);
+AcksenPump WortPump(WORT_PUMP_OUT_IO, PHASE_SYNC_IN_IO);
+
+static AcksenPumpSimTransition Timeline[64];
+
+// Outputs must never both switch in the same millisecond, as the pumps share a supply
+static bool outputsStaggered(AcksenPump *pPump, uint8_t ui8Pump, void *pContext)
+{
+
+	(void)pPump;
+	(void)ui8Pump;
+	(void)pContext;
+
+	static const int iOutputs[2] = { MASH_PUMP_OUT_IO, WORT_PUMP_OUT_IO };
+	static unsigned long ulChanges[2] = { 0, 0 };
+	static unsigned long ulChangeMillis[2] = { 0, 0 };
+
+	for (int i = 0; i < 2; i++)
+	{
+
+		unsigned long ulCount = AcksenHalHost::pinChangeCount(iOutputs[i]);
+
+		if (ulCount != ulChanges[i])
+		{
+			ulChanges[i] = ulCount;
+			ulChangeMillis[i] = AcksenHalHost::timeMillis();
+		}
+
+	}
+
+	return ((ulChanges[0] == 0) || (ulChanges[1] == 0) || (ulChangeMillis[0] != ulChangeMillis[1]));
+
+}
+
+int main(void)
+{
+
+	AcksenPumpSim Sim(SIM_START_MICROS);
+
+	MashPump.bEnablePumpVentilation = true;
+	WortPump.bEnablePumpVentilation = false;
+	WortPump.bEnablePhaseSync = true;
+	WortPump.iPhaseSyncPreActivationDelay = 2;
+
+	Sim.addPump(&MashPump);
+	Sim.addPump(&WortPump);
+	Sim.setPhaseInput(PHASE_SYNC_IN_IO, 50);
+	Sim.setScenario(BrewDay, sizeof(BrewDay) / sizeof(BrewDay[0]), SIM_DAY_MS);
+	Sim.setInvariant(outputsStaggered, NULL);
+	Sim.setTimeline(Timeline, sizeof(Timeline) / sizeof(Timeline[0]));
+
+	clock_t ctStart = clock();
+
+	unsigned long ulViolations = Sim.run(SIM_DAYS * SIM_DAY_MS);
+
+	double dElapsed = (double)(clock() - ctStart) / CLOCKS_PER_SEC;
+
+	Sim.printTimeline(stdout);
+
+	printf("\nSimulated %d days in %.3f s: %lu steps, %lu transitions, %lu invariant violations\n",
+		SIM_DAYS, dElapsed, Sim.stepCount(), Sim.transitionCount(), ulViolations);
+
+	if (ulViolations != 0)
+	{
+
+		uint8_t ui8Pump;
+		uint64_t ullMicros;
+		uint8_t ui8Invariant = Sim.firstViolation(ui8Pump, ullMicros);
+
+		printf("First violation: invariant %u, pump %u, at %.3f s\n", ui8Invariant, ui8Pump, (double)ullMicros / 1000000.0);
+
+		return EXIT_FAILURE;
+
+	}
+
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,102 @@
+/*!
+@file telemetry_decode.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+//
+// Decode an AcksenPumpTelemetry stream from a file, or a pipe on stdin, and print it as text.
+//
+// Usage: make decode
+//        build/telemetry_decode [capture file]
+//        make run EXAMPLE=pump_telemetry RUN_SECONDS=60 | build/telemetry_decode
+//
+
+#include "AcksenPumpTelemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *controlStateName(uint8_t ui8ControlState)
+{
+
+	static const char *pNames[] = { "STOP", "VENT", "ON", "GRAIN REST", "SEQUENCE" };
+
+	return (ui8ControlState <= PUMP_CONTROL_SEQUENCE) ? pNames[ui8ControlState] : "?";
+
+}
+
+int main(int argc, char **argv)
+{
+
+	FILE *pInput = stdin;
+
+	if (argc > 1)
+	{
+
+		pInput = fopen(argv[1], "rb");
+
+		if (pInput == NULL)
+		{
+			perror(argv[1]);
+			return EXIT_FAILURE;
+		}
+
+	}
+
+	AcksenPumpTelemetryDecoder Decoder;
+	int iByte;
+
+	while ((iByte = fgetc(pInput)) != EOF)
+	{
+
+		uint8_t ui8Frame = Decoder.feed((uint8_t)iByte);
+
+		if (ui8Frame == PUMP_TELEMETRY_FRAME_SNAPSHOT)
+		{
+
+			const AcksenPumpTelemetryState &stState = Decoder.snapshot();
+
+			printf("%10.3f  pump %u  %-10s  output %-3s  %6.2f C  flow %3u%%%s\n",
+				(double)stState.ulTimeMillis / 1000.0, stState.ui8PumpId, controlStateName(stState.ui8ControlState),
+				(stState.ui8OutputState == PUMP_OUTPUT_STATE_ON) ? "ON" : "OFF", (double)stState.iTemperatureCenti / 100.0,
+				stState.ui8FlowPercent, (stState.bValid == true) ? "" : "  (awaiting key frame)");
+
+		}
+		else if (ui8Frame == PUMP_TELEMETRY_FRAME_EVENT)
+		{
+
+			const AcksenPumpEvent &evEvent = Decoder.event();
+
+			printf("%10.3f  pump %u  event %u, value %u\n", (double)evEvent.ulTimeMillis / 1000.0, evEvent.ui8PumpId, evEvent.ui8Type, evEvent.ui8Value);
+
+		}
+
+	}
+
+	printf("%lu frames, %lu errors, %lu lost\n", Decoder.frameCount(), Decoder.errorCount(), Decoder.lostCount());
+
+	if (pInput != stdin)
+	{
+		fclose(pInput);
+	}
+
+	return EXIT_SUCCESS;
+
+}
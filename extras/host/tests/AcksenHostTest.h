@@ -0,0 +1,58 @@
+// Acksen Pump Library v1.9.0
+//
+// Minimal checks for the host tests.  Each test is a standalone program, run by "make test", that returns non-zero if any check failed.
+//
+
+#ifndef AcksenHostTest_h
+#define AcksenHostTest_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+static int _iHostTestFailures = 0;
+static int _iHostTestChecks = 0;
+
+#define CHECK(condition)																\
+	do																					\
+	{																					\
+		_iHostTestChecks++;																\
+		if (!(condition))																\
+		{																				\
+			_iHostTestFailures++;														\
+			printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);		\
+		}																				\
+	} while (0)
+
+#define CHECK_EQUAL(expected, actual)													\
+	do																					\
+	{																					\
+		long _lExpected = (long)(expected);												\
+		long _lActual = (long)(actual);													\
+		_iHostTestChecks++;																\
+		if (_lExpected != _lActual)														\
+		{																				\
+			_iHostTestFailures++;														\
+			printf("%s:%d: CHECK_EQUAL failed: %s == %ld, expected %ld\n", __FILE__, __LINE__, #actual, _lActual, _lExpected);	\
+		}																				\
+	} while (0)
+
+// Virtual clock start, in Microseconds, for millis() to roll over the given number of Seconds into a test
+static inline uint64_t hostRolloverStart(unsigned long ulSeconds)
+{
+	return (0x100000000ULL - (ulSeconds * 1000ULL)) * 1000ULL;
+}
+
+// Deadlines are compared rollover safe, so may not be wrapped to 32 bits on a 64-bit host - wrap an expected time to match
+static inline unsigned long wrapMillis(unsigned long ulMillis)
+{
+	return (uint32_t)ulMillis;
+}
+
+// Print the result, and give the exit code for main()
+static inline int hostTestResult(const char *pName)
+{
+	printf("%s: %d checks, %d failed\n", pName, _iHostTestChecks, _iHostTestFailures);
+	return (_iHostTestFailures == 0) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,318 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpBank batched switching (blocking and non-blocking), ventilation timing, per-pump Maximum Pump Temperature, turnOffAll() and rejection of invalid pump indexes.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPumpBank.h"
+
+#define PUMP_1_OUT_IO		3
+#define PUMP_2_OUT_IO		4
+#define PUMP_3_OUT_IO		5
+#define STEP_MILLIS			10
+
+static int iLcdCallbacks = 0;
+
+static void countLcdCallback()
+{
+	iLcdCallbacks++;
+}
+
+static void startTest()
+{
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+	iLcdCallbacks = 0;
+}
+
+template <uint8_t N> static void runFor(AcksenPumpBank<N> &Bank, unsigned long ulMillis)
+{
+
+	for (unsigned long ulElapsed = 0; ulElapsed < ulMillis; ulElapsed += STEP_MILLIS)
+	{
+		Bank.process();
+		AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+	}
+
+	Bank.process();
+
+}
+
+static void testBlockingBatch()
+{
+
+	startTest();
+
+	AcksenPumpBank<3> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 50;
+	Bank.callbackInitLCDs = countLcdCallback;
+
+	CHECK_EQUAL(0, Bank.addPump(PUMP_1_OUT_IO));
+	CHECK_EQUAL(1, Bank.addPump(PUMP_2_OUT_IO));
+	CHECK_EQUAL(2, Bank.addPump(PUMP_3_OUT_IO));
+	CHECK_EQUAL(-1, Bank.addPump(6));
+	CHECK_EQUAL(3, Bank.pumpCount());
+
+	// Three pumps switched in one pass share a single relay delay and LCD reinitialisation
+	for (int i = 0; i < 3; i++)
+	{
+		Bank.ToggleState(i);
+	}
+
+	Bank.process();
+
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_3_OUT_IO));
+	CHECK_EQUAL(50000, AcksenHalHost::clockMicros());
+	CHECK_EQUAL(1, iLcdCallbacks);
+	CHECK(Bank.switchingSettled() == true);
+
+	for (int i = 0; i < 3; i++)
+	{
+		CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(i));
+		CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Bank.outputState(i));
+		CHECK(Bank.stateChangeOccurred(i) == true);
+		CHECK(Bank.stateChangeOccurred(i) == false);
+	}
+
+	// Nothing to do - no delay, no callback
+	Bank.process();
+	CHECK_EQUAL(50000, AcksenHalHost::clockMicros());
+	CHECK_EQUAL(1, iLcdCallbacks);
+
+	// One pump off, leaving the others alone
+	Bank.ToggleState(1);
+	Bank.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+	CHECK_EQUAL(2, iLcdCallbacks);
+	CHECK(Bank.stateChangeOccurred(0) == false);
+	CHECK(Bank.stateChangeOccurred(1) == true);
+
+	// turnOffAll() switches the rest straight away, as one batch
+	Bank.turnOffAll();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_3_OUT_IO));
+	CHECK_EQUAL(3, iLcdCallbacks);
+
+	for (int i = 0; i < 3; i++)
+	{
+		CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(i));
+	}
+
+}
+
+static void testNonBlockingBatch()
+{
+
+	startTest();
+
+	AcksenPumpBank<2> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.bNonBlockingSwitching = true;
+	Bank.iPumpRelaySwitchingDelay = 100;
+	Bank.iPumpOnState = PUMP_NEGATIVE_LOGIC_ON;
+	Bank.iPumpOffState = PUMP_NEGATIVE_LOGIC_OFF;
+	Bank.callbackInitLCDs = countLcdCallback;
+
+	int iPump1 = Bank.addPump(PUMP_1_OUT_IO);
+	int iPump2 = Bank.addPump(PUMP_2_OUT_IO);
+
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+
+	// Switches without blocking, then settles in the background
+	Bank.ToggleState(iPump1);
+	CHECK_EQUAL(0, Bank.nextEventMillis());
+	Bank.process();
+	CHECK_EQUAL(0, AcksenHalHost::clockMicros());
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK(Bank.switchingSettled() == false);
+	CHECK_EQUAL(100, Bank.nextEventMillis());
+
+	// A request during the settling window waits for it to end
+	runFor(Bank, 50);
+	Bank.ToggleState(iPump2);
+	runFor(Bank, 40);
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+	CHECK_EQUAL(0, iLcdCallbacks);
+	runFor(Bank, 10);
+	CHECK_EQUAL(1, iLcdCallbacks);
+	CHECK_EQUAL(AcksenHalHost::timeMillis(), Bank.nextEventMillis());
+	Bank.process();
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+	CHECK_EQUAL(1, iLcdCallbacks);
+	CHECK(Bank.switchingSettled() == false);
+
+	runFor(Bank, 100);
+	CHECK(Bank.switchingSettled() == true);
+	CHECK_EQUAL(2, iLcdCallbacks);
+
+	// Request reversed before the next pass - nothing switches
+	unsigned long ulChanges = AcksenHalHost::pinChangeCount(PUMP_1_OUT_IO);
+	Bank.ToggleState(iPump1);
+	Bank.ToggleState(iPump1);
+	Bank.turnOff(iPump1);
+	Bank.ToggleState(iPump1);
+	runFor(Bank, 200);
+	CHECK(Bank.switchingSettled() == true);
+	CHECK_EQUAL(ulChanges, AcksenHalHost::pinChangeCount(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+
+}
+
+static void testVentilation()
+{
+
+	startTest();
+
+	AcksenPumpBank<2> Bank;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iPumpVentilationCycles = 1;
+	Bank.uiPumpVentilationOnLengthMillis = 300;
+	Bank.uiPumpVentilationOffLengthMillis = 100;
+
+	int iPump1 = Bank.addPump(PUMP_1_OUT_IO);
+	int iPump2 = Bank.addPump(PUMP_2_OUT_IO);
+
+	// Pumps started 150ms apart vent on their own timings
+	Bank.ToggleState(iPump1);
+	runFor(Bank, 150);
+	Bank.ToggleState(iPump2);
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Bank.controlState(iPump2));
+	runFor(Bank, 150);
+
+	// 300ms: pump 1 OFF, pump 2 ON
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+	CHECK_EQUAL(400, Bank.nextEventMillis());
+
+	// 400ms: pump 1 ON for its last cycle, 450ms: pump 2 OFF
+	runFor(Bank, 100);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	runFor(Bank, 50);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+
+	// 700ms: pump 1 vented and running on, 850ms: pump 2 the same
+	runFor(Bank, 250);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iPump1));
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Bank.controlState(iPump2));
+	runFor(Bank, 150);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iPump2));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+
+	// Turning a pump off part way through a vent stops it
+	Bank.turnOffAll();
+	Bank.ToggleState(iPump1);
+	runFor(Bank, 100);
+	Bank.ToggleState(iPump1);
+	runFor(Bank, 1000);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iPump1));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+
+}
+
+static void testMaxTemperature()
+{
+
+	startTest();
+
+	AcksenPumpBank<2> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iMaxPumpTemperature = 70;
+
+	int iHot = Bank.addPump(PUMP_1_OUT_IO);
+	int iCool = Bank.addPump(PUMP_2_OUT_IO);
+
+	Bank.ToggleState(iHot);
+	Bank.ToggleState(iCool);
+	Bank.process();
+
+	// Only the hot pump stops
+	Bank.updatePumpTemperatureCentidegrees(iHot, 7000);
+	Bank.updatePumpTemperatureCentidegrees(iCool, 6999);
+	Bank.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iHot));
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iCool));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_2_OUT_IO));
+
+	// and will not restart until cooled
+	Bank.ToggleState(iHot);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iHot));
+	Bank.updatePumpTemperature(iHot, 60.0f);
+	Bank.ToggleState(iHot);
+	Bank.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iHot));
+
+	// Check can be switched off for the whole bank
+	Bank.bEnableMaxPumpTemperature = false;
+	Bank.updatePumpTemperature(iCool, 95.0f);
+	runFor(Bank, 100);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iCool));
+
+}
+
+static void testInvalidIndex()
+{
+
+	startTest();
+
+	AcksenPumpBank<3> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iGrainRestLength = 1;
+
+	int iPump = Bank.addPump(PUMP_1_OUT_IO);
+	Bank.ToggleState(iPump);
+	Bank.process();
+	CHECK(Bank.stateChangeOccurred(iPump) == true);
+
+	// Negative, past the last pump added, and past the end of the bank
+	const int aiInvalid[] = { -1, 1, 3, 255 };
+
+	for (int i = 0; i < 4; i++)
+	{
+
+		int iInvalid = aiInvalid[i];
+
+		Bank.ToggleState(iInvalid);
+		Bank.turnOff(iInvalid);
+		Bank.beginGrainRest(iInvalid);
+		Bank.beginMashingControl(iInvalid);
+		Bank.endMashingControl(iInvalid);
+		Bank.temporaryInhibitGrainRestAsAroundPreheatSetPoint(iInvalid);
+		Bank.temporaryPermitGrainRestAsAroundPreheatSetPoint(iInvalid);
+		Bank.updatePumpTemperature(iInvalid, 95.0f);
+		Bank.updatePumpTemperatureCentidegrees(iInvalid, 9500);
+		Bank.process();
+
+		CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iInvalid));
+		CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Bank.outputState(iInvalid));
+		CHECK(Bank.stateChangeOccurred(iInvalid) == false);
+
+	}
+
+	// Only pump added is untouched
+	CHECK_EQUAL(1, Bank.pumpCount());
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iPump));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+	CHECK(Bank.stateChangeOccurred(iPump) == false);
+
+}
+
+int main()
+{
+
+	testBlockingBatch();
+	testNonBlockingBatch();
+	testVentilation();
+	testMaxTemperature();
+	testInvalidIndex();
+
+	return hostTestResult("bank_test");
+
+}
@@ -0,0 +1,212 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - Burst-Fire flow control with setFlowPercent(): ON cycles spread evenly across AcksenPhaseSync edges, the commanded output level restored at full flow, when turned OFF
+// and when Phase Sync lock is lost.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+#define TEST_EDGES			300
+
+static void startTest()
+{
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+}
+
+// Advance one mains period and capture an edge, as the Phase Sync interrupt would, then run the main loop.  Returns the Pump Output level set by the edge.
+static int feedEdge(AcksenPhaseSync &PhaseSync, AcksenPump &Pump)
+{
+
+	AcksenHalHost::advanceMicros(PHASE_SYNC_PERIOD_50HZ);
+	PhaseSync.handleEdge();
+
+	int iLevel = AcksenHalHost::pinLevel(PUMP_OUT_IO);
+
+	Pump.process();
+
+	return iLevel;
+
+}
+
+// Start a Pump at full flow, with a locked AcksenPhaseSync attached
+static void startPump(AcksenPhaseSync &PhaseSync, AcksenPump &Pump)
+{
+
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachPhaseSync(&PhaseSync);
+
+	Pump.ToggleState();
+	Pump.process();
+
+	for (int i = 0; i <= PHASE_SYNC_LOCK_EDGES; i++)
+	{
+		feedEdge(PhaseSync, Pump);
+	}
+
+	CHECK(PhaseSync.locked() == true);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testDistribution(uint8_t ui8Percent, int iMinGap, int iMaxGap)
+{
+
+	startTest();
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	startPump(PhaseSync, Pump);
+
+	Pump.setFlowPercent(ui8Percent);
+	Pump.process();
+	CHECK_EQUAL(ui8Percent, Pump.flowPercent());
+
+	int iOnCycles = 0;
+	int iLastOn = -1;
+
+	for (int iEdge = 0; iEdge < TEST_EDGES; iEdge++)
+	{
+
+		if (feedEdge(PhaseSync, Pump) == PUMP_POSITIVE_LOGIC_ON)
+		{
+
+			// Evenly spread - every gap between ON cycles is the same, give or take one cycle
+			if (iLastOn != -1)
+			{
+				CHECK((iEdge - iLastOn) >= iMinGap);
+				CHECK((iEdge - iLastOn) <= iMaxGap);
+			}
+
+			iOnCycles++;
+			iLastOn = iEdge;
+
+		}
+
+	}
+
+	CHECK_EQUAL((TEST_EDGES * ui8Percent) / PUMP_FLOW_PERCENT_FULL, iOnCycles);
+
+	// Pump itself stays ON throughout
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+
+}
+
+static void testFullFlow()
+{
+
+	startTest();
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	startPump(PhaseSync, Pump);
+
+	// No modulation at full flow
+	for (int iEdge = 0; iEdge < 10; iEdge++)
+	{
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, feedEdge(PhaseSync, Pump));
+	}
+
+	// Back to full flow from part way through an OFF cycle
+	Pump.setFlowPercent(50);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, feedEdge(PhaseSync, Pump));
+
+	Pump.setFlowPercent(PUMP_FLOW_PERCENT_FULL);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	for (int iEdge = 0; iEdge < 10; iEdge++)
+	{
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, feedEdge(PhaseSync, Pump));
+	}
+
+	// Values above 100 are full flow
+	Pump.setFlowPercent(150);
+	CHECK_EQUAL(PUMP_FLOW_PERCENT_FULL, Pump.flowPercent());
+
+}
+
+static void testTurnOff()
+{
+
+	startTest();
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	startPump(PhaseSync, Pump);
+
+	Pump.setFlowPercent(50);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, feedEdge(PhaseSync, Pump));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, feedEdge(PhaseSync, Pump));
+
+	// Turned OFF while in an ON cycle - later edges leave the output OFF
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	for (int iEdge = 0; iEdge < 10; iEdge++)
+	{
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, feedEdge(PhaseSync, Pump));
+	}
+
+	// Turned ON again - Burst-Fire resumes at the same Flow Percentage, once the output has settled ON
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, feedEdge(PhaseSync, Pump));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, feedEdge(PhaseSync, Pump));
+
+}
+
+static void testLockLost()
+{
+
+	startTest();
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	startPump(PhaseSync, Pump);
+
+	Pump.setFlowPercent(50);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, feedEdge(PhaseSync, Pump));
+
+	// Edges stop arriving - once lock is lost the Pump runs at full flow, rather than being left OFF
+	for (int iMillis = 0; iMillis < 100; iMillis++)
+	{
+		AcksenHalHost::advanceMicros(1000ULL);
+		Pump.process();
+	}
+
+	CHECK(PhaseSync.locked() == false);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Edge arriving before the next process() call leaves the output alone
+	PhaseSync.handleEdge();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	// 50% - alternate cycles.  33% - every third cycle, with an extra OFF cycle once in every 100.
+	testDistribution(50, 2, 2);
+	testDistribution(33, 3, 4);
+	testFullFlow();
+	testTurnOff();
+	testLockLost();
+
+	return hostTestResult("burst_fire_test");
+
+}
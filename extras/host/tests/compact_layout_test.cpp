@@ -0,0 +1,71 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - built with ACKSEN_PUMP_LEGACY_FIELDS set to 0: the compact layout fits PUMP_RAM_BUDGET without the attachments or millisecond
+// Ventilation lengths, and the accessors replacing the removed time fields report Ventilation and Grain Rest times.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+
+static void testBudget()
+{
+
+	CHECK_EQUAL(0, ACKSEN_PUMP_LEGACY_FIELDS);
+	CHECK_EQUAL(0, ACKSEN_PUMP_ATTACHMENTS);
+	CHECK_EQUAL(0, ACKSEN_PUMP_VENT_MILLIS);
+	CHECK(sizeof(AcksenPump) <= PUMP_RAM_BUDGET);
+
+}
+
+static void testTimeAccessors()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+	AcksenHalHost::setWallClock(1000000);
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPumpVentilationCycles = 0;
+	Pump.iGrainRestLength = 1;
+	Pump.iGrainRestPeriod = 2;
+
+	Pump.beginMashingControl();
+	Pump.temporaryPermitGrainRestAsAroundPreheatSetPoint();
+	Pump.ToggleState();
+	Pump.process();
+
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_FLOW_PERCENT_FULL, Pump.flowPercent());
+	CHECK_EQUAL(1000000 + PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT, Pump.ventEndTime());
+	CHECK_EQUAL(1000000 + 120, Pump.grainRestPeriodStartTime());
+	CHECK_EQUAL(0, Pump.grainRestEndTime());
+
+	// Run until the first periodic Grain Rest starts
+	for (int iSecond = 1; (iSecond <= 120) && (Pump.iControlState != PUMP_CONTROL_GRAIN_REST); iSecond++)
+	{
+		AcksenHalHost::advanceMicros(1000000ULL);
+		AcksenHalHost::setWallClock(1000000 + iSecond);
+		Pump.process();
+	}
+
+	CHECK_EQUAL(PUMP_CONTROL_GRAIN_REST, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(1000000 + 120 + 60, Pump.grainRestEndTime());
+	CHECK_EQUAL(1000000 + 120 + 120, Pump.grainRestPeriodStartTime());
+	CHECK_EQUAL(0, Pump.ventEndTime());
+
+}
+
+int main()
+{
+
+	testBudget();
+	testTimeAccessors();
+
+	return hostTestResult("compact_layout_test");
+
+}
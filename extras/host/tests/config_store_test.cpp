@@ -0,0 +1,180 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpConfigStore save/load, CRC rejection and slot rotation, on both AcksenEepromStorage and AcksenHostFileStorage.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpConfigStore.h"
+#include "AcksenPumpEeprom.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#define PUMP_OUT_IO			3
+#define STORE_ADDRESS		16
+#define STORE_SLOTS			4
+
+static uint16_t slotAddress(uint8_t ui8Slot)
+{
+	return STORE_ADDRESS + (ui8Slot * sizeof(AcksenPumpConfigRecord));
+}
+
+template <class Storage> static AcksenPumpConfigRecord readSlot(Storage &stStorage, uint8_t ui8Slot)
+{
+	AcksenPumpConfigRecord rcRecord;
+	stStorage.read(slotAddress(ui8Slot), &rcRecord, sizeof(rcRecord));
+	return rcRecord;
+}
+
+template <class Storage> static void corruptSlot(Storage &stStorage, uint8_t ui8Slot)
+{
+	// Flip one bit of the settings, leaving the CRC alone
+	AcksenPumpConfigRecord rcRecord = readSlot(stStorage, ui8Slot);
+	rcRecord.cfConfig.ui8GrainRestLength ^= 0x01;
+	stStorage.write(slotAddress(ui8Slot), &rcRecord, sizeof(rcRecord));
+}
+
+template <class Storage> static void testStore(Storage &stStorage)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	AcksenPumpConfig cfConfig;
+
+	// Blank storage
+	{
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK_EQUAL(STORE_SLOTS * sizeof(AcksenPumpConfigRecord), Store.storageSize());
+		CHECK(Store.load(cfConfig) == false);
+		CHECK(Store.load(Pump) == false);
+	}
+
+	// Round trip through a fresh store, as after a restart
+	Pump.iGrainRestLength = 12;
+	Pump.iMaxPumpTemperature = 85;
+	Pump.bEnablePumpVentilation = false;
+	Pump.switchPumpNegativeLogic();
+
+	{
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Store.save(Pump) == true);
+
+		// Unchanged settings are not written again
+		unsigned long ulBytesWritten = stStorage.bytesWritten();
+		CHECK(Store.save(Pump) == false);
+		CHECK_EQUAL(ulBytesWritten, stStorage.bytesWritten());
+	}
+
+	{
+		AcksenPump Restored(PUMP_OUT_IO, -1);
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Store.load(Restored) == true);
+		CHECK_EQUAL(12, Restored.iGrainRestLength);
+		CHECK_EQUAL(85, Restored.iMaxPumpTemperature);
+		CHECK(Restored.bEnablePumpVentilation == false);
+		CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, Restored.iPumpOnState);
+
+		// Stored record is also found by a save() without a load() first
+		AcksenPumpConfigStore<Storage> Saver(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Saver.save(Pump) == false);
+	}
+
+	// Rotation - record N goes to slot (N - 1) % STORE_SLOTS, and the newest wins, including after the slots wrap round
+	for (int i = 2; i <= 6; i++)
+	{
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		Pump.iGrainRestLength = 20 + i;
+		CHECK(Store.save(Pump) == true);
+
+		AcksenPumpConfigRecord rcRecord = readSlot(stStorage, (i - 1) % STORE_SLOTS);
+		CHECK_EQUAL(i, rcRecord.uiSequence);
+		CHECK_EQUAL(20 + i, rcRecord.cfConfig.ui8GrainRestLength);
+
+		AcksenPumpConfigStore<Storage> Loader(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Loader.load(cfConfig) == true);
+		CHECK_EQUAL(20 + i, cfConfig.ui8GrainRestLength);
+	}
+
+	// Slot 1 holds record 6 (newest), slot 0 record 5.  Corrupting the newest falls back to the one before.
+	corruptSlot(stStorage, 1);
+
+	{
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Store.load(cfConfig) == true);
+		CHECK_EQUAL(25, cfConfig.ui8GrainRestLength);
+
+		// The next save carries on from record 5, overwriting the corrupted slot
+		cfConfig.ui8GrainRestLength = 30;
+		CHECK(Store.save(cfConfig) == true);
+		CHECK_EQUAL(6, readSlot(stStorage, 1).uiSequence);
+		CHECK_EQUAL(30, readSlot(stStorage, 1).cfConfig.ui8GrainRestLength);
+	}
+
+	// Records of another layout version are ignored
+	{
+		AcksenPumpConfigRecord rcRecord = readSlot(stStorage, 1);
+		rcRecord.uiSequence = 7;
+		rcRecord.cfConfig.ui8Version = PUMP_CONFIG_VERSION + 1;
+		rcRecord.uiCrc = AcksenPumpCrc16(&rcRecord, sizeof(rcRecord.uiSequence) + sizeof(rcRecord.cfConfig));
+		stStorage.write(slotAddress(2), &rcRecord, sizeof(rcRecord));
+
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Store.load(cfConfig) == true);
+		CHECK_EQUAL(30, cfConfig.ui8GrainRestLength);
+	}
+
+	// Nothing valid left
+	for (uint8_t i = 0; i < STORE_SLOTS; i++)
+	{
+		corruptSlot(stStorage, i);
+	}
+
+	{
+		cfConfig.ui8GrainRestLength = 99;
+		AcksenPumpConfigStore<Storage> Store(stStorage, STORE_ADDRESS, STORE_SLOTS);
+		CHECK(Store.load(cfConfig) == false);
+		CHECK_EQUAL(99, cfConfig.ui8GrainRestLength);
+	}
+
+	// Bytes below the block are never touched
+	uint8_t ui8Below[STORE_ADDRESS];
+	stStorage.read(0, ui8Below, sizeof(ui8Below));
+
+	for (uint8_t i = 0; i < STORE_ADDRESS; i++)
+	{
+		CHECK_EQUAL(0xFF, ui8Below[i]);
+	}
+
+}
+
+int main()
+{
+
+	AcksenEepromStorage stEeprom;
+	EEPROM.erase();
+	testStore(stEeprom);
+
+	char cPath[] = "/tmp/acksen_config_store_XXXXXX";
+	int iFile = mkstemp(cPath);
+
+	if (iFile < 0)
+	{
+		printf("config_store_test: cannot create %s\n", cPath);
+		return 1;
+	}
+
+	// Start from a missing file, as on first run
+	close(iFile);
+	unlink(cPath);
+
+	AcksenHostFileStorage stFile(cPath);
+	testStore(stFile);
+
+	unlink(cPath);
+
+	return hostTestResult("config_store_test");
+
+}
@@ -0,0 +1,153 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpEventQueue ordering, free-running index wraparound, overflow counting and pop() on an empty queue, and the events an AcksenPump raises.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+#define PUMP_ID				5
+
+static void testOverflow()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpEventQueue Queue;
+	AcksenPumpEvent evEvent;
+
+	CHECK(Queue.pop(evEvent) == false);
+	CHECK_EQUAL(0, Queue.available());
+
+	for (int i = 0; i < PUMP_EVENT_QUEUE_SIZE; i++)
+	{
+		CHECK(Queue.push(PUMP_ID, PUMP_EVENT_CONTROL_STATE, (uint8_t)i) == true);
+	}
+
+	// Full - further events are dropped and counted, and the queued ones kept
+	CHECK(Queue.push(PUMP_ID, PUMP_EVENT_CONTROL_STATE, 0xAA) == false);
+	CHECK(Queue.push(PUMP_ID, PUMP_EVENT_CONTROL_STATE, 0xAB) == false);
+	CHECK_EQUAL(2, Queue.overflowCount());
+	CHECK_EQUAL(PUMP_EVENT_QUEUE_SIZE, Queue.available());
+
+	for (int i = 0; i < PUMP_EVENT_QUEUE_SIZE; i++)
+	{
+		CHECK(Queue.pop(evEvent) == true);
+		CHECK_EQUAL(i, evEvent.ui8Value);
+	}
+
+	CHECK(Queue.pop(evEvent) == false);
+	CHECK_EQUAL(0, Queue.available());
+
+	// Space again once drained
+	CHECK(Queue.push(PUMP_ID, PUMP_EVENT_CONTROL_STATE, 0) == true);
+	CHECK_EQUAL(2, Queue.overflowCount());
+
+}
+
+static void testWraparound()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpEventQueue Queue;
+	AcksenPumpEvent evEvent;
+
+	uint8_t ui8Pushed = 0;
+	uint8_t ui8Popped = 0;
+
+	// Run the 8-bit head and tail indexes round several times, with the queue part full
+	for (int iPass = 0; iPass < 100; iPass++)
+	{
+
+		for (int i = 0; i < 7; i++)
+		{
+			AcksenHalHost::advanceMicros(1000ULL);
+			CHECK(Queue.push(PUMP_ID, PUMP_EVENT_OUTPUT_ON, ui8Pushed++) == true);
+		}
+
+		CHECK_EQUAL(7, Queue.available());
+
+		for (int i = 0; i < 7; i++)
+		{
+			CHECK(Queue.pop(evEvent) == true);
+			CHECK_EQUAL(ui8Popped++, evEvent.ui8Value);
+		}
+
+	}
+
+	CHECK(Queue.pop(evEvent) == false);
+	CHECK_EQUAL(0, Queue.overflowCount());
+
+	// Timestamped when pushed
+	CHECK(Queue.push(PUMP_ID, PUMP_EVENT_OUTPUT_OFF, 0) == true);
+	CHECK(Queue.pop(evEvent) == true);
+	CHECK_EQUAL(AcksenHalHost::timeMillis(), evEvent.ulTimeMillis);
+	CHECK_EQUAL(PUMP_ID, evEvent.ui8PumpId);
+	CHECK_EQUAL(PUMP_EVENT_OUTPUT_OFF, evEvent.ui8Type);
+
+}
+
+static void checkEvent(AcksenPumpEventQueue &Queue, uint8_t ui8Type, uint8_t ui8Value)
+{
+
+	AcksenPumpEvent evEvent;
+
+	CHECK(Queue.pop(evEvent) == true);
+	CHECK_EQUAL(PUMP_ID, evEvent.ui8PumpId);
+	CHECK_EQUAL(ui8Type, evEvent.ui8Type);
+	CHECK_EQUAL(ui8Value, evEvent.ui8Value);
+
+}
+
+static void testPumpEvents()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpEventQueue Queue;
+	AcksenPumpEvent evEvent;
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachEventQueue(&Queue, PUMP_ID);
+
+	Pump.ToggleState();
+	Pump.process();
+	checkEvent(Queue, PUMP_EVENT_CONTROL_STATE, PUMP_CONTROL_ON);
+	checkEvent(Queue, PUMP_EVENT_OUTPUT_ON, PUMP_CONTROL_ON);
+	CHECK(Queue.pop(evEvent) == false);
+
+	// Over temperature trip records the state it stopped from
+	Pump.updatePumpTemperature((float)Pump.iMaxPumpTemperature + 1.0f);
+	Pump.process();
+	checkEvent(Queue, PUMP_EVENT_OVER_TEMPERATURE, PUMP_CONTROL_ON);
+	checkEvent(Queue, PUMP_EVENT_CONTROL_STATE, PUMP_CONTROL_STOP);
+	checkEvent(Queue, PUMP_EVENT_OUTPUT_OFF, PUMP_CONTROL_STOP);
+	CHECK(Queue.pop(evEvent) == false);
+
+	// Detached - nothing more recorded
+	Pump.attachEventQueue(NULL, PUMP_ID);
+	Pump.updatePumpTemperature(20.0f);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK(Queue.pop(evEvent) == false);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testOverflow();
+	testWraparound();
+	testPumpEvents();
+
+	return hostTestResult("events_test");
+
+}
@@ -0,0 +1,243 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - periodic Grain Rests on AcksenPump and AcksenPumpBank: only on mashing pumps, held off while inhibited, and restarted with a vent, including across the millis() rollover.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpBank.h"
+
+#define PUMP_1_OUT_IO		3
+#define PUMP_2_OUT_IO		4
+#define PUMP_3_OUT_IO		5
+
+#define MAX_RESTS			8
+#define TEST_SECONDS		600
+
+// millis() rolls over this many Seconds into the test
+#define ROLLOVER_SECONDS		300
+
+// Grain Rest start times of one pump, in Seconds
+struct RestLog
+{
+	int iCount = 0;
+	int aiStart[MAX_RESTS];
+	int iLastState = PUMP_CONTROL_STOP;
+
+	void record(int iControlState, int iSecond)
+	{
+		if ((iControlState == PUMP_CONTROL_GRAIN_REST) && (iLastState != PUMP_CONTROL_GRAIN_REST) && (iCount < MAX_RESTS))
+		{
+			aiStart[iCount++] = iSecond;
+		}
+
+		iLastState = iControlState;
+	}
+};
+
+static void checkRests(const RestLog &rlLog, const int aiExpected[], int iExpected)
+{
+
+	CHECK_EQUAL(iExpected, rlLog.iCount);
+
+	for (int i = 0; (i < iExpected) && (i < rlLog.iCount); i++)
+	{
+		CHECK_EQUAL(aiExpected[i], rlLog.aiStart[i]);
+	}
+
+}
+
+static void testPump(uint64_t ullStartMicros)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(ullStartMicros);
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iGrainRestLength = 1;
+	Pump.iGrainRestPeriod = 2;
+
+	Pump.beginMashingControl();
+	Pump.temporaryInhibitGrainRestAsAroundPreheatSetPoint();
+	Pump.ToggleState();
+
+	RestLog rlLog;
+
+	for (int iSecond = 0; iSecond <= TEST_SECONDS; iSecond++)
+	{
+
+		// Close to Set Point for the first rest, which waits until permitted
+		if (iSecond == 150)
+		{
+			Pump.temporaryPermitGrainRestAsAroundPreheatSetPoint();
+		}
+
+		Pump.process();
+		rlLog.record(Pump.iControlState, iSecond);
+
+		// Pump is OFF throughout each rest
+		if (Pump.iControlState == PUMP_CONTROL_GRAIN_REST)
+		{
+			CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_1_OUT_IO));
+		}
+
+		AcksenHalHost::advanceMicros(1000000ULL);
+
+	}
+
+	// Due at 120s but inhibited, then every 2 minutes from the start of the last
+	const int aiExpected[] = { 150, 270, 390, 510 };
+	checkRests(rlLog, aiExpected, 4);
+
+}
+
+static void testWallClockJump()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+	AcksenHalHost::setWallClock(1000000);
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iGrainRestLength = 1;
+
+	Pump.ToggleState();
+	Pump.process();
+
+	// Rest started by the calling software, as in previous library versions
+	Pump.iControlState = PUMP_CONTROL_GRAIN_REST;
+	Pump.process();
+	CHECK_EQUAL(1000060, Pump.dtGrainRestEndTime);
+
+	int iEnd = -1;
+
+	for (int iSecond = 0; (iSecond <= 120) && (iEnd == -1); iSecond++)
+	{
+
+		// Wall clock corrected part way through (e.g. by NTP) - the rest still lasts one minute
+		if (iSecond == 30)
+		{
+			AcksenHalHost::setWallClock(1000000 + 3600);
+		}
+
+		Pump.process();
+
+		if (Pump.iControlState != PUMP_CONTROL_GRAIN_REST)
+		{
+			iEnd = iSecond;
+		}
+
+		AcksenHalHost::advanceMicros(1000000ULL);
+
+	}
+
+	CHECK_EQUAL(60, iEnd);
+
+}
+
+static void testBank()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpBank<3> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iGrainRestLength = 1;
+	Bank.iGrainRestPeriod = 2;
+
+	int iMash = Bank.addPump(PUMP_1_OUT_IO);
+	int iTransfer = Bank.addPump(PUMP_2_OUT_IO);
+	int iInhibited = Bank.addPump(PUMP_3_OUT_IO);
+
+	Bank.beginMashingControl(iMash);
+	Bank.temporaryPermitGrainRestAsAroundPreheatSetPoint(iMash);
+	Bank.beginMashingControl(iInhibited);
+
+	for (int i = 0; i < Bank.pumpCount(); i++)
+	{
+		Bank.ToggleState(i);
+	}
+
+	RestLog rlLog[3];
+
+	for (int iSecond = 0; iSecond <= TEST_SECONDS; iSecond++)
+	{
+
+		if (iSecond == 300)
+		{
+			Bank.temporaryPermitGrainRestAsAroundPreheatSetPoint(iInhibited);
+		}
+
+		Bank.process();
+
+		for (int i = 0; i < Bank.pumpCount(); i++)
+		{
+			rlLog[i].record(Bank.controlState(i), iSecond);
+		}
+
+		// First rest is two minutes away - sleep for the idle interval, not just to the end of the timer wheel's turn
+		if (iSecond == 1)
+		{
+			CHECK_EQUAL(1000UL + PUMP_NEXT_EVENT_IDLE_INTERVAL, Bank.nextEventMillis());
+		}
+
+		// Rest ends with a vent, then the pump runs until the next one
+		if (iSecond == 185)
+		{
+			CHECK_EQUAL(PUMP_CONTROL_VENT, Bank.controlState(iMash));
+		}
+		if (iSecond == 230)
+		{
+			CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iMash));
+			CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Bank.outputState(iMash));
+		}
+
+		AcksenHalHost::advanceMicros(1000000ULL);
+
+	}
+
+	const int aiMash[] = { 120, 240, 360, 480, 600 };
+	checkRests(rlLog[iMash], aiMash, 5);
+
+	// Not mashing - never rests
+	CHECK_EQUAL(0, rlLog[iTransfer].iCount);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iTransfer));
+
+	// Due from 120s, held until permitted
+	const int aiInhibited[] = { 300, 420, 540 };
+	checkRests(rlLog[iInhibited], aiInhibited, 3);
+
+	// Ending mashing control lets the present rest finish, but starts no more
+	Bank.endMashingControl(iMash);
+	RestLog rlEnded;
+	rlEnded.iLastState = Bank.controlState(iMash);
+
+	for (int iSecond = 0; iSecond <= TEST_SECONDS; iSecond++)
+	{
+		Bank.process();
+		rlEnded.record(Bank.controlState(iMash), iSecond);
+		AcksenHalHost::advanceMicros(1000000ULL);
+	}
+
+	CHECK_EQUAL(0, rlEnded.iCount);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iMash));
+
+}
+
+int main()
+{
+
+	testPump(0);
+	testPump(hostRolloverStart(ROLLOVER_SECONDS));
+	testWallClockJump();
+	testBank();
+
+	return hostTestResult("grain_rest_test");
+
+}
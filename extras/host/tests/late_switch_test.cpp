@@ -0,0 +1,176 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - process() called late for a switch predicted by AcksenPhaseSync: AcksenPump, AcksenPumpBank and AcksenPumpT only change the Pump Output
+// at the pre-activation delay after an edge, moving on to the next edge rather than switching wherever the mains cycle has got to.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpBank.h"
+#include "AcksenPumpT.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+#define PERIOD_MICROS		PHASE_SYNC_PERIOD_50HZ
+#define DELAY_MILLIS		2
+#define TICK_MICROS			100UL
+#define RUN_MICROS			(50UL * PERIOD_MICROS)
+
+// Not a multiple of the period, so each call lands at a different point in the mains cycle
+#define CALL_ON_TIME_MICROS	7000UL		// Reaches the switching time exactly, after 3 cycles
+#define CALL_LATE_MICROS	7300UL		// Reaches it 200us late, within PHASE_SYNC_LATE_MARGIN_MICROS
+#define CALL_SLOW_MICROS	23000UL		// Each call 3ms later in the cycle than the last
+
+static void startTest(AcksenPhaseSync &PhaseSync)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	for (int i = 0; i <= PHASE_SYNC_LOCK_EDGES; i++)
+	{
+		AcksenHalHost::advanceMicros(PERIOD_MICROS);
+		PhaseSync.handleEdge();
+	}
+
+	CHECK(PhaseSync.locked() == true);
+
+	// Part way through the cycle, so the switch is predicted for the next edge
+	AcksenHalHost::advanceMicros(PERIOD_MICROS / 4);
+
+}
+
+// Feed an edge every period, and call process() every ulCallMicros, until the Pump Output changes.  Returns the time since the last edge when it did.
+template <class Pump> static unsigned long runUntilSwitched(AcksenPhaseSync &PhaseSync, Pump &pmPump, unsigned long ulCallMicros)
+{
+
+	unsigned long ulSinceEdge = (uint32_t)(AcksenHal::timeMicros() - PhaseSync.lastEdgeMicros());
+	unsigned long ulSinceCall = 0;
+	unsigned long ulChanges = AcksenHalHost::pinChangeCount(PUMP_OUT_IO);
+
+	pmPump.process();
+
+	if (AcksenHalHost::pinChangeCount(PUMP_OUT_IO) != ulChanges)
+	{
+		// Shared the edge just switched on
+		return ulSinceEdge;
+	}
+
+	for (unsigned long ulElapsed = 0; ulElapsed < RUN_MICROS; ulElapsed += TICK_MICROS)
+	{
+
+		AcksenHalHost::advanceMicros(TICK_MICROS);
+		ulSinceEdge += TICK_MICROS;
+		ulSinceCall += TICK_MICROS;
+
+		if (ulSinceEdge >= PERIOD_MICROS)
+		{
+			PhaseSync.handleEdge();
+			ulSinceEdge = 0;
+		}
+
+		if (ulSinceCall >= ulCallMicros)
+		{
+
+			pmPump.process();
+			ulSinceCall = 0;
+
+			if (AcksenHalHost::pinChangeCount(PUMP_OUT_IO) != ulChanges)
+			{
+				return ulSinceEdge;
+			}
+
+		}
+
+	}
+
+	return RUN_MICROS;
+
+}
+
+static void checkEdgeAligned(unsigned long ulSinceEdge)
+{
+	CHECK(ulSinceEdge >= (DELAY_MILLIS * 1000UL));
+	CHECK(ulSinceEdge <= ((DELAY_MILLIS * 1000UL) + PHASE_SYNC_LATE_MARGIN_MICROS));
+}
+
+static void testPump(unsigned long ulCallMicros)
+{
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	startTest(PhaseSync);
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnablePhaseSync = true;
+	Pump.bNonBlockingSwitching = true;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPhaseSyncPreActivationDelay = DELAY_MILLIS;
+	Pump.attachPhaseSync(&PhaseSync);
+
+	Pump.ToggleState();
+	checkEdgeAligned(runUntilSwitched(PhaseSync, Pump, ulCallMicros));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	Pump.ToggleState();
+	checkEdgeAligned(runUntilSwitched(PhaseSync, Pump, ulCallMicros));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testBank(unsigned long ulCallMicros)
+{
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	startTest(PhaseSync);
+
+	AcksenPumpBank<1> Bank;
+	Bank.bEnablePhaseSync = true;
+	Bank.bNonBlockingSwitching = true;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iPhaseSyncPreActivationDelay = DELAY_MILLIS;
+	Bank.attachPhaseSync(&PhaseSync);
+
+	int iPump = Bank.addPump(PUMP_OUT_IO);
+	Bank.bEnablePumpVentilation = false;
+
+	Bank.ToggleState(iPump);
+	checkEdgeAligned(runUntilSwitched(PhaseSync, Bank, ulCallMicros));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testPumpT(unsigned long ulCallMicros)
+{
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+	startTest(PhaseSync);
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_PHASE_SYNC> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPhaseSyncPreActivationDelay = DELAY_MILLIS;
+	Pump.attachPhaseSync(&PhaseSync);
+
+	Pump.ToggleState();
+	checkEdgeAligned(runUntilSwitched(PhaseSync, Pump, ulCallMicros));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testPump(CALL_ON_TIME_MICROS);
+	testPump(CALL_LATE_MICROS);
+	testPump(CALL_SLOW_MICROS);
+	testBank(CALL_ON_TIME_MICROS);
+	testBank(CALL_LATE_MICROS);
+	testBank(CALL_SLOW_MICROS);
+	testPumpT(CALL_ON_TIME_MICROS);
+	testPumpT(CALL_LATE_MICROS);
+	testPumpT(CALL_SLOW_MICROS);
+
+	return hostTestResult("late_switch_test");
+
+}
@@ -0,0 +1,134 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - with ACKSEN_PUMP_LEGACY_FIELDS (the default), v1.8 sketch code using the public fields must compile and behave as before, and int settings outside the getConfig() field width saturate.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+
+#if ACKSEN_PUMP_LEGACY_FIELDS
+
+// As a v1.8 settings menu would
+static void editSetting(int *pSetting, int iValue)
+{
+	*pSetting = iValue;
+}
+
+static void toggleFlag(bool &bFlag)
+{
+	bFlag = !bFlag;
+}
+
+static void testFieldAddresses()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+
+	editSetting(&Pump.iPumpVentilationCycles, 4);
+	editSetting(&Pump.iMaxPumpTemperature, 85);
+	CHECK_EQUAL(4, Pump.iPumpVentilationCycles);
+	CHECK_EQUAL(85, Pump.iMaxPumpTemperature);
+
+	bool bGrainRest = Pump.bEnableGrainRest;
+	toggleFlag(Pump.bEnableGrainRest);
+	CHECK(Pump.bEnableGrainRest != bGrainRest);
+
+}
+
+static void testPumpTemperatureField()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnableMaxPumpTemperature = true;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	// Set through the function, read from the field
+	Pump.updatePumpTemperature(42.5f);
+	CHECK(Pump.fPumpTemperature == 42.5f);
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	// Written directly, picked up by the next process()
+	Pump.fPumpTemperature = (float)(Pump.iMaxPumpTemperature + 1);
+	Pump.process();
+	CHECK_EQUAL((Pump.iMaxPumpTemperature + 1) * 100, Pump.pumpTemperatureCentidegrees());
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testVentTimeFields()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+
+	CHECK_EQUAL(Pump.ventStartTime(), Pump.dtVentStartTime);
+	CHECK_EQUAL(Pump.ventEndTime(), Pump.dtVentEndTime);
+	CHECK_EQUAL(Pump.iPumpVentilationOnLength, Pump.dtVentEndTime - Pump.dtVentStartTime);
+
+}
+
+static void testConfigSaturation()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iGrainRestPeriod = 300;
+	Pump.iMaxPumpTemperature = 255;
+	Pump.iPumpVentilationCycles = -1;
+	Pump.iPumpRelaySwitchingDelay = 70000;
+
+	AcksenPumpConfig cfConfig;
+	Pump.getConfig(cfConfig);
+
+	// Held at the limit, rather than wrapping round (300 would otherwise come back as 44)
+	CHECK_EQUAL(255, cfConfig.ui8GrainRestPeriod);
+	CHECK_EQUAL(255, cfConfig.ui8MaxPumpTemperature);
+	CHECK_EQUAL(0, cfConfig.ui8PumpVentilationCycles);
+	CHECK_EQUAL(65535, cfConfig.uiPumpRelaySwitchingDelay);
+
+	// In range settings are unchanged
+	CHECK_EQUAL(PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT, cfConfig.ui8PumpVentilationOnLength);
+
+	Pump.setConfig(cfConfig);
+	CHECK_EQUAL(255, Pump.iGrainRestPeriod);
+	CHECK_EQUAL(0, Pump.iPumpVentilationCycles);
+
+}
+
+#endif
+
+int main()
+{
+
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	testFieldAddresses();
+	testPumpTemperatureField();
+	testVentTimeFields();
+	testConfigSaturation();
+#endif
+
+	return hostTestResult("legacy_fields_test");
+
+}
@@ -0,0 +1,74 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - switching the Pump output logic keeps the Pump in its present ON/OFF state, at the new level.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+
+static void startPump(AcksenPump &Pump)
+{
+	Pump.ToggleState();
+	Pump.process();
+}
+
+int main()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	// Stopped pump - output moves to the new OFF level
+	{
+		AcksenPump Pump(PUMP_OUT_IO, -1);
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+		Pump.switchPumpNegativeLogic();
+		CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+		CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Pump.iOutputStateActual);
+
+		// Pump then starts at the negative logic ON level
+		Pump.bEnablePumpVentilation = false;
+		Pump.iPumpRelaySwitchingDelay = 0;
+		startPump(Pump);
+		CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+		CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	}
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	// Running pump - stays ON, and process() does not switch it back
+	{
+		AcksenPump Pump(PUMP_OUT_IO, -1);
+		Pump.bEnablePumpVentilation = false;
+		Pump.iPumpRelaySwitchingDelay = 0;
+		startPump(Pump);
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+		Pump.switchPumpNegativeLogic();
+		CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+		AcksenHalHost::advanceMicros(1000000ULL);
+		Pump.process();
+		CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+		CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+		// And back again through setConfig()
+		AcksenPumpConfig cfConfig;
+		Pump.getConfig(cfConfig);
+		CHECK((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_NEGATIVE_LOGIC) != 0);
+		cfConfig.ui8Flags &= ~PUMP_CONFIG_FLAG_NEGATIVE_LOGIC;
+		Pump.setConfig(cfConfig);
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+		Pump.turnOff();
+		Pump.process();
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	}
+
+	return hostTestResult("logic_test");
+
+}
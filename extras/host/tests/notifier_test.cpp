@@ -0,0 +1,201 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpNotifier runs its listeners once after a burst of notifications, when the quiet period after the last one has elapsed (including across the millis() rollover),
+// notified through notifyDefault() or attachNotifier() on AcksenPump, AcksenPumpBank and AcksenPumpT.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpNotifier.h"
+#include "AcksenPumpBank.h"
+#include "AcksenPumpT.h"
+
+#define PUMP_1_OUT_IO		3
+#define PUMP_2_OUT_IO		4
+#define PUMP_3_OUT_IO		5
+#define PUMP_4_OUT_IO		6
+
+#define QUIET_MILLIS		1000
+
+// millis() rolls over this many Seconds into the test
+#define ROLLOVER_SECONDS		2
+
+static void countCall(void *pContext)
+{
+	(*(int *)pContext)++;
+}
+
+static void testCoalesced()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(hostRolloverStart(ROLLOVER_SECONDS));
+
+	AcksenPumpNotifier Notifier;
+	Notifier.uiQuietPeriod = QUIET_MILLIS;
+
+	int iCallsA = 0;
+	int iCallsB = 0;
+	CHECK(Notifier.addListener(countCall, &iCallsA) == true);
+	CHECK(Notifier.addListener(countCall, &iCallsB) == true);
+	CHECK(Notifier.addListener(countCall, &iCallsA) == true);
+
+	CHECK(Notifier.process() == false);
+
+	// 10 notifications, 500ms apart - each restarts the quiet period, through the rollover
+	for (int i = 0; i < 10; i++)
+	{
+		Notifier.notify();
+		AcksenHalHost::advanceMicros(500000ULL);
+		CHECK(Notifier.process() == false);
+	}
+
+	CHECK(Notifier.pending() == true);
+	CHECK_EQUAL((uint32_t)(AcksenHalHost::timeMillis() + 500), (uint32_t)Notifier.nextEventMillis());
+
+	AcksenHalHost::advanceMicros(499000ULL);
+	CHECK(Notifier.process() == false);
+
+	// One dispatch to each listener, once the quiet period is over
+	AcksenHalHost::advanceMicros(1000ULL);
+	CHECK(Notifier.process() == true);
+	CHECK(Notifier.process() == false);
+	CHECK(Notifier.pending() == false);
+
+	CHECK_EQUAL(1, iCallsA);
+	CHECK_EQUAL(1, iCallsB);
+	CHECK_EQUAL(10, Notifier.notifyCount());
+	CHECK_EQUAL(1, Notifier.dispatchCount());
+
+	// Removed listeners are not run
+	Notifier.removeListener(countCall, &iCallsB);
+	Notifier.notify();
+	AcksenHalHost::advanceMicros(QUIET_MILLIS * 1000ULL);
+	CHECK(Notifier.process() == true);
+	CHECK_EQUAL(2, iCallsA);
+	CHECK_EQUAL(1, iCallsB);
+
+}
+
+static void testPumps()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpNotifier Notifier;
+	Notifier.uiQuietPeriod = QUIET_MILLIS;
+	Notifier.begin();
+
+	int iCalls = 0;
+	Notifier.addListener(countCall, &iCalls);
+
+	AcksenPump Pump1(PUMP_1_OUT_IO, -1);
+	AcksenPump Pump2(PUMP_2_OUT_IO, -1);
+	AcksenPump *pPumps[] = { &Pump1, &Pump2 };
+
+	for (int i = 0; i < 2; i++)
+	{
+		pPumps[i]->bEnablePumpVentilation = false;
+		pPumps[i]->iPumpRelaySwitchingDelay = 0;
+		pPumps[i]->callbackInitLCDs = AcksenPumpNotifier::notifyDefault;
+	}
+
+	// Both pumps switching ON and OFF within the quiet period give one dispatch
+	Pump1.ToggleState();
+	Pump2.ToggleState();
+	Pump1.process();
+	Pump2.process();
+	AcksenHalHost::advanceMicros(200000ULL);
+	Notifier.process();
+	Pump1.turnOff();
+	Pump2.turnOff();
+
+	CHECK_EQUAL(4, Notifier.notifyCount());
+
+	for (int i = 0; i < 30; i++)
+	{
+		AcksenHalHost::advanceMicros(100000ULL);
+		Notifier.process();
+	}
+
+	CHECK_EQUAL(1, iCalls);
+	CHECK_EQUAL(1, Notifier.dispatchCount());
+
+}
+
+static void testAttached()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	// Two notifiers, with no default - each only hears from the pumps attached to it
+	AcksenPumpNotifier Notifier;
+	AcksenPumpNotifier OtherNotifier;
+	Notifier.uiQuietPeriod = QUIET_MILLIS;
+
+	int iCalls = 0;
+	Notifier.addListener(countCall, &iCalls);
+
+	AcksenPumpBank<2> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.addPump(PUMP_1_OUT_IO);
+	Bank.addPump(PUMP_2_OUT_IO);
+	Bank.attachNotifier(&Notifier);
+
+	AcksenPumpT<PUMP_3_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_LCD_CALLBACK> PumpT;
+	PumpT.iPumpRelaySwitchingDelay = 0;
+	PumpT.attachNotifier(&Notifier);
+
+	// One notification per batch from the bank, and one per transition from the pump
+	Bank.ToggleState(0);
+	Bank.ToggleState(1);
+	Bank.process();
+	PumpT.ToggleState();
+	PumpT.process();
+	CHECK_EQUAL(2, Notifier.notifyCount());
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	AcksenPump Pump(PUMP_4_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachNotifier(&Notifier);
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(3, Notifier.notifyCount());
+
+	Pump.attachNotifier(&OtherNotifier);
+	Pump.turnOff();
+	CHECK_EQUAL(3, Notifier.notifyCount());
+	CHECK_EQUAL(1, OtherNotifier.notifyCount());
+#endif
+
+	for (int i = 0; i < 20; i++)
+	{
+		AcksenHalHost::advanceMicros(100000ULL);
+		Notifier.process();
+	}
+
+	CHECK_EQUAL(1, iCalls);
+
+	// Detached - no longer notified
+	Bank.attachNotifier(NULL);
+	Bank.turnOffAll();
+	CHECK(Notifier.pending() == false);
+	CHECK_EQUAL(0, OtherNotifier.dispatchCount());
+
+}
+
+int main()
+{
+
+	testCoalesced();
+	testPumps();
+	testAttached();
+
+	return hostTestResult("notifier_test");
+
+}
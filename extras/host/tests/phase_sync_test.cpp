@@ -0,0 +1,210 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPhaseSync period, frequency and jitter estimates at 50Hz and 60Hz, missed and noise edges, loss of lock, and the predicted switching time
+// (moved on to the next edge when checked late), including across the micros() rollover.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPhaseSync.h"
+
+#define PHASE_SYNC_IN_IO	2
+
+#define TEST_EDGES			64
+#define JITTER_MICROS		200
+#define PRE_ACTIVATION_MICROS	2000UL
+
+// micros() rolls over this many Microseconds into the test
+#define ROLLOVER_MICROS		100000ULL
+
+static void startTest(uint64_t ullStartMicros)
+{
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(ullStartMicros);
+}
+
+// Advance to the next edge and capture it, as the Phase Sync interrupt would.  Returns the micros() time of the edge.
+static unsigned long feedEdge(AcksenPhaseSync &PhaseSync, unsigned long ulIntervalMicros)
+{
+	AcksenHalHost::advanceMicros(ulIntervalMicros);
+	PhaseSync.handleEdge();
+	return AcksenHal::timeMicros();
+}
+
+static void testFrequency(uint64_t ullStartMicros, unsigned long ulPeriodMicros, int iMainsFrequency, unsigned int uiCentiHz)
+{
+
+	startTest(ullStartMicros);
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+
+	CHECK(PhaseSync.locked() == false);
+	CHECK_EQUAL(0, PhaseSync.frequencyCentiHz());
+	CHECK_EQUAL(0, PhaseSync.mainsFrequency());
+
+	// Not locked, so nothing to predict from
+	unsigned long ulSwitchMicros;
+	CHECK(PhaseSync.switchMicros(PRE_ACTIVATION_MICROS, ulSwitchMicros) == false);
+
+	unsigned long ulEdgeMicros = 0;
+
+	for (int i = 0; i < PHASE_SYNC_LOCK_EDGES; i++)
+	{
+		ulEdgeMicros = feedEdge(PhaseSync, ulPeriodMicros);
+	}
+
+	// First edge is only a reference, so one more is needed to lock
+	CHECK(PhaseSync.locked() == false);
+	ulEdgeMicros = feedEdge(PhaseSync, ulPeriodMicros);
+	CHECK(PhaseSync.locked() == true);
+
+	CHECK_EQUAL(ulPeriodMicros, PhaseSync.periodMicros());
+	CHECK_EQUAL(uiCentiHz, PhaseSync.frequencyCentiHz());
+	CHECK_EQUAL(iMainsFrequency, PhaseSync.mainsFrequency());
+	CHECK_EQUAL(0, PhaseSync.jitterMicros());
+	CHECK_EQUAL(0, PhaseSync.missedEdges());
+	CHECK_EQUAL(ulEdgeMicros, PhaseSync.lastEdgeMicros());
+
+	// Within the pre-activation delay of the last edge - switch on that edge
+	AcksenHalHost::advanceMicros(PRE_ACTIVATION_MICROS / 2);
+	CHECK(PhaseSync.switchMicros(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+
+	// Later in the cycle - switch on the predicted next edge
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 2);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + ulPeriodMicros), PhaseSync.nextEdgeMicros());
+	CHECK(PhaseSync.switchMicros(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + ulPeriodMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+
+	// Noise part way through the cycle is ignored
+	PhaseSync.handleEdge();
+	CHECK_EQUAL(ulEdgeMicros, PhaseSync.lastEdgeMicros());
+
+	// One edge dropped - counted as missed, without disturbing the period estimate
+	ulEdgeMicros = feedEdge(PhaseSync, (2 * ulPeriodMicros) - (PRE_ACTIVATION_MICROS / 2) - (ulPeriodMicros / 2));
+	CHECK_EQUAL(1, PhaseSync.missedEdges());
+	CHECK_EQUAL(ulPeriodMicros, PhaseSync.periodMicros());
+	CHECK(PhaseSync.locked() == true);
+
+	// Still predicted from the edge after the gap
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 2);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + ulPeriodMicros), PhaseSync.nextEdgeMicros());
+
+	// Edges stop arriving - lock is lost after 4 periods
+	AcksenHalHost::advanceMicros((3 * ulPeriodMicros) + (ulPeriodMicros / 4));
+	CHECK(PhaseSync.locked() == true);
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 2);
+	CHECK(PhaseSync.locked() == false);
+	CHECK_EQUAL(0, PhaseSync.mainsFrequency());
+	CHECK(PhaseSync.switchMicros(PRE_ACTIVATION_MICROS, ulSwitchMicros) == false);
+
+}
+
+static void testSwitchDue(uint64_t ullStartMicros, unsigned long ulPeriodMicros)
+{
+
+	startTest(ullStartMicros);
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+
+	unsigned long ulEdgeMicros = 0;
+
+	for (int i = 0; i <= PHASE_SYNC_LOCK_EDGES; i++)
+	{
+		ulEdgeMicros = feedEdge(PhaseSync, ulPeriodMicros);
+	}
+
+	CHECK(PhaseSync.locked() == true);
+
+	// Scheduled part way through the cycle, for the next edge
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 2);
+
+	unsigned long ulSwitchMicros;
+	CHECK(PhaseSync.switchMicros(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + ulPeriodMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == false);
+
+	// Due from the switching time, to the end of the margin
+	ulEdgeMicros = feedEdge(PhaseSync, ulPeriodMicros - (ulPeriodMicros / 2));
+	AcksenHalHost::advanceMicros(PRE_ACTIVATION_MICROS - 1);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == false);
+	AcksenHalHost::advanceMicros(1);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	AcksenHalHost::advanceMicros(PHASE_SYNC_LATE_MARGIN_MICROS);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+
+	// Any later - moved on to the same point after the next edge
+	AcksenHalHost::advanceMicros(1);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == false);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + ulPeriodMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+
+	// Late by a whole cycle - still moved on to the next edge, and due on an edge captured at that time
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 4);
+	feedEdge(PhaseSync, ulPeriodMicros - (PRE_ACTIVATION_MICROS + PHASE_SYNC_LATE_MARGIN_MICROS + 1) - (ulPeriodMicros / 4));
+	ulEdgeMicros = feedEdge(PhaseSync, ulPeriodMicros);
+	AcksenHalHost::advanceMicros(PRE_ACTIVATION_MICROS);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+	CHECK_EQUAL((uint32_t)(ulEdgeMicros + PRE_ACTIVATION_MICROS), ulSwitchMicros);
+
+	// Lock lost - can't be moved on, so switched regardless
+	ulSwitchMicros = AcksenHal::timeMicros();
+	AcksenHalHost::advanceMicros(5 * ulPeriodMicros);
+	CHECK(PhaseSync.locked() == false);
+	CHECK(PhaseSync.switchDue(PRE_ACTIVATION_MICROS, ulSwitchMicros) == true);
+
+}
+
+static void testJitter(unsigned long ulPeriodMicros, int iMainsFrequency)
+{
+
+	startTest(0);
+
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+
+	// Each edge early or late by JITTER_MICROS / 2, alternately - every interval is JITTER_MICROS from the nominal period
+	feedEdge(PhaseSync, ulPeriodMicros);
+	feedEdge(PhaseSync, ulPeriodMicros - (JITTER_MICROS / 2));
+
+	unsigned long ulEdgeMicros = 0;
+
+	for (int i = 0; i < TEST_EDGES; i++)
+	{
+		ulEdgeMicros = feedEdge(PhaseSync, ((i & 1) == 0) ? (ulPeriodMicros + JITTER_MICROS) : (ulPeriodMicros - JITTER_MICROS));
+	}
+
+	CHECK(PhaseSync.locked() == true);
+	CHECK_EQUAL(iMainsFrequency, PhaseSync.mainsFrequency());
+	CHECK_EQUAL(0, PhaseSync.missedEdges());
+
+	// Period estimate settles within the filter's step of nominal, and jitter close to the deviation of each interval
+	CHECK(PhaseSync.periodMicros() >= (ulPeriodMicros - (JITTER_MICROS >> PHASE_SYNC_FILTER_SHIFT)));
+	CHECK(PhaseSync.periodMicros() <= (ulPeriodMicros + (JITTER_MICROS >> PHASE_SYNC_FILTER_SHIFT)));
+	CHECK(PhaseSync.jitterMicros() >= ((JITTER_MICROS * 3) / 4));
+	CHECK(PhaseSync.jitterMicros() <= ((JITTER_MICROS * 5) / 4));
+
+	// Prediction is the last edge plus the period estimate
+	AcksenHalHost::advanceMicros(ulPeriodMicros / 2);
+	CHECK_EQUAL(ulEdgeMicros + PhaseSync.periodMicros(), PhaseSync.nextEdgeMicros());
+
+	// A dropped edge is still recognised with jitter present
+	feedEdge(PhaseSync, (2 * ulPeriodMicros) + JITTER_MICROS - (ulPeriodMicros / 2));
+	CHECK_EQUAL(1, PhaseSync.missedEdges());
+	CHECK(PhaseSync.locked() == true);
+
+}
+
+int main()
+{
+
+	testFrequency(0, PHASE_SYNC_PERIOD_50HZ, 50, 5000);
+	testFrequency(0, PHASE_SYNC_PERIOD_60HZ, 60, 6000);
+	testFrequency(0x100000000ULL - ROLLOVER_MICROS, PHASE_SYNC_PERIOD_50HZ, 50, 5000);
+	testFrequency(0x100000000ULL - ROLLOVER_MICROS, PHASE_SYNC_PERIOD_60HZ, 60, 6000);
+	testSwitchDue(0, PHASE_SYNC_PERIOD_50HZ);
+	testSwitchDue(0x100000000ULL - ROLLOVER_MICROS, PHASE_SYNC_PERIOD_60HZ);
+	testJitter(PHASE_SYNC_PERIOD_50HZ, 50);
+	testJitter(PHASE_SYNC_PERIOD_60HZ, 60);
+
+	return hostTestResult("phase_sync_test");
+
+}
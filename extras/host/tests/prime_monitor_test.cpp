@@ -0,0 +1,340 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPrimeMonitor: Ventilation ends once flow is steady, extra cycles are added while an air lock persists (including with no
+// Ventilation Cycles configured), a Pump that never primes is stopped, and each pump current reading is sampled once.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPrimeMonitor.h"
+
+#define PUMP_1_OUT_IO		3
+
+#define STEP_MILLIS			10
+#define TEST_MILLIS			60000
+
+// Flow meter behaviour while the Pump Output is ON
+#define FLOW_NONE			0		// Dry
+#define FLOW_STEADY			1		// One pulse every step, from ulFlowStartMillis
+#define FLOW_AIR_LOCK		2		// Surging - never steady
+
+struct VentResult
+{
+	int iOnPulses = 0;
+	int iPrimedEvents = 0;
+	int iDryRunEvents = 0;
+	int iDryRunValue = -1;
+	int iPrimedValue = -1;
+};
+
+// Run a Pump through Ventilation, feeding the flow meter, until it settles ON or STOP
+static VentResult runVent(AcksenPump &Pump, AcksenPrimeMonitor &Monitor, int iFlow, unsigned long ulFlowStartMillis)
+{
+
+	AcksenPumpEventQueue Events;
+	Pump.attachEventQueue(&Events, 0);
+	Pump.attachPrimeMonitor(&Monitor);
+
+	VentResult vrResult;
+
+	Pump.ToggleState();
+
+	for (unsigned long ulMillis = 0; ulMillis <= TEST_MILLIS; ulMillis += STEP_MILLIS)
+	{
+
+		bool bOn = (AcksenHalHost::pinLevel(PUMP_1_OUT_IO) == PUMP_POSITIVE_LOGIC_ON);
+
+		if ((bOn == true) && (ulMillis >= ulFlowStartMillis))
+		{
+			if (iFlow == FLOW_STEADY)
+			{
+				Monitor.countPulse();
+			}
+			else if ((iFlow == FLOW_AIR_LOCK) && (((ulMillis / 250) % 2) == 0))
+			{
+				Monitor.addPulses(4);
+			}
+		}
+
+		Pump.process();
+
+		AcksenPumpEvent evEvent;
+
+		while (Events.pop(evEvent) == true)
+		{
+			if (evEvent.ui8Type == PUMP_EVENT_OUTPUT_ON)
+			{
+				vrResult.iOnPulses++;
+			}
+			else if (evEvent.ui8Type == PUMP_EVENT_PRIMED)
+			{
+				vrResult.iPrimedEvents++;
+				vrResult.iPrimedValue = evEvent.ui8Value;
+			}
+			else if (evEvent.ui8Type == PUMP_EVENT_DRY_RUN)
+			{
+				vrResult.iDryRunEvents++;
+				vrResult.iDryRunValue = evEvent.ui8Value;
+			}
+		}
+
+		if ((Pump.iControlState == PUMP_CONTROL_ON) || (Pump.iControlState == PUMP_CONTROL_STOP))
+		{
+			break;
+		}
+
+		AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+
+	}
+
+	return vrResult;
+
+}
+
+static void setupPump(AcksenPump &Pump, int iCycles)
+{
+
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPumpVentilationCycles = iCycles;
+	Pump.iPumpVentilationOnLength = 5;
+	Pump.iPumpVentilationOffLength = 2;
+
+}
+
+static void testSteadyFlowEndsEarly()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	setupPump(Pump, 3);
+
+	AcksenPrimeMonitor Monitor;
+	VentResult vrResult = runVent(Pump, Monitor, FLOW_STEADY, 1000);
+
+	// Flow from 1s, first counted in the sample ending at 1.25s, steady for 2s - primed part way through the first ON pulse
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(1, vrResult.iOnPulses);
+	CHECK_EQUAL(1, vrResult.iPrimedEvents);
+	CHECK_EQUAL(3, vrResult.iPrimedValue);
+	CHECK_EQUAL(0, vrResult.iDryRunEvents);
+
+	CHECK(Monitor.primed());
+	CHECK(Monitor.measuring() == false);
+	CHECK_EQUAL(3250UL, Monitor.timeToFullFlow());
+
+	// Fixed Ventilation - 3 x (5s OFF + 2s ON) after the first 5s ON
+	CHECK_EQUAL(26000UL - 3250UL, Monitor.timeSaved());
+	CHECK_EQUAL(0, Monitor.extraCycles());
+	CHECK_EQUAL(1, Monitor.primeCount());
+
+}
+
+static void testDryRunStops(int iCycles)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	setupPump(Pump, iCycles);
+
+	AcksenPrimeMonitor Monitor;
+	Monitor.ui8MaxExtraCycles = 2;
+
+	VentResult vrResult = runVent(Pump, Monitor, FLOW_NONE, 0);
+
+	// First ON, then the configured cycles (at least one), then every extra cycle
+	int iCyclesRun = ((iCycles > 1) ? iCycles : 1) + 2;
+
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Pump.iOutputStateActual);
+	CHECK_EQUAL(1 + iCyclesRun, vrResult.iOnPulses);
+	CHECK_EQUAL(0, vrResult.iPrimedEvents);
+	CHECK_EQUAL(1, vrResult.iDryRunEvents);
+	CHECK_EQUAL(0, vrResult.iDryRunValue);
+
+	CHECK_EQUAL(2, Monitor.extraCycles());
+	CHECK_EQUAL(1, Monitor.dryRunCount());
+	CHECK(Monitor.primed() == false);
+
+}
+
+static void testAirLockStops()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	setupPump(Pump, 1);
+
+	AcksenPrimeMonitor Monitor;
+	Monitor.ui8MaxExtraCycles = 1;
+
+	VentResult vrResult = runVent(Pump, Monitor, FLOW_AIR_LOCK, 0);
+
+	// Flow seen, but never steady
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(3, vrResult.iOnPulses);
+	CHECK_EQUAL(1, vrResult.iDryRunEvents);
+	CHECK_EQUAL(1, vrResult.iDryRunValue);
+
+}
+
+static void testExtraCyclePrimes()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	setupPump(Pump, 0);
+
+	AcksenPrimeMonitor Monitor;
+
+	// Air lock clears in the first extra cycle - ON at 0s, OFF/ON at 5s (the one cycle run while watching), extra OFF/ON at 12s
+	VentResult vrResult = runVent(Pump, Monitor, FLOW_STEADY, 14500);
+
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(3, vrResult.iOnPulses);
+	CHECK_EQUAL(1, vrResult.iPrimedEvents);
+	CHECK_EQUAL(0, vrResult.iDryRunEvents);
+	CHECK_EQUAL(1, Monitor.extraCycles());
+
+	// Longer than the fixed Ventilation, so nothing saved
+	CHECK(Monitor.timeToFullFlow() > 12000UL);
+	CHECK_EQUAL(0UL, Monitor.timeSaved());
+
+}
+
+static void testNoMonitorNoCycles()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	setupPump(Pump, 0);
+
+	AcksenPumpEventQueue Events;
+	Pump.attachEventQueue(&Events, 0);
+
+	Pump.ToggleState();
+
+	int iOnPulses = 0;
+
+	for (unsigned long ulMillis = 0; (ulMillis <= TEST_MILLIS) && (Pump.iControlState != PUMP_CONTROL_ON); ulMillis += STEP_MILLIS)
+	{
+
+		Pump.process();
+
+		AcksenPumpEvent evEvent;
+
+		while (Events.pop(evEvent) == true)
+		{
+			if (evEvent.ui8Type == PUMP_EVENT_OUTPUT_ON)
+			{
+				iOnPulses++;
+			}
+		}
+
+		AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+
+	}
+
+	// Fixed Ventilation is a single ON pulse, as in v1.8
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(1, iOnPulses);
+
+}
+
+static void testCurrentSampledOnce()
+{
+
+	AcksenPrimeMonitor Monitor;
+	Monitor.ui8Source = PRIME_SOURCE_CURRENT;
+	Monitor.uiPrimedLevel = 100;
+
+	Monitor.begin(0, 20000);
+
+	// A reading taken while OFF is discarded
+	Monitor.updateCurrent(500);
+	CHECK(Monitor.update(false, 0) == false);
+	CHECK(Monitor.update(true, 100) == false);
+	CHECK(Monitor.update(true, 2500) == false);
+
+	// Window starts on the first reading taken while ON
+	Monitor.updateCurrent(500);
+	CHECK(Monitor.update(true, 3000) == false);
+	CHECK_EQUAL(5000UL, Monitor.nextSampleMillis(3000));
+
+	// The same reading is not sampled again, however long it is held
+	CHECK(Monitor.update(true, 4000) == false);
+	CHECK(Monitor.update(true, 5000) == false);
+	CHECK(Monitor.update(true, 6000) == false);
+
+	// A fresh reading within tolerance completes the window
+	Monitor.updateCurrent(520);
+	CHECK(Monitor.update(true, 6100));
+	CHECK(Monitor.primed());
+	CHECK_EQUAL(6100UL, Monitor.timeToFullFlow());
+	CHECK_EQUAL(20000UL - 6100UL, Monitor.timeSaved());
+
+}
+
+static void testCurrentUnsteady()
+{
+
+	AcksenPrimeMonitor Monitor;
+	Monitor.ui8Source = PRIME_SOURCE_CURRENT;
+	Monitor.uiPrimedLevel = 100;
+
+	Monitor.begin(0, 20000);
+
+	// Outside ui8Tolerance - each change starts the window again
+	Monitor.updateCurrent(500);
+	CHECK(Monitor.update(true, 0) == false);
+	Monitor.updateCurrent(700);
+	CHECK(Monitor.update(true, 1500) == false);
+	Monitor.updateCurrent(690);
+	CHECK(Monitor.update(true, 3000) == false);
+
+	// Below uiPrimedLevel - not flowing
+	Monitor.updateCurrent(50);
+	CHECK(Monitor.update(true, 3400) == false);
+	Monitor.updateCurrent(700);
+	CHECK(Monitor.update(true, 5000) == false);
+	Monitor.updateCurrent(700);
+	CHECK(Monitor.update(true, 7000));
+	CHECK_EQUAL(7000UL, Monitor.timeToFullFlow());
+
+	// Dry run bookkeeping after a later Ventilation
+	Monitor.begin(10000, 20000);
+	CHECK(Monitor.primed() == false);
+	CHECK(Monitor.extendCycle());
+	CHECK_EQUAL(1, Monitor.extraCycles());
+	CHECK(Monitor.recordDryRun() == false);
+	CHECK(Monitor.measuring() == false);
+	CHECK_EQUAL(1, Monitor.primeCount());
+	CHECK_EQUAL(1, Monitor.dryRunCount());
+
+}
+
+int main()
+{
+
+	testSteadyFlowEndsEarly();
+	testDryRunStops(0);
+	testDryRunStops(1);
+	testDryRunStops(3);
+	testAirLockStops();
+	testExtraCyclePrimes();
+	testNoMonitorNoCycles();
+	testCurrentSampledOnce();
+	testCurrentUnsteady();
+
+	return hostTestResult("prime_monitor_test");
+
+}
@@ -0,0 +1,135 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpProbes voting, stale and failed probes, and the fail-safe temperature.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpProbes.h"
+
+#define PUMP_1_OUT_IO		3
+#define PUMP_2_OUT_IO		4
+
+static void advanceMillis(unsigned long ulMillis)
+{
+	AcksenHalHost::advanceMicros((uint64_t)ulMillis * 1000ULL);
+}
+
+static void testVoting()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump1(PUMP_1_OUT_IO, -1);
+	AcksenPump Pump2(PUMP_2_OUT_IO, -1);
+
+	AcksenPumpProbes<4> Probes;
+
+	// Three probes on Pump 1, one on Pump 2
+	CHECK_EQUAL(0, Probes.addProbe(&Pump1));
+	CHECK_EQUAL(1, Probes.addProbe(&Pump1));
+	CHECK_EQUAL(2, Probes.addProbe(&Pump2));
+	CHECK_EQUAL(3, Probes.addProbe(&Pump1));
+	CHECK_EQUAL(-1, Probes.addProbe(&Pump2));
+	CHECK_EQUAL(4, Probes.probeCount());
+
+	// Highest reading governs by default
+	const int16_t aiReadings[] = { 6000, 9500, 4000, 7000 };
+	Probes.update(aiReadings);
+	CHECK_EQUAL(9500, Pump1.pumpTemperatureCentidegrees());
+	CHECK_EQUAL(4000, Pump2.pumpTemperatureCentidegrees());
+
+	// Two must agree - the single high probe is outvoted
+	Probes.ui8Vote = 2;
+	Probes.feedPumps();
+	CHECK_EQUAL(7000, Pump1.pumpTemperatureCentidegrees());
+
+	// Pump 2 has only one probe, so cannot reach a vote of 2, and fails safe
+	CHECK_EQUAL(PROBE_FAIL_SAFE_CENTIDEGREES, Pump2.pumpTemperatureCentidegrees());
+
+	// Failed reads do not vote
+	Probes.updateProbe(3, PROBE_READING_FAILED);
+	Probes.feedPumps();
+	CHECK_EQUAL(6000, Pump1.pumpTemperatureCentidegrees());
+	CHECK(Probes.probeValid(3) == false);
+
+	// Too few valid probes, without fail-safe - last temperature is left alone
+	Probes.updateProbe(0, PROBE_READING_FAILED);
+	Probes.bFailSafe = false;
+	Probes.feedPumps();
+	CHECK_EQUAL(6000, Pump1.pumpTemperatureCentidegrees());
+
+	int16_t iCentidegrees = 1234;
+	CHECK(Probes.governingTemperature(&Pump1, iCentidegrees) == false);
+	CHECK_EQUAL(1234, iCentidegrees);
+
+	// Vote larger than the set can never agree
+	Probes.ui8Vote = 5;
+	CHECK(Probes.governingTemperature(&Pump2, iCentidegrees) == false);
+
+}
+
+static void testStaleness()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_1_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	AcksenPumpProbes<2> Probes;
+	Probes.uiStaleMillis = 2000;
+
+	int iInlet = Probes.addProbe(&Pump);
+	int iHousing = Probes.addProbe(&Pump);
+
+	// Probes that have never read are invalid
+	CHECK(Probes.probeValid(iInlet) == false);
+
+	Probes.updateProbe(iInlet, 5000);
+	Probes.updateProbe(iHousing, 5500);
+	Probes.feedPumps();
+	CHECK_EQUAL(5500, Pump.pumpTemperatureCentidegrees());
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	// Housing probe stops reporting - inlet keeps governing
+	advanceMillis(1500);
+	Probes.updateProbe(iInlet, 5100);
+	advanceMillis(500);
+	CHECK(Probes.probeValid(iHousing) == true);
+	CHECK_EQUAL(2000, Probes.probeAge(iHousing));
+	advanceMillis(1);
+	CHECK(Probes.probeValid(iHousing) == false);
+	Probes.feedPumps();
+	CHECK_EQUAL(5100, Pump.pumpTemperatureCentidegrees());
+
+	// Both stale - fail-safe temperature stops the running pump
+	advanceMillis(2000);
+	Probes.feedPumps();
+	CHECK_EQUAL(PROBE_FAIL_SAFE_CENTIDEGREES, Pump.pumpTemperatureCentidegrees());
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+	// Fresh readings bring it back
+	Probes.updateProbe(iInlet, 5200);
+	Probes.feedPumps();
+	CHECK_EQUAL(5200, Pump.pumpTemperatureCentidegrees());
+	CHECK_EQUAL(5200, Probes.probeTemperature(iInlet));
+
+}
+
+int main()
+{
+
+	testVoting();
+	testStaleness();
+
+	return hostTestResult("probes_test");
+
+}
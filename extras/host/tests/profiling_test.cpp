@@ -0,0 +1,114 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - profiling counters (built with ACKSEN_PUMP_PROFILING set): process() call times and histogram, time blocked in the Relay Switching Delay
+// and Phase Sync waits, pin timeouts and relay transitions.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+#define RELAY_DELAY_MS		200
+
+#if ACKSEN_PUMP_PROFILING
+
+static void testProcessTimes()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+
+	AcksenPumpProfile pfProfile;
+	Pump.getProfile(pfProfile);
+	CHECK_EQUAL(0, pfProfile.ulProcessCalls);
+	CHECK_EQUAL(0xFFFFFFFFUL, pfProfile.ulProcessMinMicros);
+
+	// Switching ON blocks for the Relay Switching Delay, which lands in the last histogram bin
+	Pump.ToggleState();
+	Pump.process();
+
+	// Nothing to do - takes no virtual time, so lands in bin 0
+	Pump.process();
+	Pump.process();
+
+	Pump.getProfile(pfProfile);
+	CHECK_EQUAL(3, pfProfile.ulProcessCalls);
+	CHECK_EQUAL(0, pfProfile.ulProcessMinMicros);
+	CHECK_EQUAL(RELAY_DELAY_MS * 1000UL, pfProfile.ulProcessMaxMicros);
+	CHECK_EQUAL(RELAY_DELAY_MS * 1000UL, pfProfile.ulProcessTotalMicros);
+	CHECK_EQUAL(2, pfProfile.uiProcessHistogram[0]);
+	CHECK_EQUAL(1, pfProfile.uiProcessHistogram[PUMP_PROFILE_HISTOGRAM_BINS - 1]);
+	CHECK_EQUAL(RELAY_DELAY_MS * 1000UL, pfProfile.ulRelaySwitchingDelayMicros);
+	CHECK_EQUAL(1, pfProfile.ulRelayTransitions);
+	CHECK_EQUAL(0, pfProfile.uiPinTimeouts);
+
+	unsigned int uiBinned = 0;
+
+	for (int i = 0; i < PUMP_PROFILE_HISTOGRAM_BINS; i++)
+	{
+		uiBinned += pfProfile.uiProcessHistogram[i];
+	}
+
+	CHECK_EQUAL(3, uiBinned);
+
+	// turnOff() is not a process() call, but its waits and transition still count
+	Pump.turnOff();
+	Pump.getProfile(pfProfile);
+	CHECK_EQUAL(3, pfProfile.ulProcessCalls);
+	CHECK_EQUAL(2 * RELAY_DELAY_MS * 1000UL, pfProfile.ulRelaySwitchingDelayMicros);
+	CHECK_EQUAL(2, pfProfile.ulRelayTransitions);
+
+	Pump.resetProfile();
+	Pump.getProfile(pfProfile);
+	CHECK_EQUAL(0, pfProfile.ulProcessCalls);
+	CHECK_EQUAL(0, pfProfile.ulRelayTransitions);
+	CHECK_EQUAL(0, pfProfile.uiProcessHistogram[0]);
+
+}
+
+static void testPhaseSyncTimeout()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	// Phase Sync input held LOW - no edge ever arrives
+	AcksenPump Pump(PUMP_OUT_IO, PHASE_SYNC_IN_IO);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnablePhaseSync = true;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, LOW);
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	AcksenPumpProfile pfProfile;
+	Pump.getProfile(pfProfile);
+	CHECK_EQUAL(1, pfProfile.uiPinTimeouts);
+	CHECK(pfProfile.ulPhaseSyncWaitMicros > (PHASE_SYNC_TIMEOUT * 1000UL));
+	CHECK(pfProfile.ulPhaseSyncWaitMicros < (2 * PHASE_SYNC_TIMEOUT * 1000UL));
+	CHECK_EQUAL(pfProfile.ulPhaseSyncWaitMicros, pfProfile.ulProcessMaxMicros);
+	CHECK_EQUAL(0, pfProfile.ulRelaySwitchingDelayMicros);
+
+}
+
+#endif
+
+int main()
+{
+
+#if ACKSEN_PUMP_PROFILING
+	testProcessTimes();
+	testPhaseSyncTimeout();
+#endif
+
+	return hostTestResult("profiling_test");
+
+}
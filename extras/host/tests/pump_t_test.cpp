@@ -0,0 +1,305 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpT instantiated with different feature sets: ventilation timing, Grain Rest, Maximum Pump Temperature, logic, relay settling, polled Phase Sync, and an unlocked AcksenPhaseSync shared with an AcksenPump.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPumpT.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+#define OTHER_PUMP_OUT_IO	4
+#define STEP_MILLIS			10
+
+// Step the clock, calling process() each step.  Returns the number of Pump Output changes.
+template <class Pump> static unsigned long runFor(Pump &pmPump, unsigned long ulMillis)
+{
+
+	unsigned long ulChanges = AcksenHalHost::pinChangeCount(PUMP_OUT_IO);
+
+	for (unsigned long ulElapsed = 0; ulElapsed < ulMillis; ulElapsed += STEP_MILLIS)
+	{
+		pmPump.process();
+		AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+	}
+
+	pmPump.process();
+
+	return AcksenHalHost::pinChangeCount(PUMP_OUT_IO) - ulChanges;
+
+}
+
+static void startTest()
+{
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+}
+
+static void testMinimal()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, 0> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Straight ON, with no vent
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+	CHECK(Pump.stateChangeOccurred() == true);
+	CHECK(Pump.stateChangeOccurred() == false);
+
+	// Temperature readings are ignored without the feature
+	Pump.updatePumpTemperature(150.0f);
+	CHECK_EQUAL(0, runFor(Pump, 1000));
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testVentilation()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_NEGATIVE, PUMP_FEATURE_VENTILATION> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPumpVentilationCycles = 2;
+	Pump.uiPumpVentilationOnLengthMillis = 500;
+	Pump.uiPumpVentilationOffLengthMillis = 200;
+
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	Pump.process();
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(500, Pump.nextEventMillis());
+
+	// ON/OFF pattern of 3 x 500ms ON, 2 x 200ms OFF, with the last ON running on
+	CHECK_EQUAL(0, runFor(Pump, 490));
+	CHECK_EQUAL(1, runFor(Pump, 10));
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	CHECK_EQUAL(1, runFor(Pump, 200));
+	CHECK_EQUAL(2, runFor(Pump, 700));
+	CHECK_EQUAL(0, runFor(Pump, 500));
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	CHECK_EQUAL(0, runFor(Pump, 10000));
+
+	// Turning off part way through a vent stops at once
+	Pump.ToggleState();
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	runFor(Pump, 300);
+	Pump.turnOff();
+	Pump.process();
+	CHECK_EQUAL(PUMP_NEGATIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(0, runFor(Pump, 5000));
+
+}
+
+static void testGrainRest()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_VENTILATION | PUMP_FEATURE_GRAIN_REST> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPumpVentilationCycles = 0;
+	Pump.uiPumpVentilationOnLengthMillis = 1000;
+	Pump.iGrainRestLength = 1;
+
+	// Not running - ignored
+	Pump.beginGrainRest();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+	Pump.ToggleState();
+	runFor(Pump, 2000);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	Pump.beginGrainRest();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_GRAIN_REST, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(AcksenHalHost::timeMillis() + 60000UL, Pump.nextEventMillis());
+
+	// OFF for the full minute, then vented and back ON
+	CHECK_EQUAL(0, runFor(Pump, 59990));
+	CHECK_EQUAL(PUMP_CONTROL_GRAIN_REST, Pump.iControlState);
+	runFor(Pump, 10);
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	runFor(Pump, 1000);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+}
+
+static void testMaxTemperature()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_MAX_TEMPERATURE> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iMaxPumpTemperature = 80;
+
+	Pump.updatePumpTemperatureCentidegrees(7999);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	Pump.updatePumpTemperatureCentidegrees(8000);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+}
+
+static int iLcdCallbacks = 0;
+
+static void countLcdCallback()
+{
+	iLcdCallbacks++;
+}
+
+static void testSettling()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_LCD_CALLBACK> Pump;
+	Pump.iPumpRelaySwitchingDelay = 100;
+	Pump.callbackInitLCDs = countLcdCallback;
+
+	// Output switches at once, then the relay settling window runs without blocking
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK(Pump.switchingSettled() == false);
+	CHECK_EQUAL(100, Pump.nextEventMillis());
+	CHECK_EQUAL(0, AcksenHalHost::clockMicros());
+
+	runFor(Pump, 90);
+	CHECK(Pump.switchingSettled() == false);
+	CHECK_EQUAL(0, iLcdCallbacks);
+	runFor(Pump, 10);
+	CHECK(Pump.switchingSettled() == true);
+	CHECK_EQUAL(1, iLcdCallbacks);
+
+}
+
+static void testPhaseSync()
+{
+
+	startTest();
+
+	AcksenPumpT<PUMP_OUT_IO, PHASE_SYNC_IN_IO, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_PHASE_SYNC> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPhaseSyncPreActivationDelay = 2;
+
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, LOW);
+
+	// Held until a rising edge on the Phase Sync input, plus the pre-activation delay
+	Pump.ToggleState();
+	CHECK_EQUAL(0, runFor(Pump, 30));
+	CHECK(Pump.switchingSettled() == false);
+
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, HIGH);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	AcksenHalHost::advanceMicros(2000ULL);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// No edge at all - switches anyway after the timeout
+	Pump.ToggleState();
+	runFor(Pump, 2 * PHASE_SYNC_TIMEOUT + (2 * STEP_MILLIS));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testSharedPhaseSync()
+{
+
+	startTest();
+
+	// Never begun, so unlocked until edges are fed to handleEdge()
+	AcksenPhaseSync PhaseSync(PHASE_SYNC_IN_IO);
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_PHASE_SYNC> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPhaseSyncPreActivationDelay = 2;
+	Pump.attachPhaseSync(&PhaseSync);
+
+	AcksenPump OtherPump(OTHER_PUMP_OUT_IO, -1);
+	OtherPump.bEnablePumpVentilation = false;
+	OtherPump.bEnablePhaseSync = true;
+	OtherPump.bNonBlockingSwitching = true;
+	OtherPump.iPumpRelaySwitchingDelay = 0;
+	OtherPump.iPhaseSyncPreActivationDelay = 2;
+	OtherPump.attachPhaseSync(&PhaseSync);
+
+	// Held for the next captured edge, rather than switching unaligned
+	Pump.ToggleState();
+	OtherPump.ToggleState();
+
+	for (int i = 0; i < 10; i++)
+	{
+		Pump.process();
+		OtherPump.process();
+		AcksenHalHost::advanceMicros(1000ULL);
+	}
+
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(OTHER_PUMP_OUT_IO));
+
+	// Both switch on the same edge, after the pre-activation delay
+	PhaseSync.handleEdge();
+	Pump.process();
+	OtherPump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	AcksenHalHost::advanceMicros(2000ULL);
+	Pump.process();
+	OtherPump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(OTHER_PUMP_OUT_IO));
+
+	// No further edge - switches anyway after the timeout
+	AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+	Pump.ToggleState();
+	CHECK_EQUAL(0, runFor(Pump, 2 * PHASE_SYNC_TIMEOUT - STEP_MILLIS));
+	runFor(Pump, 3 * STEP_MILLIS);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testMinimal();
+	testVentilation();
+	testGrainRest();
+	testMaxTemperature();
+	testSettling();
+	testPhaseSync();
+	testSharedPhaseSync();
+
+	return hostTestResult("pump_t_test");
+
+}
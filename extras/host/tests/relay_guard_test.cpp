@@ -0,0 +1,180 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenRelayGuard minimum dwell times, token bucket burst and refill, and coalescing of reversed requests, including across the millis() rollover.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+
+// millis() rolls over 500ms after this
+#define ROLLOVER_MILLIS		0xFFFFFE0CUL
+
+// millis() rolls over this many Seconds into the test
+#define ROLLOVER_SECONDS		1
+
+static void testDwell()
+{
+
+	AcksenRelayGuard Guard;
+	Guard.ulMinOnTime = 2000;
+	Guard.ulMinOffTime = 3000;
+	Guard.ulRefillTime = 0;
+
+	unsigned long ulStart = ROLLOVER_MILLIS;
+
+	// First transition is never held
+	CHECK(Guard.requestTransition(true, ulStart) == true);
+	Guard.recordTransition(true, ulStart);
+
+	// Held ON for ulMinOnTime, with the deadline on the far side of the rollover
+	CHECK(Guard.requestTransition(false, wrapMillis(ulStart + 1000)) == false);
+	CHECK(Guard.deferred() == true);
+	CHECK_EQUAL(wrapMillis(ulStart + 2000), wrapMillis(Guard.nextAllowedMillis()));
+	CHECK(Guard.requestTransition(false, wrapMillis(ulStart + 1999)) == false);
+	CHECK(Guard.requestTransition(false, wrapMillis(ulStart + 2000)) == true);
+	Guard.recordTransition(false, wrapMillis(ulStart + 2000));
+	CHECK(Guard.deferred() == false);
+
+	// Held OFF for ulMinOffTime
+	CHECK(Guard.requestTransition(true, wrapMillis(ulStart + 4999)) == false);
+	CHECK(Guard.requestTransition(true, wrapMillis(ulStart + 5000)) == true);
+
+	// Each deferred request counted once, however often it is retried
+	CHECK_EQUAL(2, Guard.deferredCount());
+	CHECK_EQUAL(1, Guard.onCount());
+	CHECK_EQUAL(1, Guard.offCount());
+
+}
+
+static void testBurstAndRefill()
+{
+
+	AcksenRelayGuard Guard;
+	Guard.ulMinOnTime = 0;
+	Guard.ulMinOffTime = 0;
+	Guard.ui8BurstSize = 3;
+	Guard.ulRefillTime = 1000;
+
+	unsigned long ulStart = ROLLOVER_MILLIS;
+	bool bOn = false;
+
+	// A full bucket allows a burst of back-to-back transitions
+	for (int i = 0; i < 3; i++)
+	{
+		bOn = !bOn;
+		CHECK(Guard.requestTransition(bOn, ulStart) == true);
+		Guard.recordTransition(bOn, ulStart);
+	}
+
+	// ...then one per ulRefillTime, across the rollover
+	bOn = !bOn;
+	CHECK(Guard.requestTransition(bOn, ulStart) == false);
+	CHECK_EQUAL(wrapMillis(ulStart + 1000), wrapMillis(Guard.nextAllowedMillis()));
+	CHECK(Guard.requestTransition(bOn, wrapMillis(ulStart + 999)) == false);
+	CHECK(Guard.requestTransition(bOn, wrapMillis(ulStart + 1000)) == true);
+	Guard.recordTransition(bOn, wrapMillis(ulStart + 1000));
+
+	// A long idle period refills the bucket, but no further than ui8BurstSize
+	unsigned long ulLater = wrapMillis(ulStart + 60000);
+
+	for (int i = 0; i < 3; i++)
+	{
+		bOn = !bOn;
+		CHECK(Guard.requestTransition(bOn, ulLater) == true);
+		Guard.recordTransition(bOn, ulLater);
+	}
+
+	bOn = !bOn;
+	CHECK(Guard.requestTransition(bOn, ulLater) == false);
+
+}
+
+static void testCoalesced()
+{
+
+	AcksenRelayGuard Guard;
+	Guard.ulRefillTime = 0;
+
+	Guard.recordTransition(true, 1000);
+
+	// Request reversed while deferred - no transition at all
+	CHECK(Guard.requestTransition(false, 1500) == false);
+	Guard.requestCleared();
+	CHECK(Guard.deferred() == false);
+	CHECK_EQUAL(1, Guard.deferredCount());
+	CHECK_EQUAL(1, Guard.coalescedCount());
+	CHECK_EQUAL(0, Guard.offCount());
+
+	// Bypassed once, e.g. for turnOff()
+	Guard.bypassNext();
+	CHECK(Guard.requestTransition(false, 1600) == true);
+
+}
+
+static void testPump()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(hostRolloverStart(ROLLOVER_SECONDS));
+
+	AcksenRelayGuard Guard;
+	Guard.ulMinOnTime = 2000;
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachRelayGuard(&Guard);
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Switched OFF too soon - held ON until the dwell time is up, on the far side of the rollover
+	AcksenHalHost::advanceMicros(500000ULL);
+	Pump.ToggleState();
+
+	unsigned long ulElapsed = 500;
+
+	while ((AcksenHalHost::pinLevel(PUMP_OUT_IO) == PUMP_POSITIVE_LOGIC_ON) && (ulElapsed < 5000))
+	{
+		Pump.process();
+
+		if (AcksenHalHost::pinLevel(PUMP_OUT_IO) == PUMP_POSITIVE_LOGIC_ON)
+		{
+			AcksenHalHost::advanceMicros(100000ULL);
+			ulElapsed += 100;
+		}
+	}
+
+	CHECK_EQUAL(2000, ulElapsed);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(1, Guard.deferredCount());
+
+	// Held OFF for the default ulMinOffTime
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	AcksenHalHost::advanceMicros(2100000ULL);
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// turnOff() is never deferred
+	Pump.turnOff();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testDwell();
+	testBurstAndRefill();
+	testCoalesced();
+	testPump();
+
+	return hostTestResult("relay_guard_test");
+
+}
@@ -0,0 +1,111 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - Pump Sequences: the built-in Pump Ventilation Sequence with and without Ventilation Cycles (a single ON pulse with none, as in v1.8),
+// and a custom Sequence with a loop and a temperature exit run by runSequence().
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+#define STEP_MILLIS			10
+
+#define VENT_ON_MS			500
+#define VENT_OFF_MS			200
+
+// 2 x (100ms ON, 50ms OFF), then ON until 60C, then stop
+const AcksenPumpStep TestSequence[] PROGMEM =
+{
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_MILLIS,		100,				0,	0,	PUMP_STEP_EXIT_NONE,				0 },
+	{ PUMP_OUTPUT_STATE_OFF,	PUMP_STEP_DURATION_MILLIS,		50,					2,	0,	PUMP_STEP_EXIT_NONE,				0 },
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_UNTIL_EXIT,	0,					0,	0,	PUMP_STEP_EXIT_TEMPERATURE_ABOVE,	60 },
+	{ PUMP_STEP_END,			0,								PUMP_CONTROL_STOP,	0,	0,	PUMP_STEP_EXIT_NONE,				0 }
+};
+
+// Step the clock, calling process() each step.  Returns the number of Pump Output changes.
+static unsigned long runFor(AcksenPump &Pump, unsigned long ulMillis)
+{
+
+	unsigned long ulChanges = AcksenHalHost::pinChangeCount(PUMP_OUT_IO);
+
+	for (unsigned long ulElapsed = 0; ulElapsed < ulMillis; ulElapsed += STEP_MILLIS)
+	{
+		Pump.process();
+		AcksenHalHost::advanceMicros(STEP_MILLIS * 1000ULL);
+	}
+
+	Pump.process();
+
+	return AcksenHalHost::pinChangeCount(PUMP_OUT_IO) - ulChanges;
+
+}
+
+static void testVentilation(int iCycles)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iPumpVentilationCycles = iCycles;
+	Pump.uiPumpVentilationOnLengthMillis = VENT_ON_MS;
+	Pump.uiPumpVentilationOffLengthMillis = VENT_OFF_MS;
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Venting for iCycles + 1 ON steps and iCycles OFF steps - a single ON step with no cycles
+	unsigned long ulVentMillis = ((unsigned long)(iCycles + 1) * VENT_ON_MS) + ((unsigned long)iCycles * VENT_OFF_MS);
+
+	CHECK_EQUAL(2 * iCycles, runFor(Pump, ulVentMillis - STEP_MILLIS));
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+	CHECK_EQUAL(0, runFor(Pump, STEP_MILLIS));
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	CHECK_EQUAL(0, runFor(Pump, 5000));
+
+}
+
+static void testCustomSequence()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.updatePumpTemperature(20.0f);
+
+	Pump.runSequence(TestSequence);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_SEQUENCE, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Two passes of the loop, then held ON until the exit condition
+	CHECK_EQUAL(3, runFor(Pump, 290));
+	CHECK_EQUAL(1, runFor(Pump, 10));
+	CHECK_EQUAL(0, runFor(Pump, 10000));
+	CHECK_EQUAL(PUMP_CONTROL_SEQUENCE, Pump.iControlState);
+
+	Pump.updatePumpTemperature(60.0f);
+	runFor(Pump, STEP_MILLIS);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testVentilation(0);
+	testVentilation(1);
+	testVentilation(3);
+	testCustomSequence();
+
+	return hostTestResult("sequence_test");
+
+}
@@ -0,0 +1,127 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpSim replaying a short scripted scenario: the recorded timeline, and the over temperature invariant.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPumpSim.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+static const AcksenPumpSimEvent Scenario[] =
+{
+	{ 1000,		PUMP_SIM_ACTION_TEMPERATURE,	0,	2000 },
+	{ 1000,		PUMP_SIM_ACTION_TOGGLE,			0,	0 },
+	{ 30000,	PUMP_SIM_ACTION_TEMPERATURE,	0,	9550 },
+	{ 40000,	PUMP_SIM_ACTION_TEMPERATURE,	0,	6700 },
+	{ 45000,	PUMP_SIM_ACTION_TOGGLE,			0,	0 },
+	{ 50000,	PUMP_SIM_ACTION_TURN_OFF,		0,	0 }
+};
+
+// Expected timeline - two vent cycles, a trip at 95.5C, then a restart that is turned off part way through its vent
+static const AcksenPumpSimTransition Expected[] =
+{
+	{ 1000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_ON },
+	{ 6000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_OFF },
+	{ 8000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_ON },
+	{ 13000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_OFF },
+	{ 15000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_ON },
+	{ 20000000ULL,	0,	PUMP_CONTROL_ON,	PUMP_OUTPUT_STATE_ON },
+	{ 30000000ULL,	0,	PUMP_CONTROL_STOP,	PUMP_OUTPUT_STATE_OFF },
+	{ 45000000ULL,	0,	PUMP_CONTROL_VENT,	PUMP_OUTPUT_STATE_ON },
+	{ 50000000ULL,	0,	PUMP_CONTROL_STOP,	PUMP_OUTPUT_STATE_OFF }
+};
+
+#define EXPECTED_COUNT		(sizeof(Expected) / sizeof(Expected[0]))
+
+static AcksenPumpSimTransition Timeline[EXPECTED_COUNT + 4];
+
+static void testTimeline(uint64_t ullStartMicros)
+{
+
+	AcksenHalHost::reset();
+
+	AcksenPumpSim Sim(ullStartMicros);
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpVentilationCycles = 2;
+	Pump.iPumpVentilationOnLength = 5;
+	Pump.iPumpVentilationOffLength = 2;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	CHECK_EQUAL(0, Sim.addPump(&Pump));
+	Sim.setScenario(Scenario, sizeof(Scenario) / sizeof(Scenario[0]));
+	Sim.setTimeline(Timeline, sizeof(Timeline) / sizeof(Timeline[0]));
+
+	// Tripped within the grace period, so no violation
+	CHECK_EQUAL(0, Sim.run(60000));
+	CHECK_EQUAL(EXPECTED_COUNT, Sim.transitionCount());
+
+	for (unsigned int i = 0; (i < EXPECTED_COUNT) && (i < Sim.transitionCount()); i++)
+	{
+		CHECK_EQUAL(Expected[i].ullMicros / 1000ULL, Timeline[i].ullMicros / 1000ULL);
+		CHECK_EQUAL(Expected[i].ui8Pump, Timeline[i].ui8Pump);
+		CHECK_EQUAL(Expected[i].ui8ControlState, Timeline[i].ui8ControlState);
+		CHECK_EQUAL(Expected[i].ui8OutputState, Timeline[i].ui8OutputState);
+	}
+
+	uint8_t ui8Pump;
+	uint64_t ullMicros;
+	CHECK_EQUAL(PUMP_SIM_INVARIANT_NONE, Sim.firstViolation(ui8Pump, ullMicros));
+
+	// Warped from one deadline to the next, rather than ticking every millisecond
+	CHECK(Sim.stepCount() < 1000);
+
+}
+
+// Without a Phase Sync waveform, the trip waits out PHASE_SYNC_TIMEOUT for each input level.  Flagged only if that is longer than the grace period.
+static void testOverTemperatureGrace(unsigned long ulTripGraceMillis, unsigned long ulViolations)
+{
+
+	AcksenHalHost::reset();
+
+	AcksenPumpSim Sim;
+	Sim.ulTripGraceMillis = ulTripGraceMillis;
+
+	AcksenPump Pump(PUMP_OUT_IO, PHASE_SYNC_IN_IO);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnablePhaseSync = true;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	Sim.addPump(&Pump);
+	Sim.setScenario(Scenario, 3);
+
+	CHECK_EQUAL(ulViolations, Sim.run(35000));
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Pump.iOutputStateActual);
+
+	uint8_t ui8Pump;
+	uint64_t ullMicros;
+	uint8_t ui8Invariant = Sim.firstViolation(ui8Pump, ullMicros);
+
+	if (ulViolations == 0)
+	{
+		CHECK_EQUAL(PUMP_SIM_INVARIANT_NONE, ui8Invariant);
+	}
+	else
+	{
+		CHECK_EQUAL(PUMP_SIM_INVARIANT_OVER_TEMPERATURE, ui8Invariant);
+		CHECK_EQUAL(0, ui8Pump);
+		CHECK(ullMicros > (30000ULL + ulTripGraceMillis) * 1000ULL);
+		CHECK(ullMicros <= (30000ULL + (2 * PHASE_SYNC_TIMEOUT)) * 1000ULL);
+	}
+
+}
+
+int main()
+{
+
+	testTimeline(0);
+	testTimeline(hostRolloverStart(30));
+	testOverTemperatureGrace(PUMP_SIM_TRIP_GRACE_MILLIS_DEFAULT, 0);
+	testOverTemperatureGrace(10, 1);
+
+	return hostTestResult("sim_test");
+
+}
@@ -0,0 +1,122 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - step() never blocks, and reports why it yielded and when to run it next, through the Relay Switching Delay, a Phase Sync wait,
+// Ventilation steps and idle.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+#define RELAY_DELAY_MS		200
+#define VENT_ON_MS			1000
+#define VENT_OFF_MS			500
+
+static void testVentilation()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.iPumpVentilationCycles = 1;
+	Pump.uiPumpVentilationOnLengthMillis = VENT_ON_MS;
+	Pump.uiPumpVentilationOffLengthMillis = VENT_OFF_MS;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+
+	unsigned long ulWake;
+
+	// Nothing to do yet
+	CHECK_EQUAL(PUMP_YIELD_IDLE, Pump.step(ulWake));
+	CHECK_EQUAL(AcksenHalHost::timeMillis() + PUMP_NEXT_EVENT_IDLE_INTERVAL, ulWake);
+	CHECK(Pump.bNonBlockingSwitching == true);
+
+	// Switched ON without blocking, then settling
+	unsigned long ulStart = AcksenHalHost::timeMillis();
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_YIELD_SETTLING, Pump.step(ulWake));
+	CHECK_EQUAL(ulStart, AcksenHalHost::timeMillis());
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(ulStart + RELAY_DELAY_MS, ulWake);
+
+	// Early wake changes nothing
+	AcksenHalHost::advanceMicros(100000ULL);
+	CHECK_EQUAL(PUMP_YIELD_SETTLING, Pump.step(ulWake));
+	CHECK_EQUAL(ulStart + RELAY_DELAY_MS, ulWake);
+
+	// Settled - waiting for the end of the Ventilation ON step
+	AcksenHalHost::advanceMicros(100000ULL);
+	CHECK_EQUAL(PUMP_YIELD_SEQUENCE_STEP, Pump.step(ulWake));
+	CHECK_EQUAL(ulStart + VENT_ON_MS, ulWake);
+
+	// Woken as asked, through the OFF step and final ON pulse
+	AcksenHalHost::advanceMicros((ulWake - AcksenHalHost::timeMillis()) * 1000ULL);
+	CHECK_EQUAL(PUMP_YIELD_SETTLING, Pump.step(ulWake));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_CONTROL_VENT, Pump.iControlState);
+
+	for (int i = 0; (i < 10) && (Pump.iControlState == PUMP_CONTROL_VENT); i++)
+	{
+		AcksenHalHost::advanceMicros((ulWake - AcksenHalHost::timeMillis()) * 1000ULL);
+		Pump.step(ulWake);
+	}
+
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(ulStart + (2 * VENT_ON_MS) + VENT_OFF_MS, AcksenHalHost::timeMillis());
+
+	// Running - idle until an input changes
+	AcksenHalHost::advanceMicros(RELAY_DELAY_MS * 1000ULL);
+	CHECK_EQUAL(PUMP_YIELD_IDLE, Pump.step(ulWake));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// turnOff() queues the transition rather than blocking, once step() has been used
+	ulStart = AcksenHalHost::timeMillis();
+	Pump.turnOff();
+	CHECK_EQUAL(ulStart, AcksenHalHost::timeMillis());
+	CHECK_EQUAL(PUMP_YIELD_SETTLING, Pump.step(ulWake));
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testPhaseSync()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, PHASE_SYNC_IN_IO);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnablePhaseSync = true;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, LOW);
+
+	unsigned long ulWake;
+
+	// Polling the input - run again straight away
+	Pump.ToggleState();
+	CHECK_EQUAL(PUMP_YIELD_PHASE_SYNC, Pump.step(ulWake));
+	CHECK_EQUAL(AcksenHalHost::timeMillis(), ulWake);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	AcksenHalHost::advanceMicros(1000ULL);
+	CHECK_EQUAL(PUMP_YIELD_PHASE_SYNC, Pump.step(ulWake));
+
+	// Zero Crossing - switched on this pass
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, HIGH);
+	Pump.step(ulWake);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+
+}
+
+int main()
+{
+
+	testVentilation();
+	testPhaseSync();
+
+	return hostTestResult("step_test");
+
+}
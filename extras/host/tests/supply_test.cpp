@@ -0,0 +1,85 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpSupply: a waiting start is released when the earliest inrush window ends.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpSupply.h"
+
+#define PUMP_1_OUT_IO		3
+#define PUMP_2_OUT_IO		4
+#define PUMP_3_OUT_IO		5
+
+static void testEarliestInrushEnd()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump1(PUMP_1_OUT_IO, -1);
+	AcksenPump Pump2(PUMP_2_OUT_IO, -1);
+	AcksenPump Pump3(PUMP_3_OUT_IO, -1);
+
+	AcksenPumpSupply Supply;
+	Supply.uiBudget = 2;
+	Supply.ulStaggerTime = 0;
+	Supply.ulInrushTime = 1000;
+
+	CHECK_EQUAL(0, Supply.addPump(&Pump1));
+	CHECK_EQUAL(1, Supply.addPump(&Pump2));
+	CHECK_EQUAL(2, Supply.addPump(&Pump3));
+
+	// Second pump starts first, so the first pump's window ends last
+	CHECK(Supply.requestStart(&Pump2, 0));
+	CHECK(Supply.requestStart(&Pump1, 500));
+	CHECK_EQUAL(2, Supply.activeWeight(500));
+
+	// Budget in use - waits for the second pump's window, not the first
+	CHECK(Supply.requestStart(&Pump3, 600) == false);
+	CHECK(Supply.waiting(&Pump3));
+	CHECK_EQUAL(1000UL, Supply.nextReleaseMillis(&Pump3, 600));
+
+	CHECK(Supply.requestStart(&Pump3, 999) == false);
+	CHECK(Supply.requestStart(&Pump3, 1000));
+	CHECK(Supply.waiting(&Pump3) == false);
+
+}
+
+static void testStaggerLater()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump1(PUMP_1_OUT_IO, -1);
+	AcksenPump Pump2(PUMP_2_OUT_IO, -1);
+
+	AcksenPumpSupply Supply;
+	Supply.uiBudget = 1;
+	Supply.ulStaggerTime = 1500;
+	Supply.ulInrushTime = 1000;
+
+	Supply.addPump(&Pump1);
+	Supply.addPump(&Pump2);
+
+	CHECK(Supply.requestStart(&Pump1, 0));
+
+	// Inrush window ends at 1000, but the stagger gap runs until 1500
+	CHECK(Supply.requestStart(&Pump2, 100) == false);
+	CHECK_EQUAL(1500UL, Supply.nextReleaseMillis(&Pump2, 100));
+
+	CHECK(Supply.requestStart(&Pump2, 1499) == false);
+	CHECK(Supply.requestStart(&Pump2, 1500));
+
+}
+
+int main()
+{
+
+	testEarliestInrushEnd();
+	testStaggerLater();
+
+	return hostTestResult("supply_test");
+
+}
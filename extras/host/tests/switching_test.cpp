@@ -0,0 +1,207 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - turning Non-Blocking Switching off part way through a Pump Output transition completes the transition, rather than leaving it stuck, including when setConfig() turns it off.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpBank.h"
+
+#define PUMP_OUT_IO			3
+#define PHASE_SYNC_IN_IO	2
+
+#define RELAY_DELAY_MS		500
+
+// Call process() every 10ms for the given time, as a sketch loop() would
+static void runFor(AcksenPump &Pump, unsigned long ulMillis)
+{
+
+	for (unsigned long ulElapsed = 0; ulElapsed < ulMillis; ulElapsed += 10)
+	{
+		Pump.process();
+		AcksenHalHost::advanceMicros(10000ULL);
+	}
+
+}
+
+static void checkSettled(AcksenPump &Pump)
+{
+
+	CHECK(Pump.switchingSettled());
+	CHECK_EQUAL(0UL, Pump.settlingTimeRemaining());
+
+	// Nothing left due - the fast path and sleeping hosts must see a future deadline
+	CHECK((int32_t)(Pump.nextEventMillis() - AcksenHalHost::timeMillis()) > 0);
+
+}
+
+static void testSettling()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+	Pump.bNonBlockingSwitching = true;
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_SWITCH_STATE_SETTLING, Pump.switchingState());
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	AcksenHalHost::advanceMicros(100000ULL);
+
+	// Rest of the settling window is waited out by the next (blocking) pass
+	Pump.bNonBlockingSwitching = false;
+	unsigned long ulStart = AcksenHalHost::timeMillis();
+	Pump.process();
+	CHECK_EQUAL(400UL, AcksenHalHost::timeMillis() - ulStart);
+	checkSettled(Pump);
+
+	runFor(Pump, 5000);
+	checkSettled(Pump);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+
+	// Later transitions block as normal
+	Pump.ToggleState();
+	ulStart = AcksenHalHost::timeMillis();
+	Pump.process();
+	CHECK_EQUAL((unsigned long)RELAY_DELAY_MS, AcksenHalHost::timeMillis() - ulStart);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	checkSettled(Pump);
+
+}
+
+static void testPending()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+	AcksenHalHost::setInputLevel(PHASE_SYNC_IN_IO, LOW);
+
+	// Phase Sync input that never rises, so the transition stays PENDING until the timeout
+	AcksenPump Pump(PUMP_OUT_IO, PHASE_SYNC_IN_IO);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnablePhaseSync = true;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+	Pump.bNonBlockingSwitching = true;
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_SWITCH_STATE_PENDING, Pump.switchingState());
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Completed by the next pass, with the blocking Phase Sync wait and Relay Switching Delay
+	Pump.bNonBlockingSwitching = false;
+	Pump.process();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+	checkSettled(Pump);
+
+	runFor(Pump, 5000);
+	checkSettled(Pump);
+	CHECK_EQUAL(1, AcksenHalHost::pinChangeCount(PUMP_OUT_IO));
+
+}
+
+static void testTurnOff()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+	Pump.bNonBlockingSwitching = true;
+
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_SWITCH_STATE_SETTLING, Pump.switchingState());
+
+	// Blocking turnOff() during the settling window
+	Pump.bNonBlockingSwitching = false;
+	Pump.turnOff();
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	checkSettled(Pump);
+
+	runFor(Pump, 1000);
+	checkSettled(Pump);
+
+}
+
+static void testSetConfig()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+
+	// Stored config with blocking switching
+	AcksenPumpConfig cfConfig;
+	Pump.getConfig(cfConfig);
+
+	Pump.bNonBlockingSwitching = true;
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_SWITCH_STATE_SETTLING, Pump.switchingState());
+
+	// Loaded part way through the settling window
+	Pump.setConfig(cfConfig);
+	CHECK(Pump.bNonBlockingSwitching == false);
+	CHECK(Pump.switchingSettled());
+
+	runFor(Pump, 5000);
+	checkSettled(Pump);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_ON, Pump.iOutputStateActual);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testBank()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpBank<2> Bank;
+	Bank.iPumpRelaySwitchingDelay = RELAY_DELAY_MS;
+	Bank.bNonBlockingSwitching = true;
+
+	int iPump = Bank.addPump(PUMP_OUT_IO);
+	Bank.bEnablePumpVentilation = false;
+
+	Bank.ToggleState(iPump);
+	Bank.process();
+	CHECK(Bank.switchingSettled() == false);
+
+	Bank.bNonBlockingSwitching = false;
+
+	for (int i = 0; i < 500; i++)
+	{
+		Bank.process();
+		AcksenHalHost::advanceMicros(10000ULL);
+	}
+
+	CHECK(Bank.switchingSettled());
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+int main()
+{
+
+	testSettling();
+	testPending();
+	testTurnOff();
+	testSetConfig();
+	testBank();
+
+	return hostTestResult("switching_test");
+
+}
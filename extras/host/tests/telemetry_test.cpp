@@ -0,0 +1,257 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenPumpTelemetry frames decoded by AcksenPumpTelemetryDecoder: key and delta snapshots, events, 16-bit times across the millis() rollover,
+// partial drains, and recovery after a dropped frame or a corrupted byte.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpTelemetry.h"
+
+#define PUMP_OUT_IO			3
+#define PUMP_ID				7
+
+#define PORT_CAPACITY		1024
+
+// millis() rolls over this many Seconds into the test
+#define ROLLOVER_SECONDS		20
+
+// Serial port stand-in, accepting up to iSpace Bytes before it is full
+struct TestPort
+{
+	uint8_t aui8Data[PORT_CAPACITY];
+	size_t uiLength = 0;
+	size_t uiRead = 0;
+	int iSpace = PORT_CAPACITY;
+
+	int availableForWrite() { return iSpace; }
+
+	size_t write(const uint8_t *pData, size_t uiCount)
+	{
+		for (size_t i = 0; i < uiCount; i++)
+		{
+			aui8Data[uiLength++] = pData[i];
+		}
+
+		iSpace -= (int)uiCount;
+		return uiCount;
+	}
+};
+
+// Feed everything written since the last call to the decoder.  Returns the number of frames of the given type decoded.
+static int decodeAll(TestPort &tpPort, AcksenPumpTelemetryDecoder &Decoder, uint8_t ui8FrameType)
+{
+
+	int iFrames = 0;
+
+	while (tpPort.uiRead < tpPort.uiLength)
+	{
+		if (Decoder.feed(tpPort.aui8Data[tpPort.uiRead++]) == ui8FrameType)
+		{
+			iFrames++;
+		}
+	}
+
+	return iFrames;
+
+}
+
+static void testSnapshots()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(hostRolloverStart(ROLLOVER_SECONDS));
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.updatePumpTemperature(65.25f);
+
+	AcksenPumpTelemetry Telemetry;
+	AcksenPumpTelemetryDecoder Decoder;
+	TestPort tpPort;
+	AcksenPumpTelemetryState stState;
+
+	CHECK(Telemetry.addPump(&Pump, PUMP_ID) == true);
+	CHECK(Decoder.state(PUMP_ID, stState) == false);
+
+	// First snapshot is a key frame, with the full time: 4 header, 4 time, 2 + 5 payload, 2 CRC
+	CHECK_EQUAL(1, Telemetry.sendSnapshots());
+	CHECK_EQUAL(17, Telemetry.pending());
+
+	// Drained only as fast as the port accepts
+	tpPort.iSpace = 5;
+	CHECK_EQUAL(5, Telemetry.drain(tpPort));
+	CHECK_EQUAL(0, Telemetry.drain(tpPort));
+	CHECK_EQUAL(0, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+
+	tpPort.iSpace = PORT_CAPACITY;
+	CHECK_EQUAL(12, Telemetry.drain(tpPort));
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+
+	CHECK(Decoder.state(PUMP_ID, stState) == true);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, stState.ui8ControlState);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, stState.ui8OutputState);
+	CHECK_EQUAL(6525, stState.iTemperatureCenti);
+	CHECK_EQUAL(PUMP_FLOW_PERCENT_FULL, stState.ui8FlowPercent);
+	CHECK_EQUAL(AcksenHalHost::timeMillis(), stState.ulTimeMillis);
+
+	// Unchanged fields are left out: 4 header, 2 time, 2 payload, 2 CRC
+	AcksenHalHost::advanceMicros(1000000ULL);
+	Telemetry.sendSnapshots();
+	CHECK_EQUAL(10, Telemetry.pending());
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+
+	// Changed fields are sent, and applied to the previous state - 16-bit times extended across the rollover
+	for (int i = 0; i < 10; i++)
+	{
+
+		AcksenHalHost::advanceMicros(5000000ULL);
+		Pump.ToggleState();
+		Pump.process();
+		Pump.updatePumpTemperature(70.0f + i);
+
+		Telemetry.sendSnapshots();
+		Telemetry.drain(tpPort);
+		CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+
+		CHECK(Decoder.state(PUMP_ID, stState) == true);
+		CHECK_EQUAL(Pump.iControlState, stState.ui8ControlState);
+		CHECK_EQUAL(Pump.iOutputStateActual, stState.ui8OutputState);
+		CHECK_EQUAL((70 + i) * 100, stState.iTemperatureCenti);
+		CHECK_EQUAL(AcksenHalHost::timeMillis(), (uint32_t)stState.ulTimeMillis);
+
+	}
+
+	CHECK(AcksenHalHost::timeMillis() < 100000UL);
+	CHECK_EQUAL(12, Decoder.frameCount());
+	CHECK_EQUAL(0, Decoder.errorCount());
+	CHECK_EQUAL(0, Decoder.lostCount());
+
+}
+
+static void testEvents()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpTelemetry Telemetry;
+	AcksenPumpTelemetryDecoder Decoder;
+	TestPort tpPort;
+
+	AcksenPumpEvent evEvent;
+	evEvent.ulTimeMillis = 123456UL;
+	evEvent.ui8PumpId = PUMP_ID;
+	evEvent.ui8Type = PUMP_EVENT_OVER_TEMPERATURE;
+	evEvent.ui8Value = PUMP_CONTROL_ON;
+
+	CHECK(Telemetry.sendEvent(evEvent) == true);
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_EVENT));
+
+	CHECK_EQUAL(123456UL, Decoder.event().ulTimeMillis);
+	CHECK_EQUAL(PUMP_ID, Decoder.event().ui8PumpId);
+	CHECK_EQUAL(PUMP_EVENT_OVER_TEMPERATURE, Decoder.event().ui8Type);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Decoder.event().ui8Value);
+
+}
+
+static void testDroppedFrame()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+
+	AcksenPumpTelemetry Telemetry;
+	AcksenPumpTelemetryDecoder Decoder;
+	TestPort tpPort;
+	AcksenPumpTelemetryState stState;
+
+	Telemetry.addPump(&Pump, PUMP_ID);
+	Telemetry.sendSnapshots();
+
+	// Fill the buffer, without draining, until a frame is dropped
+	AcksenPumpEvent evEvent;
+	evEvent.ulTimeMillis = 0;
+	evEvent.ui8PumpId = PUMP_ID;
+	evEvent.ui8Type = PUMP_EVENT_OUTPUT_ON;
+	evEvent.ui8Value = 1;
+
+	int iQueued = 0;
+
+	while (Telemetry.sendEvent(evEvent) == true)
+	{
+		iQueued++;
+	}
+
+	CHECK(iQueued > 0);
+	CHECK_EQUAL(1, Telemetry.droppedCount());
+
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(iQueued, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_EVENT));
+	CHECK(Decoder.state(PUMP_ID, stState) == true);
+
+	// The next frame, sent with the full time, shows the gap - pump states can't be trusted until the next key frame
+	Pump.updatePumpTemperature(50.0f);
+	Telemetry.sendEvent(evEvent);
+	CHECK_EQUAL(13, Telemetry.pending());
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_EVENT));
+	CHECK_EQUAL(1, Decoder.lostCount());
+	CHECK(Decoder.state(PUMP_ID, stState) == false);
+
+	// ...which the encoder sends next
+	Telemetry.sendSnapshots();
+	CHECK_EQUAL(15, Telemetry.pending());
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+	CHECK(Decoder.state(PUMP_ID, stState) == true);
+	CHECK_EQUAL(5000, stState.iTemperatureCenti);
+
+}
+
+static void testCorruptedByte()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+
+	AcksenPumpTelemetry Telemetry;
+	AcksenPumpTelemetryDecoder Decoder;
+	TestPort tpPort;
+
+	Telemetry.addPump(&Pump, PUMP_ID);
+	Telemetry.sendSnapshots();
+	Telemetry.drain(tpPort);
+
+	// Flip a payload bit - rejected by the CRC
+	tpPort.aui8Data[tpPort.uiLength - 3] ^= 0x01;
+	CHECK_EQUAL(0, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+	CHECK_EQUAL(1, Decoder.errorCount());
+
+	// Resynchronised on the next frame
+	Pump.updatePumpTemperature(40.0f);
+	Telemetry.sendSnapshots();
+	Telemetry.drain(tpPort);
+	CHECK_EQUAL(1, decodeAll(tpPort, Decoder, PUMP_TELEMETRY_FRAME_SNAPSHOT));
+	CHECK_EQUAL(4000, Decoder.snapshot().iTemperatureCenti);
+
+}
+
+int main()
+{
+
+	testSnapshots();
+	testEvents();
+	testDroppedFrame();
+	testCorruptedByte();
+
+	return hostTestResult("telemetry_test");
+
+}
@@ -0,0 +1,175 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - float temperature readings, including NaN and out of range readings from a failed sensor, must stop a pump.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+#include "AcksenPumpBank.h"
+#include "AcksenPumpT.h"
+
+#include <math.h>
+
+#define PUMP_OUT_IO			3
+
+static void testConversion()
+{
+
+	CHECK_EQUAL(9000, AcksenPumpCentidegrees(90.0f));
+	CHECK_EQUAL(-1050, AcksenPumpCentidegrees(-10.5f));
+	CHECK_EQUAL(32766, AcksenPumpCentidegrees(327.66f));
+
+	// Failed sensor readings give the fail-safe high value, never a wrapped or zero one
+	CHECK_EQUAL(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, AcksenPumpCentidegrees(400.0f));
+	CHECK_EQUAL(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, AcksenPumpCentidegrees(-400.0f));
+	CHECK_EQUAL(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, AcksenPumpCentidegrees(NAN));
+	CHECK_EQUAL(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, AcksenPumpCentidegrees(INFINITY));
+	CHECK_EQUAL(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, AcksenPumpCentidegrees(-INFINITY));
+
+	// Limits beyond the 16-bit range are clamped below the fail-safe value, so it still trips
+	CHECK_EQUAL(9300, AcksenPumpLimitCentidegrees(93));
+	CHECK_EQUAL(32700, AcksenPumpLimitCentidegrees(327));
+	CHECK_EQUAL(32700, AcksenPumpLimitCentidegrees(328));
+	CHECK_EQUAL(32700, AcksenPumpLimitCentidegrees(100000L));
+	CHECK_EQUAL(-32700, AcksenPumpLimitCentidegrees(-400));
+	CHECK(PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES >= AcksenPumpLimitCentidegrees(32767));
+
+}
+
+static void testHighLimit()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	// A limit above 327C runs at any real reading, but a failed sensor still stops the Pump
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.iMaxPumpTemperature = 400;
+
+	AcksenPumpBank<2> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+	Bank.iMaxPumpTemperature = 400;
+	int iPump = Bank.addPump(PUMP_OUT_IO + 1);
+
+	AcksenPumpT<PUMP_OUT_IO + 2, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_MAX_TEMPERATURE> PumpT;
+	PumpT.iPumpRelaySwitchingDelay = 0;
+	PumpT.iMaxPumpTemperature = 400;
+
+	Pump.updatePumpTemperature(300.0f);
+	Bank.updatePumpTemperature(iPump, 300.0f);
+	PumpT.updatePumpTemperature(300.0f);
+	Pump.ToggleState();
+	Bank.ToggleState(iPump);
+	PumpT.ToggleState();
+	Pump.process();
+	Bank.process();
+	PumpT.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iPump));
+	CHECK_EQUAL(PUMP_CONTROL_ON, PumpT.iControlState);
+
+	Pump.updatePumpTemperature(NAN);
+	Bank.updatePumpTemperature(iPump, NAN);
+	PumpT.updatePumpTemperature(NAN);
+	Pump.process();
+	Bank.process();
+	PumpT.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iPump));
+	CHECK_EQUAL(PUMP_CONTROL_STOP, PumpT.iControlState);
+
+}
+
+static void testPumpStops(float fReading)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	// Running pump stops
+	Pump.updatePumpTemperature(90.0f);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	Pump.updatePumpTemperature(fReading);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Stopped pump refuses to start
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+}
+
+static void testBankStops(float fReading)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpBank<2> Bank;
+	Bank.bEnablePumpVentilation = false;
+	Bank.iPumpRelaySwitchingDelay = 0;
+
+	int iPump = Bank.addPump(PUMP_OUT_IO);
+
+	Bank.updatePumpTemperature(iPump, 90.0f);
+	Bank.ToggleState(iPump);
+	Bank.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Bank.controlState(iPump));
+
+	Bank.updatePumpTemperature(iPump, fReading);
+	Bank.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Bank.controlState(iPump));
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Bank.outputState(iPump));
+
+}
+
+static void testTemplateStops(float fReading)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenPumpT<PUMP_OUT_IO, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_MAX_TEMPERATURE> Pump;
+	Pump.iPumpRelaySwitchingDelay = 0;
+
+	Pump.updatePumpTemperature(90.0f);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	Pump.updatePumpTemperature(fReading);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+}
+
+int main()
+{
+
+	testConversion();
+	testHighLimit();
+
+	const float fFailedReadings[] = { 400.0f, -400.0f, NAN, 110.0f };
+
+	for (unsigned int i = 0; i < (sizeof(fFailedReadings) / sizeof(fFailedReadings[0])); i++)
+	{
+		testPumpStops(fFailedReadings[i]);
+		testBankStops(fFailedReadings[i]);
+		testTemplateStops(fFailedReadings[i]);
+	}
+
+	return hostTestResult("temperature_test");
+
+}
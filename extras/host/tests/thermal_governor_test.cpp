@@ -0,0 +1,276 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenThermalGovernor limit and predicted trips, clearing with hysteresis and the resume delay (across the millis() rollover), automatic resume of an AcksenPump, and the immediate trip on an unfiltered reading at the limit.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenPump.h"
+
+#define PUMP_OUT_IO			3
+
+#define LIMIT_TENTHS		900
+
+// millis() rolls over 20s after this
+#define ROLLOVER_MILLIS		0xFFFFB1DFUL
+
+// millis() rolls over this many Seconds into the test
+#define ROLLOVER_SECONDS		20
+
+static void unfiltered(AcksenThermalGovernor &Governor)
+{
+	Governor.ui8FilterShift = 0;
+	Governor.ui8PredictionHorizon = 0;
+	Governor.ui8Hysteresis = 50;
+	Governor.uiResumeDelay = 60;
+}
+
+static void testLimitTrip()
+{
+
+	AcksenThermalGovernor Governor;
+	unfiltered(Governor);
+
+	unsigned long ulStart = ROLLOVER_MILLIS;
+
+	Governor.update(800, LIMIT_TENTHS, ulStart);
+	CHECK(Governor.tripped() == false);
+	CHECK_EQUAL(THERMAL_TRIP_NONE, Governor.tripReason());
+
+	Governor.update(LIMIT_TENTHS, LIMIT_TENTHS, wrapMillis(ulStart + 1000));
+	CHECK(Governor.tripped() == true);
+	CHECK_EQUAL(THERMAL_TRIP_LIMIT, Governor.tripReason());
+	CHECK_EQUAL(1, Governor.tripCount());
+
+	// Below the limit, but not by the hysteresis
+	Governor.update(860, LIMIT_TENTHS, wrapMillis(ulStart + 10000));
+	CHECK(Governor.tripped() == true);
+
+	// Cooled by the hysteresis, but not rested for the resume delay
+	Governor.update(LIMIT_TENTHS - 50, LIMIT_TENTHS, wrapMillis(ulStart + 60999));
+	CHECK(Governor.tripped() == true);
+
+	// Both, with the delay ending after the rollover
+	Governor.update(LIMIT_TENTHS - 50, LIMIT_TENTHS, wrapMillis(ulStart + 61000));
+	CHECK(Governor.tripped() == false);
+	CHECK_EQUAL(THERMAL_TRIP_LIMIT, Governor.tripReason());
+
+	// Nothing to resume, as the pump was never recorded as running
+	CHECK(Governor.takeResume() == false);
+
+}
+
+static void testPredictedTrip()
+{
+
+	AcksenThermalGovernor Governor;
+	unfiltered(Governor);
+	Governor.ui8PredictionHorizon = 30;
+
+	unsigned long ulStart = ROLLOVER_MILLIS;
+
+	// Rising 1C per second reaches the limit within the horizon, while still 9C below it
+	Governor.update(800, LIMIT_TENTHS, ulStart);
+	CHECK(Governor.tripped() == false);
+
+	Governor.update(810, LIMIT_TENTHS, wrapMillis(ulStart + 1000));
+	CHECK(Governor.tripped() == true);
+	CHECK_EQUAL(THERMAL_TRIP_PREDICTED, Governor.tripReason());
+	CHECK(Governor.temperatureRate() > 59.0f);
+
+	// Readings faster than THERMAL_RATE_INTERVAL_MIN are accumulated, not used for the rate
+	Governor.update(810, LIMIT_TENTHS, wrapMillis(ulStart + 1500));
+	CHECK(Governor.temperatureRate() > 59.0f);
+
+	// Levelled off - the rate falls to zero and the trip clears after the resume delay
+	Governor.update(810, LIMIT_TENTHS, wrapMillis(ulStart + 2000));
+	CHECK(Governor.temperatureRate() == 0.0f);
+	CHECK(Governor.tripped() == true);
+
+	Governor.update(810, LIMIT_TENTHS, wrapMillis(ulStart + 61000));
+	CHECK(Governor.tripped() == false);
+
+}
+
+static void testFilter()
+{
+
+	AcksenThermalGovernor Governor;
+	Governor.ui8PredictionHorizon = 0;
+
+	// A single spike to the limit is filtered out (each reading contributes 1/4)
+	Governor.update(800, LIMIT_TENTHS, 0);
+	Governor.update(LIMIT_TENTHS, LIMIT_TENTHS, 100);
+	CHECK(Governor.tripped() == false);
+	CHECK(Governor.filteredTemperature() == 82.5f);
+
+	// A sustained reading trips once the filter catches up
+	for (int i = 0; (i < 20) && (Governor.tripped() == false); i++)
+	{
+		Governor.update(LIMIT_TENTHS + 20, LIMIT_TENTHS, 200 + (i * 100));
+	}
+
+	CHECK(Governor.tripped() == true);
+
+	Governor.reset();
+	CHECK(Governor.tripped() == false);
+	CHECK_EQUAL(0, Governor.tripCount());
+
+}
+
+static void testPumpResume(uint8_t ui8ResumePolicy)
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock(hostRolloverStart(ROLLOVER_SECONDS));
+
+	AcksenThermalGovernor Governor;
+	unfiltered(Governor);
+	Governor.ui8ResumePolicy = ui8ResumePolicy;
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnableMaxPumpTemperature = true;
+	Pump.iMaxPumpTemperature = LIMIT_TENTHS / 10;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachThermalGovernor(&Governor);
+
+	Pump.updatePumpTemperature(80.0f);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	// Trip stops the Pump
+	AcksenHalHost::advanceMicros(1000000ULL);
+	Pump.updatePumpTemperature(91.0f);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Cooled, but inside the resume delay - stays stopped
+	AcksenHalHost::advanceMicros(30000000ULL);
+	Pump.updatePumpTemperature(80.0f);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+	// Cleared after the rollover - restarts by itself only under THERMAL_RESUME_AUTO
+	AcksenHalHost::advanceMicros(31000000ULL);
+	Pump.updatePumpTemperature(80.0f);
+	Pump.process();
+	CHECK(Governor.tripped() == false);
+
+	if (ui8ResumePolicy == THERMAL_RESUME_AUTO)
+	{
+		CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	}
+	else
+	{
+		CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+		CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+	}
+
+}
+
+// Default filter, without prediction - a step over the limit stops the Pump on that reading, before the filter catches up
+static void testUnfilteredLimit()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenThermalGovernor Governor;
+	Governor.ui8PredictionHorizon = 0;
+	Governor.ui8ResumePolicy = THERMAL_RESUME_AUTO;
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnableMaxPumpTemperature = true;
+	Pump.iMaxPumpTemperature = 93;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachThermalGovernor(&Governor);
+
+	Pump.updatePumpTemperature(80.0f);
+	Pump.ToggleState();
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+
+	AcksenHalHost::advanceMicros(1000000ULL);
+	Pump.updatePumpTemperature(99.0f);
+	CHECK(Governor.filteredTemperature() < 93.0f);
+
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+	CHECK_EQUAL(PUMP_OUTPUT_STATE_OFF, Pump.iOutputStateActual);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_OFF, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+	// Held by the governor as any other trip
+	CHECK(Governor.tripped() == true);
+	CHECK_EQUAL(THERMAL_TRIP_LIMIT, Governor.tripReason());
+	CHECK_EQUAL(1, Governor.tripCount());
+
+	// Back under the limit, but inside the resume delay - stays stopped
+	AcksenHalHost::advanceMicros(30000000ULL);
+	Pump.updatePumpTemperature(80.0f);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+	// Cooled and rested - resumed, as the Pump was running when it tripped
+	AcksenHalHost::advanceMicros(31000000ULL);
+	Pump.updatePumpTemperature(80.0f);
+	Pump.process();
+	CHECK(Governor.tripped() == false);
+	CHECK_EQUAL(1, Governor.tripCount());
+	CHECK_EQUAL(PUMP_CONTROL_ON, Pump.iControlState);
+	CHECK_EQUAL(PUMP_POSITIVE_LOGIC_ON, AcksenHalHost::pinLevel(PUMP_OUT_IO));
+
+}
+
+static void testTurnOffCancelsResume()
+{
+
+	AcksenHalHost::reset();
+	AcksenHalHost::useVirtualClock();
+
+	AcksenThermalGovernor Governor;
+	unfiltered(Governor);
+	Governor.ui8ResumePolicy = THERMAL_RESUME_AUTO;
+
+	AcksenPump Pump(PUMP_OUT_IO, -1);
+	Pump.bEnablePumpVentilation = false;
+	Pump.bEnableMaxPumpTemperature = true;
+	Pump.iMaxPumpTemperature = LIMIT_TENTHS / 10;
+	Pump.iPumpRelaySwitchingDelay = 0;
+	Pump.attachThermalGovernor(&Governor);
+
+	Pump.updatePumpTemperature(80.0f);
+	Pump.ToggleState();
+	Pump.process();
+
+	Pump.updatePumpTemperature(91.0f);
+	Pump.process();
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+	// Turned off by the calling software while tripped - stays off once cleared
+	Pump.turnOff();
+	AcksenHalHost::advanceMicros(61000000ULL);
+	Pump.updatePumpTemperature(80.0f);
+	Pump.process();
+	CHECK(Governor.tripped() == false);
+	CHECK_EQUAL(PUMP_CONTROL_STOP, Pump.iControlState);
+
+}
+
+int main()
+{
+
+	testLimitTrip();
+	testPredictedTrip();
+	testFilter();
+	testPumpResume(THERMAL_RESUME_AUTO);
+	testPumpResume(THERMAL_RESUME_MANUAL);
+	testUnfilteredLimit();
+	testTurnOffCancelsResume();
+
+	return hostTestResult("thermal_governor_test");
+
+}
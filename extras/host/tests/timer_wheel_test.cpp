@@ -0,0 +1,207 @@
+// Acksen Pump Library v1.9.0
+//
+// Host test - AcksenTimerWheel arm/cancel, expiry across full turns, catching up after a long gap, and millis() rollover.
+//
+
+#include "AcksenHostTest.h"
+#include "AcksenTimerWheel.h"
+
+#define TIMER_COUNT			6
+#define POLL_MILLIS			10
+
+typedef AcksenTimerWheel<TIMER_COUNT, 16> TestWheel;	// One turn = 16 x 250 = 4000ms
+
+// Poll the wheel every POLL_MILLIS from ulStart for ulLength, recording when each timer expired
+static void pollWheel(TestWheel &twWheel, unsigned long ulStart, unsigned long ulLength, unsigned long aulExpired[], bool abExpired[])
+{
+
+	for (unsigned long ulElapsed = 0; ulElapsed <= ulLength; ulElapsed += POLL_MILLIS)
+	{
+
+		unsigned long ulTimeNow = ulStart + ulElapsed;
+		int iTimer;
+
+		while ((iTimer = twWheel.expired(ulTimeNow)) != -1)
+		{
+			CHECK(abExpired[iTimer] == false);
+			abExpired[iTimer] = true;
+			aulExpired[iTimer] = ulTimeNow;
+		}
+
+	}
+
+}
+
+// Each timer must expire at the first poll at or after its deadline - never early, never a turn late
+static void checkExpiries(unsigned long ulStart, const unsigned long aulDelay[], uint8_t ui8Count, unsigned long ulLength)
+{
+
+	TestWheel twWheel;
+	unsigned long aulExpired[TIMER_COUNT];
+	bool abExpired[TIMER_COUNT] = { false };
+
+	for (uint8_t i = 0; i < ui8Count; i++)
+	{
+		twWheel.arm(i, ulStart, aulDelay[i]);
+		CHECK(twWheel.armed(i) == true);
+		CHECK(twWheel.deadline(i) == (ulStart + aulDelay[i]));
+	}
+
+	CHECK_EQUAL(ui8Count, twWheel.armedCount());
+
+	pollWheel(twWheel, ulStart, ulLength, aulExpired, abExpired);
+
+	for (uint8_t i = 0; i < ui8Count; i++)
+	{
+		unsigned long ulDue = ((aulDelay[i] + POLL_MILLIS - 1) / POLL_MILLIS) * POLL_MILLIS;
+
+		CHECK(abExpired[i] == true);
+		CHECK_EQUAL(ulDue, aulExpired[i] - ulStart);
+		CHECK(twWheel.armed(i) == false);
+	}
+
+	CHECK_EQUAL(0, twWheel.armedCount());
+
+}
+
+static void testArmCancel()
+{
+
+	TestWheel twWheel;
+	unsigned long ulNext = 0;
+
+	CHECK(twWheel.nextDeadline(0, ulNext) == false);
+	CHECK_EQUAL(-1, twWheel.expired(100000));
+
+	// Three timers sharing one slot, and one in another
+	twWheel.arm(0, 1000, 300);
+	twWheel.arm(1, 1000, 310);
+	twWheel.arm(2, 1000, 320);
+	twWheel.arm(3, 1000, 2000);
+	CHECK_EQUAL(4, twWheel.armedCount());
+
+	CHECK(twWheel.nextDeadline(1000, ulNext) == true);
+	CHECK_EQUAL(1300, ulNext);
+
+	// Cancel the middle of a slot list, then the head
+	twWheel.cancel(1);
+	twWheel.cancel(2);
+	twWheel.cancel(2);
+	CHECK_EQUAL(2, twWheel.armedCount());
+	CHECK(twWheel.armed(1) == false);
+
+	// Re-arming replaces the deadline
+	twWheel.arm(0, 1000, 1500);
+	CHECK_EQUAL(2, twWheel.armedCount());
+	CHECK(twWheel.nextDeadline(1000, ulNext) == true);
+	CHECK_EQUAL(2500, ulNext);
+
+	CHECK_EQUAL(-1, twWheel.expired(2499));
+	CHECK_EQUAL(0, twWheel.expired(2500));
+	CHECK_EQUAL(-1, twWheel.expired(2999));
+	CHECK_EQUAL(3, twWheel.expired(3000));
+	CHECK_EQUAL(-1, twWheel.expired(3000));
+
+	// Cancelled timers never expire
+	twWheel.arm(4, 3000, 100);
+	twWheel.cancel(4);
+	CHECK_EQUAL(-1, twWheel.expired(10000));
+
+}
+
+static void testFullTurns()
+{
+
+	// Either side of one and two turns, so the same slot holds deadlines from different turns
+	const unsigned long aulDelay[] = { 100, 3990, 4000, 4010, 8250, 12345 };
+
+	checkExpiries(0, aulDelay, TIMER_COUNT, 13000);
+	checkExpiries(777, aulDelay, TIMER_COUNT, 13000);
+
+	// Timers more than a turn away are reported at the earliest deadline, so a host sleeps straight through to it
+	TestWheel twWheel;
+	unsigned long ulNext = 0;
+
+	twWheel.arm(0, 0, 300000);
+	twWheel.arm(1, 0, 9000);
+	CHECK(twWheel.nextDeadline(0, ulNext) == true);
+	CHECK_EQUAL(9000, ulNext);
+	CHECK_EQUAL(-1, twWheel.expired(8999));
+	CHECK_EQUAL(1, twWheel.expired(9000));
+	CHECK_EQUAL(-1, twWheel.expired(9000));
+	CHECK(twWheel.nextDeadline(9000, ulNext) == true);
+	CHECK_EQUAL(300000, ulNext);
+	CHECK_EQUAL(-1, twWheel.expired(299999));
+	CHECK_EQUAL(0, twWheel.expired(300000));
+
+}
+
+static void testCatchUp()
+{
+
+	TestWheel twWheel;
+	bool abExpired[TIMER_COUNT] = { false };
+
+	twWheel.arm(0, 0, 500);
+	twWheel.arm(1, 0, 3000);
+	twWheel.arm(2, 0, 20000);
+	twWheel.arm(3, 0, 60000);
+
+	// No calls for several turns - everything overdue comes out at once, in any order
+	int iTimer;
+	int iCount = 0;
+
+	while ((iTimer = twWheel.expired(25000)) != -1)
+	{
+		abExpired[iTimer] = true;
+		iCount++;
+	}
+
+	CHECK_EQUAL(3, iCount);
+	CHECK(abExpired[0] && abExpired[1] && abExpired[2]);
+	CHECK(twWheel.armed(3) == true);
+
+	// Cursor has caught up, so the remaining timer is still on time
+	CHECK_EQUAL(-1, twWheel.expired(59990));
+	CHECK_EQUAL(3, twWheel.expired(60000));
+
+	// Idle wheel re-anchors on the next arm, however long it was left
+	twWheel.arm(4, 1000000, 250);
+	CHECK_EQUAL(-1, twWheel.expired(1000249));
+	CHECK_EQUAL(4, twWheel.expired(1000250));
+
+}
+
+static void testRollover()
+{
+
+	// millis() wraps to 0 part way through
+	const unsigned long aulDelay[] = { 100, 1000, 1001, 4000, 6000, 9000 };
+	unsigned long ulStart = (unsigned long)0 - 1000UL;
+
+	checkExpiries(ulStart, aulDelay, TIMER_COUNT, 10000);
+	checkExpiries((unsigned long)0 - 4000UL, aulDelay, TIMER_COUNT, 10000);
+
+	// Reported deadline wraps as well
+	TestWheel twWheel;
+	unsigned long ulNext = 0;
+
+	twWheel.arm(0, ulStart, 1500);
+	CHECK(twWheel.nextDeadline(ulStart, ulNext) == true);
+	CHECK_EQUAL(500, ulNext);
+	CHECK_EQUAL(-1, twWheel.expired(499));
+	CHECK_EQUAL(0, twWheel.expired(500));
+
+}
+
+int main()
+{
+
+	testArmCancel();
+	testFullTurns();
+	testCatchUp();
+	testRollover();
+
+	return hostTestResult("timer_wheel_test");
+
+}
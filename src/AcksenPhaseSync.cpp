@@ -0,0 +1,416 @@
+/*!
+@file AcksenPhaseSync.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPhaseSync.h"
+
+AcksenPhaseSync *AcksenPhaseSync::_pInstances[PHASE_SYNC_MAX_INSTANCES] = { NULL, NULL };
+
+AcksenPhaseSync::AcksenPhaseSync(int iPhaseSyncInputPin)
+{
+	this->_iPhaseSyncInputPin = iPhaseSyncInputPin;
+}
+
+bool AcksenPhaseSync::begin(void)
+{
+
+	// Set Phase Sync as Input
+	AcksenHal::setPinMode(this->_iPhaseSyncInputPin, INPUT);
+
+	int iInterrupt = AcksenHal::pinInterrupt(this->_iPhaseSyncInputPin);
+
+	if (iInterrupt < 0)
+	{
+		// Pin has no external interrupt
+		return false;
+	}
+
+	// Find a free ISR slot
+	for (int iSlot = 0; iSlot < PHASE_SYNC_MAX_INSTANCES; iSlot++)
+	{
+
+		if ((_pInstances[iSlot] == NULL) || (_pInstances[iSlot] == this))
+		{
+
+			_pInstances[iSlot] = this;
+			this->_iInstanceSlot = iSlot;
+
+			AcksenHal::attachPinInterrupt(iInterrupt, (iSlot == 0) ? isrInstance0 : isrInstance1, RISING);
+
+			return true;
+
+		}
+
+	}
+
+	return false;
+
+}
+
+void AcksenPhaseSync::end(void)
+{
+
+	if (this->_iInstanceSlot == -1)
+	{
+		return;
+	}
+
+	AcksenHal::detachPinInterrupt(AcksenHal::pinInterrupt(this->_iPhaseSyncInputPin));
+
+	_pInstances[this->_iInstanceSlot] = NULL;
+	this->_iInstanceSlot = -1;
+
+}
+
+void PHASE_SYNC_ISR_ATTR AcksenPhaseSync::isrInstance0(void)
+{
+	_pInstances[0]->handleEdge();
+}
+
+void PHASE_SYNC_ISR_ATTR AcksenPhaseSync::isrInstance1(void)
+{
+	_pInstances[1]->handleEdge();
+}
+
+void PHASE_SYNC_ISR_ATTR AcksenPhaseSync::handleEdge(void)
+{
+
+	unsigned long ulEdgeMicros = AcksenHal::timeMicros();
+
+	if (this->_bEdgeCaptured == false)
+	{
+		// First edge - nothing to measure against yet
+		this->_bEdgeCaptured = true;
+		this->_ulLastEdgeMicros = ulEdgeMicros;
+		return;
+	}
+
+	unsigned long ulInterval = (uint32_t)(ulEdgeMicros - this->_ulLastEdgeMicros);
+
+	if (ulInterval < PHASE_SYNC_PERIOD_MIN)
+	{
+		// Noise or contact bounce - ignore, and keep the previous edge as reference
+		return;
+	}
+
+	this->_ulLastEdgeMicros = ulEdgeMicros;
+
+	// Let any listeners act on this edge first, while closest to the Zero Crossing
+	for (uint8_t i = 0; i < PHASE_SYNC_MAX_LISTENERS; i++)
+	{
+
+		if (this->_pfListeners[i] != NULL)
+		{
+			(*this->_pfListeners[i])(this->_pListenerContexts[i]);
+		}
+
+	}
+
+	if (ulInterval > PHASE_SYNC_PERIOD_MAX)
+	{
+
+		if (this->_ulPeriodMicros == 0)
+		{
+			// Can't tell how many edges were missed without an estimate - restart measurement from this edge
+			return;
+		}
+
+		// One or more edges were missed - work out how many, and recover the single period interval
+		unsigned long ulCycles = (ulInterval + (this->_ulPeriodMicros / 2)) / this->_ulPeriodMicros;
+
+		if (ulCycles < 2)
+		{
+			return;
+		}
+
+		this->_ulMissedEdges += (ulCycles - 1);
+		ulInterval /= ulCycles;
+
+		if ((ulInterval < PHASE_SYNC_PERIOD_MIN) || (ulInterval > PHASE_SYNC_PERIOD_MAX))
+		{
+			return;
+		}
+
+	}
+
+	if (this->_ulPeriodMicros == 0)
+	{
+		// Seed the filter
+		this->_ulPeriodMicros = ulInterval;
+	}
+	else
+	{
+
+		// Update the period and jitter estimates
+		long lError = (long)ulInterval - (long)this->_ulPeriodMicros;
+		unsigned long ulAbsError = (lError < 0) ? -lError : lError;
+
+		this->_ulPeriodMicros += (lError >> PHASE_SYNC_FILTER_SHIFT);
+		this->_ulJitterMicros += ((long)ulAbsError - (long)this->_ulJitterMicros) >> PHASE_SYNC_FILTER_SHIFT;
+
+	}
+
+	if (this->_uiValidEdges < PHASE_SYNC_LOCK_EDGES)
+	{
+		this->_uiValidEdges++;
+	}
+
+}
+
+bool AcksenPhaseSync::locked(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulLastEdgeMicros = this->_ulLastEdgeMicros;
+	unsigned long ulPeriodMicros = this->_ulPeriodMicros;
+	unsigned int uiValidEdges = this->_uiValidEdges;
+	AcksenHal::restoreInterrupts(isState);
+
+	if (uiValidEdges < PHASE_SYNC_LOCK_EDGES)
+	{
+		return false;
+	}
+
+	// Lose lock if edges have stopped arriving
+	return ((uint32_t)(AcksenHal::timeMicros() - ulLastEdgeMicros) < (4 * ulPeriodMicros));
+
+}
+
+unsigned long AcksenPhaseSync::periodMicros(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulPeriodMicros = this->_ulPeriodMicros;
+	AcksenHal::restoreInterrupts(isState);
+
+	return ulPeriodMicros;
+
+}
+
+unsigned int AcksenPhaseSync::frequencyCentiHz(void)
+{
+
+	unsigned long ulPeriodMicros = periodMicros();
+
+	if (ulPeriodMicros == 0)
+	{
+		return 0;
+	}
+
+	return (unsigned int)((100000000UL + (ulPeriodMicros / 2)) / ulPeriodMicros);
+
+}
+
+int AcksenPhaseSync::mainsFrequency(void)
+{
+
+	if (locked() == false)
+	{
+		return 0;
+	}
+
+	// Nearest of the two nominal periods
+	return (periodMicros() < ((PHASE_SYNC_PERIOD_50HZ + PHASE_SYNC_PERIOD_60HZ) / 2)) ? 60 : 50;
+
+}
+
+unsigned long AcksenPhaseSync::jitterMicros(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulJitterMicros = this->_ulJitterMicros;
+	AcksenHal::restoreInterrupts(isState);
+
+	return ulJitterMicros;
+
+}
+
+unsigned long AcksenPhaseSync::missedEdges(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulMissedEdges = this->_ulMissedEdges;
+	AcksenHal::restoreInterrupts(isState);
+
+	return ulMissedEdges;
+
+}
+
+unsigned long AcksenPhaseSync::lastEdgeMicros(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulLastEdgeMicros = this->_ulLastEdgeMicros;
+	AcksenHal::restoreInterrupts(isState);
+
+	return ulLastEdgeMicros;
+
+}
+
+unsigned long AcksenPhaseSync::nextEdgeMicros(void)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulLastEdgeMicros = this->_ulLastEdgeMicros;
+	unsigned long ulPeriodMicros = this->_ulPeriodMicros;
+	AcksenHal::restoreInterrupts(isState);
+
+	if (ulPeriodMicros == 0)
+	{
+		return AcksenHal::timeMicros();
+	}
+
+	// Step forward whole periods from the last captured edge, to the first edge still in the future
+	unsigned long ulElapsed = (uint32_t)(AcksenHal::timeMicros() - ulLastEdgeMicros);
+	unsigned long ulCycles = (ulElapsed / ulPeriodMicros) + 1;
+
+	return ulLastEdgeMicros + (ulCycles * ulPeriodMicros);
+
+}
+
+bool AcksenPhaseSync::switchMicros(unsigned long ulDelayMicros, unsigned long &ulSwitchMicros)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulLastEdgeMicros = this->_ulLastEdgeMicros;
+	bool bEdgeCaptured = this->_bEdgeCaptured;
+	AcksenHal::restoreInterrupts(isState);
+
+	if ((bEdgeCaptured == true) && ((int32_t)((ulLastEdgeMicros + ulDelayMicros) - AcksenHal::timeMicros()) >= 0))
+	{
+		// Still within the delay after the last edge - join any other outputs switching on it
+		ulSwitchMicros = ulLastEdgeMicros + ulDelayMicros;
+		return true;
+	}
+
+	if (locked() == false)
+	{
+		return false;
+	}
+
+	ulSwitchMicros = nextEdgeMicros() + ulDelayMicros;
+	return true;
+
+}
+
+bool AcksenPhaseSync::switchDue(unsigned long ulDelayMicros, unsigned long &ulSwitchMicros)
+{
+
+	unsigned long ulTimeNow = AcksenHal::timeMicros();
+
+	if ((int32_t)(ulTimeNow - ulSwitchMicros) < 0)
+	{
+		return false;
+	}
+
+	if ((uint32_t)(ulTimeNow - ulSwitchMicros) <= (jitterMicros() + PHASE_SYNC_LATE_MARGIN_MICROS))
+	{
+		return true;
+	}
+
+	// Called too late - switch at the same point after the next edge, rather than wherever the mains cycle is now
+	if (switchMicros(ulDelayMicros, ulSwitchMicros) == false)
+	{
+		return true;
+	}
+
+	// Possibly a newer edge, whose switching time is now
+	return ((int32_t)(ulTimeNow - ulSwitchMicros) >= 0);
+
+}
+
+bool AcksenPhaseSync::edgeSince(unsigned long ulSinceMicros, unsigned long &ulEdgeMicros)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	unsigned long ulLastEdgeMicros = this->_ulLastEdgeMicros;
+	bool bEdgeCaptured = this->_bEdgeCaptured;
+	AcksenHal::restoreInterrupts(isState);
+
+	if ((bEdgeCaptured == false) || ((int32_t)(ulLastEdgeMicros - ulSinceMicros) <= 0))
+	{
+		return false;
+	}
+
+	ulEdgeMicros = ulLastEdgeMicros;
+	return true;
+
+}
+
+int AcksenPhaseSync::inputPin(void)
+{
+	return this->_iPhaseSyncInputPin;
+}
+
+bool AcksenPhaseSync::addEdgeListener(AcksenPhaseSyncListener pfListener, void *pContext)
+{
+
+	int iFreeSlot = -1;
+
+	for (int i = 0; i < PHASE_SYNC_MAX_LISTENERS; i++)
+	{
+
+		if ((this->_pfListeners[i] == pfListener) && (this->_pListenerContexts[i] == pContext))
+		{
+			// Already present
+			return true;
+		}
+
+		if ((this->_pfListeners[i] == NULL) && (iFreeSlot == -1))
+		{
+			iFreeSlot = i;
+		}
+
+	}
+
+	if (iFreeSlot == -1)
+	{
+		return false;
+	}
+
+	// Fill the slot while the ISR can't see it half written
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	this->_pListenerContexts[iFreeSlot] = pContext;
+	this->_pfListeners[iFreeSlot] = pfListener;
+	AcksenHal::restoreInterrupts(isState);
+
+	return true;
+
+}
+
+void AcksenPhaseSync::removeEdgeListener(AcksenPhaseSyncListener pfListener, void *pContext)
+{
+
+	for (int i = 0; i < PHASE_SYNC_MAX_LISTENERS; i++)
+	{
+
+		if ((this->_pfListeners[i] == pfListener) && (this->_pListenerContexts[i] == pContext))
+		{
+			AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+			this->_pfListeners[i] = NULL;
+			this->_pListenerContexts[i] = NULL;
+			AcksenHal::restoreInterrupts(isState);
+		}
+
+	}
+
+}
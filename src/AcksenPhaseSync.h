@@ -0,0 +1,260 @@
+/*!
+@file AcksenPhaseSync.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Interrupt-driven Voltage Phase Sync (Zero Crossing) capture, with mains period estimation and next edge prediction.
+//
+
+#ifndef AcksenPhaseSync_h
+#define AcksenPhaseSync_h
+
+#include "AcksenPumpHal.h"
+
+// *** PHASE SYNC CONSTANTS ***
+#define PHASE_SYNC_MAX_INSTANCES				2		///< Maximum number of AcksenPhaseSync instances that can be attached to interrupts using begin().
+#define PHASE_SYNC_MAX_LISTENERS				4		///< Maximum number of edge listeners per AcksenPhaseSync.
+
+#define PHASE_SYNC_PERIOD_50HZ					20000	///< Nominal mains period at 50Hz, in Microseconds.
+#define PHASE_SYNC_PERIOD_60HZ					16667	///< Nominal mains period at 60Hz, in Microseconds.
+#define PHASE_SYNC_PERIOD_MIN					14000	///< Shortest edge interval accepted as a mains period, in Microseconds.  Shorter intervals are treated as noise and ignored.
+#define PHASE_SYNC_PERIOD_MAX					24000	///< Longest edge interval accepted as a mains period, in Microseconds.  Longer intervals are treated as missed edges.
+
+#define PHASE_SYNC_FILTER_SHIFT					3		///< Period/jitter filter weight, as a power of 2 (each new edge contributes 1/8 of its error).
+#define PHASE_SYNC_LOCK_EDGES					8		///< Number of valid edges required before the period estimate is considered locked, and used for prediction.
+#define PHASE_SYNC_LATE_MARGIN_MICROS			500		///< How late a switch may be applied, on top of the measured jitter, before it is moved on to the next edge, in Microseconds.
+
+#if defined(ESP32) || defined(ESP8266)
+#define PHASE_SYNC_ISR_ATTR						IRAM_ATTR
+#else
+#define PHASE_SYNC_ISR_ATTR
+#endif
+
+typedef void (*AcksenPhaseSyncListener)(void *pContext);	///< Function called from the edge ISR, on every accepted edge.  Must be short, and ISR safe.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that captures Voltage Phase Sync input edges by interrupt, and predicts the next Zero Crossing
+*/
+/**************************************************************************/
+class AcksenPhaseSync
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @param  iPhaseSyncInputPin
+            The Arduino I/O pin assigned to the Voltage Phase Sync Output.  Must support external interrupts to use begin().
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPhaseSync(int iPhaseSyncInputPin);
+
+/**************************************************************************/
+/*!
+    @brief  Configure the Phase Sync input pin, and attach the rising edge interrupt.
+    @return Returns true if the interrupt was attached.
+			Returns false if the pin does not support interrupts, or PHASE_SYNC_MAX_INSTANCES are already in use.  handleEdge() can still be called from a user supplied ISR in this case.
+*/
+/**************************************************************************/
+	bool begin();
+
+/**************************************************************************/
+/*!
+    @brief  Detach the Phase Sync interrupt.
+    @return No return value.
+*/
+/**************************************************************************/
+	void end();
+
+/**************************************************************************/
+/*!
+    @brief  Record a rising edge on the Phase Sync input.  Called from the interrupt attached by begin(), or from a user supplied ISR.
+    @return No return value.
+*/
+/**************************************************************************/
+	void PHASE_SYNC_ISR_ATTR handleEdge();
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if enough edges have been captured for the period estimate and prediction to be used.
+    @return Returns true if locked to the mains supply.
+			Returns false if not yet locked, or edges have stopped arriving.
+*/
+/**************************************************************************/
+	bool locked();
+
+/**************************************************************************/
+/*!
+    @brief  Get the filtered mains period estimate.
+    @return Mains period in Microseconds, or 0 if no estimate is available.
+*/
+/**************************************************************************/
+	unsigned long periodMicros();
+
+/**************************************************************************/
+/*!
+    @brief  Get the measured mains frequency.
+    @return Mains frequency in hundredths of a Hz (e.g. 5000 for 50.00Hz), or 0 if no estimate is available.
+*/
+/**************************************************************************/
+	unsigned int frequencyCentiHz();
+
+/**************************************************************************/
+/*!
+    @brief  Get the auto-detected nominal mains frequency.
+    @return 50 or 60 (Hz), or 0 if not yet locked.
+*/
+/**************************************************************************/
+	int mainsFrequency();
+
+/**************************************************************************/
+/*!
+    @brief  Get the filtered edge timing jitter (mean absolute deviation from the period estimate).
+    @return Jitter in Microseconds.
+*/
+/**************************************************************************/
+	unsigned long jitterMicros();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of edges that were expected, but not captured.
+    @return Missed edge count since begin().
+*/
+/**************************************************************************/
+	unsigned long missedEdges();
+
+/**************************************************************************/
+/*!
+    @brief  Get the timestamp of the most recently captured edge.
+    @return micros() timestamp of the last edge.
+*/
+/**************************************************************************/
+	unsigned long lastEdgeMicros();
+
+/**************************************************************************/
+/*!
+    @brief  Predict the timestamp of the next rising edge, based on the last captured edge and the period estimate.
+    @return micros() timestamp of the next predicted edge.  Only valid when locked() returns true.
+*/
+/**************************************************************************/
+	unsigned long nextEdgeMicros();
+
+/**************************************************************************/
+/*!
+    @brief  Get the time to switch an output requested now.  A request made before the last edge's pre-activation delay has elapsed shares that edge,
+			so any number of pumps switching in the same half-cycle cost one Zero Crossing wait, each still applying its own delay.
+    @param  ulDelayMicros
+            Pre-activation delay after the Zero Crossing, in Microseconds.
+    @param  ulSwitchMicros
+            Receives the micros() time to switch at.
+    @return Returns true if the switching time is known.
+			Returns false if not locked, and the last edge is too old to share - wait for the next one using edgeSince().
+*/
+/**************************************************************************/
+	bool switchMicros(unsigned long ulDelayMicros, unsigned long &ulSwitchMicros);
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a switch scheduled by switchMicros() is due.  A caller more than jitterMicros() plus PHASE_SYNC_LATE_MARGIN_MICROS past the
+			switching time has missed that point in the mains cycle, so the switch is moved on to the same point after the next edge.
+    @param  ulDelayMicros
+            Pre-activation delay after the Zero Crossing, in Microseconds, as passed to switchMicros().
+    @param  ulSwitchMicros
+            micros() time to switch at.  Updated if the switch is moved on to the next edge.
+    @return Returns true if the output should be switched now, including when too late but the next edge can't be predicted (not locked).
+			Returns false if the switching time is still to come.
+*/
+/**************************************************************************/
+	bool switchDue(unsigned long ulDelayMicros, unsigned long &ulSwitchMicros);
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if an edge has been captured since a given time.  Every caller waiting from before an edge sees the same edge.
+    @param  ulSinceMicros
+            micros() time to check from, e.g. when a transition was requested.
+    @param  ulEdgeMicros
+            Receives the micros() timestamp of the edge.
+    @return Returns true if an edge has been captured since ulSinceMicros.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool edgeSince(unsigned long ulSinceMicros, unsigned long &ulEdgeMicros);
+
+/**************************************************************************/
+/*!
+    @brief  Get the Arduino I/O pin assigned to the Phase Sync input.
+    @return I/O pin number.
+*/
+/**************************************************************************/
+	int inputPin();
+
+/**************************************************************************/
+/*!
+    @brief  Add a function to be called from the edge ISR, on every accepted edge (e.g. for burst-fire output control).
+    @param  pfListener
+            Function to call.  Must be short, and ISR safe.
+    @param  pContext
+            Pointer passed to the function.
+    @return Returns true if the listener was added, or was already present.
+			Returns false if PHASE_SYNC_MAX_LISTENERS are already in use.
+*/
+/**************************************************************************/
+	bool addEdgeListener(AcksenPhaseSyncListener pfListener, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Remove a function added with addEdgeListener().
+    @param  pfListener
+            Function to remove.
+    @param  pContext
+            Pointer it was added with.
+    @return No return value.
+*/
+/**************************************************************************/
+	void removeEdgeListener(AcksenPhaseSyncListener pfListener, void *pContext);
+
+protected:
+
+	int _iPhaseSyncInputPin;
+	int _iInstanceSlot = -1;
+
+	volatile unsigned long _ulLastEdgeMicros = 0;
+	volatile unsigned long _ulPeriodMicros = 0;
+	volatile unsigned long _ulJitterMicros = 0;
+	volatile unsigned long _ulMissedEdges = 0;
+	volatile unsigned int _uiValidEdges = 0;
+	volatile bool _bEdgeCaptured = false;
+
+	AcksenPhaseSyncListener _pfListeners[PHASE_SYNC_MAX_LISTENERS] = { NULL };
+	void *_pListenerContexts[PHASE_SYNC_MAX_LISTENERS] = { NULL };
+
+	static AcksenPhaseSync *_pInstances[PHASE_SYNC_MAX_INSTANCES];
+
+	static void PHASE_SYNC_ISR_ATTR isrInstance0();
+	static void PHASE_SYNC_ISR_ATTR isrInstance1();
+
+};
+
+#endif
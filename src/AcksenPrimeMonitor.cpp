@@ -0,0 +1,210 @@
+/*!
+@file AcksenPrimeMonitor.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPrimeMonitor.h"
+
+AcksenPrimeMonitor::AcksenPrimeMonitor()
+{
+}
+
+void AcksenPrimeMonitor::addPulses(uint16_t uiPulses)
+{
+
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	this->_uiPulses += uiPulses;
+	AcksenHal::restoreInterrupts(isState);
+
+}
+
+void AcksenPrimeMonitor::updateCurrent(uint16_t uiCurrent)
+{
+
+	// Held for update(), which knows whether the Pump Output is ON
+	this->_uiLastCurrent = uiCurrent;
+	this->_bCurrentUpdated = true;
+
+}
+
+void AcksenPrimeMonitor::begin(unsigned long ulTimeNow, unsigned long ulFixedVentMillis)
+{
+
+	this->_ulVentStartMillis = ulTimeNow;
+	this->_ulFixedVentMillis = ulFixedVentMillis;
+	this->_ulSampleStartMillis = ulTimeNow;
+
+	this->_bMeasuring = true;
+	this->_bInWindow = false;
+	this->_bPrimed = false;
+	this->_bFlowSeen = false;
+	this->_bCurrentUpdated = false;
+	this->_ui8ExtraCycles = 0;
+
+	// Discard pulses from before this Ventilation
+	AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+	this->_uiPulses = 0;
+	AcksenHal::restoreInterrupts(isState);
+
+}
+
+bool AcksenPrimeMonitor::update(bool bOutputOn, unsigned long ulTimeNow)
+{
+
+	if (this->_bMeasuring == false)
+	{
+		return this->_bPrimed;
+	}
+
+	if (bOutputOn == false)
+	{
+
+		// No flow expected while OFF - start again on the next ON pulse, with a reading taken while ON
+		this->_bInWindow = false;
+		this->_bCurrentUpdated = false;
+
+		if (this->ui8Source == PRIME_SOURCE_FLOW_PULSES)
+		{
+			AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+			this->_uiPulses = 0;
+			AcksenHal::restoreInterrupts(isState);
+			this->_ulSampleStartMillis = ulTimeNow;
+		}
+
+		return false;
+
+	}
+
+	if (this->ui8Source == PRIME_SOURCE_FLOW_PULSES)
+	{
+
+		if ((uint32_t)(ulTimeNow - this->_ulSampleStartMillis) < this->uiSamplePeriod)
+		{
+			// Still counting
+			return false;
+		}
+
+		AcksenHal::InterruptState isState = AcksenHal::saveInterrupts();
+		uint16_t uiPulses = this->_uiPulses;
+		this->_uiPulses = 0;
+		AcksenHal::restoreInterrupts(isState);
+
+		this->_ulSampleStartMillis = ulTimeNow;
+		sample(uiPulses, ulTimeNow);
+
+	}
+	else
+	{
+
+		if (this->_bCurrentUpdated == false)
+		{
+			// No new reading since the last sample - only a fresh reading can show the flow stayed steady
+			return false;
+		}
+
+		this->_bCurrentUpdated = false;
+		sample(this->_uiLastCurrent, ulTimeNow);
+
+	}
+
+	if ((this->_bInWindow == true) && ((uint32_t)(ulTimeNow - this->_ulWindowStartMillis) >= this->uiStableWindow))
+	{
+
+		// Primed - record how long it took, and what it saved
+		this->_bPrimed = true;
+		this->_bMeasuring = false;
+		this->_uiPrimeCount++;
+
+		this->_ulTimeToFullFlow = (uint32_t)(ulTimeNow - this->_ulVentStartMillis);
+		this->_ulTimeSaved = (this->_ulFixedVentMillis > this->_ulTimeToFullFlow) ? (this->_ulFixedVentMillis - this->_ulTimeToFullFlow) : 0;
+
+	}
+
+	return this->_bPrimed;
+
+}
+
+void AcksenPrimeMonitor::sample(uint16_t uiSample, unsigned long ulTimeNow)
+{
+
+	if (uiSample < this->uiPrimedLevel)
+	{
+		// Not flowing (air in the pump head, or dry)
+		this->_bInWindow = false;
+		return;
+	}
+
+	this->_bFlowSeen = true;
+
+	// Steady if within ui8Tolerance percent of the sample the window started with
+	uint16_t uiDifference = (uiSample > this->_uiWindowReference) ? (uiSample - this->_uiWindowReference) : (this->_uiWindowReference - uiSample);
+
+	if ((this->_bInWindow == false) || (((uint32_t)uiDifference * 100UL) > ((uint32_t)this->_uiWindowReference * this->ui8Tolerance)))
+	{
+		// Start a new window from here
+		this->_bInWindow = true;
+		this->_ulWindowStartMillis = ulTimeNow;
+		this->_uiWindowReference = uiSample;
+	}
+
+}
+
+bool AcksenPrimeMonitor::extendCycle()
+{
+
+	if (this->_ui8ExtraCycles >= this->ui8MaxExtraCycles)
+	{
+		return false;
+	}
+
+	this->_ui8ExtraCycles++;
+
+	return true;
+
+}
+
+bool AcksenPrimeMonitor::recordDryRun()
+{
+
+	this->_bMeasuring = false;
+	this->_uiDryRunCount++;
+
+	return this->_bFlowSeen;
+
+}
+
+unsigned long AcksenPrimeMonitor::nextSampleMillis(unsigned long ulTimeNow)
+{
+
+	if (this->ui8Source == PRIME_SOURCE_FLOW_PULSES)
+	{
+		return this->_ulSampleStartMillis + this->uiSamplePeriod;
+	}
+
+	// Readings arrive from the calling software - look again once the window could have completed, or after a sample period
+	if ((this->_bInWindow == true) && ((int32_t)((this->_ulWindowStartMillis + this->uiStableWindow) - ulTimeNow) > 0))
+	{
+		return this->_ulWindowStartMillis + this->uiStableWindow;
+	}
+
+	return ulTimeNow + this->uiSamplePeriod;
+
+}
@@ -0,0 +1,233 @@
+/*!
+@file AcksenPrimeMonitor.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Priming monitor for sensor-driven adaptive Pump Ventilation.  Watches flow meter pulses or pump current samples while venting,
+// so Ventilation can end as soon as flow is stable, be extended while an air lock persists, and stop the Pump if it never primes.
+//
+
+#ifndef AcksenPrimeMonitor_h
+#define AcksenPrimeMonitor_h
+
+#include "AcksenPumpHal.h"
+
+// *** PRIME MONITOR CONSTANTS ***
+#define PRIME_STABLE_WINDOW_DEFAULT				2000	///< Time flow (or current) must stay steady to count as primed, in Milliseconds.  Should be shorter than the Ventilation ON length.
+#define PRIME_SAMPLE_PERIOD_DEFAULT				250		///< Flow meter pulses are counted over this period to make each sample, in Milliseconds.
+#define PRIME_LEVEL_DEFAULT						1		///< Lowest sample counted as flowing - pulses per sample period, or current sample units.
+#define PRIME_TOLERANCE_DEFAULT					15		///< Largest change from the start of the window still counted as steady, in Percent.
+#define PRIME_MAX_EXTRA_CYCLES_DEFAULT			3		///< Most Ventilation Cycles added while an air lock persists.
+
+// Sources
+#define PRIME_SOURCE_FLOW_PULSES				0		///< Samples are flow meter pulses, counted with countPulse() or addPulses().
+#define PRIME_SOURCE_CURRENT					1		///< Samples are pump current readings, given to updateCurrent().
+
+/**************************************************************************/
+/*! 
+    @brief  Class that decides when a venting Pump is primed.  Attach with AcksenPump::attachPrimeMonitor().
+			Primed means the sample has stayed at or above uiPrimedLevel, and within ui8Tolerance percent of where it started, for uiStableWindow with the Pump Output ON.
+*/
+/**************************************************************************/
+class AcksenPrimeMonitor
+{
+
+public:
+
+	uint8_t ui8Source = PRIME_SOURCE_FLOW_PULSES;					///< PRIME_SOURCE_FLOW_PULSES or PRIME_SOURCE_CURRENT.
+	uint16_t uiStableWindow = PRIME_STABLE_WINDOW_DEFAULT;			///< Time the sample must stay steady, in Milliseconds.
+	uint16_t uiSamplePeriod = PRIME_SAMPLE_PERIOD_DEFAULT;			///< Flow meter pulse counting period, in Milliseconds.
+	uint16_t uiPrimedLevel = PRIME_LEVEL_DEFAULT;					///< Lowest sample counted as flowing.
+	uint8_t ui8Tolerance = PRIME_TOLERANCE_DEFAULT;					///< Largest steady change, in Percent.
+	uint8_t ui8MaxExtraCycles = PRIME_MAX_EXTRA_CYCLES_DEFAULT;		///< Most Ventilation Cycles added while an air lock persists.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPrimeMonitor();
+
+/**************************************************************************/
+/*!
+    @brief  Count one flow meter pulse.  Safe to call from the flow meter pin interrupt.
+    @return No return value.
+*/
+/**************************************************************************/
+	void countPulse() { this->_uiPulses++; }
+
+/**************************************************************************/
+/*!
+    @brief  Add flow meter pulses counted elsewhere (e.g. by a hardware counter).
+    @param  uiPulses
+            Pulses since the last call.
+    @return No return value.
+*/
+/**************************************************************************/
+	void addPulses(uint16_t uiPulses);
+
+/**************************************************************************/
+/*!
+    @brief  Give a pump current reading, when using PRIME_SOURCE_CURRENT.  Each reading is sampled once, by the next update() with the Pump Output ON, so the steady window only completes on a reading taken at its end.
+    @param  uiCurrent
+            Current reading, in any unit shared with uiPrimedLevel (e.g. raw ADC counts, or mA).
+    @return No return value.
+*/
+/**************************************************************************/
+	void updateCurrent(uint16_t uiCurrent);
+
+/**************************************************************************/
+/*!
+    @brief  Start watching a new Pump Ventilation.  Called by AcksenPump when Ventilation starts.
+    @param  ulTimeNow
+            Present millis() time.
+    @param  ulFixedVentMillis
+            Length of the full fixed Ventilation, in Milliseconds, for timeSaved().
+    @return No return value.
+*/
+/**************************************************************************/
+	void begin(unsigned long ulTimeNow, unsigned long ulFixedVentMillis);
+
+/**************************************************************************/
+/*!
+    @brief  Re-evaluate priming.  Called by AcksenPump each pass while venting.
+    @param  bOutputOn
+            True if the Pump Output is presently ON.  The steady window restarts whenever it is OFF.
+    @param  ulTimeNow
+            Present millis() time.
+    @return Returns true if the Pump is primed.
+*/
+/**************************************************************************/
+	bool update(bool bOutputOn, unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Ask for one more Ventilation Cycle, as the Pump has not primed.  Called by AcksenPump when the Ventilation Cycles run out.
+    @return Returns true if a cycle was added.
+			Returns false if ui8MaxExtraCycles have already been added.
+*/
+/**************************************************************************/
+	bool extendCycle();
+
+/**************************************************************************/
+/*!
+    @brief  Record that Ventilation ended without the Pump priming.  Called by AcksenPump before it stops for a dry run.
+    @return Returns true if any flow was seen (an air lock that never cleared), false if none (running dry).
+*/
+/**************************************************************************/
+	bool recordDryRun();
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if the present Ventilation is still being watched.
+    @return Returns true between begin() and priming, or a dry run.
+*/
+/**************************************************************************/
+	bool measuring() { return this->_bMeasuring; }
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if the Pump primed during the present (or last) Ventilation.
+    @return Returns true if primed.
+*/
+/**************************************************************************/
+	bool primed() { return this->_bPrimed; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the time at which update() next needs to be called, while measuring.
+    @param  ulTimeNow
+            Present millis() time.
+    @return millis() time of the next flow sample, or of the end of the steady window.
+*/
+/**************************************************************************/
+	unsigned long nextSampleMillis(unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Get the Ventilation Cycles added to the present (or last) Ventilation.
+    @return Extra cycle count.
+*/
+/**************************************************************************/
+	uint8_t extraCycles() { return this->_ui8ExtraCycles; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the time from the start of the last primed Ventilation to full flow.
+    @return Time to full flow, in Milliseconds.  0 if the Pump has not yet primed.
+*/
+/**************************************************************************/
+	unsigned long timeToFullFlow() { return this->_ulTimeToFullFlow; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the restart time saved by the last primed Ventilation, against running the full fixed Ventilation.
+    @return Time saved, in Milliseconds.  0 if none (e.g. cycles were added).
+*/
+/**************************************************************************/
+	unsigned long timeSaved() { return this->_ulTimeSaved; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of Ventilations that primed.
+    @return Prime count.
+*/
+/**************************************************************************/
+	uint16_t primeCount() { return this->_uiPrimeCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of Ventilations that ended in a dry run.
+    @return Dry run count.
+*/
+/**************************************************************************/
+	uint16_t dryRunCount() { return this->_uiDryRunCount; }
+
+protected:
+
+	volatile uint16_t _uiPulses = 0;		// Counted by the flow meter interrupt
+
+	unsigned long _ulVentStartMillis = 0;
+	unsigned long _ulFixedVentMillis = 0;
+	unsigned long _ulSampleStartMillis = 0;	// Start of the present flow pulse counting period
+	unsigned long _ulWindowStartMillis = 0;	// Start of the present steady window
+	uint16_t _uiWindowReference = 0;		// Sample at the start of the steady window
+	uint16_t _uiLastCurrent = 0;
+	bool _bCurrentUpdated = false;			// _uiLastCurrent not yet sampled
+
+	bool _bMeasuring = false;
+	bool _bInWindow = false;
+	bool _bPrimed = false;
+	bool _bFlowSeen = false;
+	uint8_t _ui8ExtraCycles = 0;
+
+	unsigned long _ulTimeToFullFlow = 0;
+	unsigned long _ulTimeSaved = 0;
+	uint16_t _uiPrimeCount = 0;
+	uint16_t _uiDryRunCount = 0;
+
+	void sample(uint16_t uiSample, unsigned long ulTimeNow);
+
+};
+
+#endif
@@ -41,28 +41,71 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 */
 /***********************************************************/
 
-// Acksen Pump Library v1.8.1
+// Acksen Pump Library v1.9.0
 
-#include "Arduino.h"
 #include "AcksenPump.h"
 
+#include <string.h>
+
+// Keep per-instance RAM within budget, so several pumps fit alongside application code on 2KB parts.  The v1.8 public field layout, the attachments and
+// the millisecond Ventilation lengths don't fit.
+#if (ACKSEN_PUMP_LEGACY_FIELDS == 0) && (ACKSEN_PUMP_ATTACHMENTS == 0) && (ACKSEN_PUMP_VENT_MILLIS == 0)
+static_assert((sizeof(AcksenPump) - (ACKSEN_PUMP_PROFILING ? sizeof(AcksenPumpProfile) : 0)) <= PUMP_RAM_BUDGET, "AcksenPump exceeds PUMP_RAM_BUDGET");
+#endif
+
 AcksenPump::AcksenPump(int iPumpOutputPin, int iPhaseSyncInputPin)
 {
 	
-	this->_iPumpOutputPin = iPumpOutputPin;
-	this->_iPhaseSyncInputPin = iPhaseSyncInputPin;
+	// Bitfield defaults
+	this->iPumpOnState = PUMP_POSITIVE_LOGIC_ON;
+	this->iPumpOffState = PUMP_POSITIVE_LOGIC_OFF;
+	this->iOperatingMode = PUMP_OPERATING_MODE_OFF;
+	this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+	this->iOutputStateActual = PUMP_OUTPUT_STATE_OFF;
+	this->iControlState = PUMP_CONTROL_STOP;
+	
+	this->bEnablePumpVentilation = PUMP_VENTILATION_ENABLED_DEFAULT;
+	this->bEnableMaxPumpTemperature = ENABLE_MAX_PUMP_TEMP_DEFAULT;
+	this->bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = true;
+	this->bEnableGrainRest = ENABLE_GRAIN_REST_DEFAULT;
+	this->bEnableInhibitGrainRestAroundSetPoint = TEMPORARY_INHIBIT_GRAIN_REST_AROUND_SET_POINT_DEFAULT;
+	this->bEnablePhaseSync = PHASE_SYNC_ENABLED_DEFAULT;
+	this->bCurrentlyControllingMashing = false;
+	this->bNonBlockingSwitching = PUMP_NON_BLOCKING_SWITCHING_DEFAULT;
+	
+	this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+	this->_iPhaseSyncLastLevel = HIGH;
+	this->_bPhaseSyncEdgeSeen = false;
+	this->_bStateChangeOccurred = false;
+	this->_bProcessRequired = true;
+	this->_bGrainRestOverdue = false;
+	this->_iLastControlState = PUMP_CONTROL_STOP;
+	this->_iLastOperatingMode = PUMP_OPERATING_MODE_OFF;
+	this->_bLastRequestedOn = false;
+	this->_iSequence = PUMP_SEQUENCE_NONE;
+	
+	this->_ui8PumpOutputPin = (iPumpOutputPin < 0) ? PUMP_PIN_NONE : (uint8_t)iPumpOutputPin;
+	this->_ui8PhaseSyncInputPin = (iPhaseSyncInputPin < 0) ? PUMP_PIN_NONE : (uint8_t)iPhaseSyncInputPin;
 	
 	// Set as Output
-	pinMode(this->_iPumpOutputPin, OUTPUT);
+	AcksenHal::setPinMode(iPumpOutputPin, OUTPUT);
 	
 	// Set Phase Sync as Input
-	if (this->_iPhaseSyncInputPin != -1)
+	if (iPhaseSyncInputPin != -1)
 	{
-		pinMode(this->_iPhaseSyncInputPin, INPUT);
+		AcksenHal::setPinMode(iPhaseSyncInputPin, INPUT);
 	}
 	
+#if ACKSEN_PUMP_ATTACHMENTS
+	// Resolve the Pump Output once, for direct register access where supported
+	AcksenHal::resolveFastPin(this->_atAttachments.fpPumpOutput, iPumpOutputPin);
+#endif
+	
 	// Set Pump Off
-	digitalWrite(this->_iPumpOutputPin, iPumpOffState);
+	writeOutputLevel(this->iPumpOffState);
+	this->_iOutputLevel = this->iPumpOffState;
+	
+	resetProfile();
 	
 }
 
@@ -72,17 +115,41 @@ void AcksenPump::turnOff()
 	// Pump set to off, no Pump Vent;
 	this->iControlState = PUMP_CONTROL_STOP;
 	this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+	this->_iSequence = PUMP_SEQUENCE_NONE;
+
+	if (thermalGovernor() != NULL)
+	{
+		// Stay off, even if stopped while tripped
+		thermalGovernor()->cancelResume();
+	}
+
+	if (relayGuard() != NULL)
+	{
+		// Explicit stop - never deferred
+		relayGuard()->bypassNext();
+	}
 
 	// Pump Operating Mode OFF
 	this->iOperatingMode = PUMP_OPERATING_MODE_OFF;
 	
-	int iInitialPumpState = digitalRead(this->_iPumpOutputPin);
+	recordControlState();
+	
+	if (this->bNonBlockingSwitching == true)
+	{
+		// Queue the transition - the Phase Sync wait and relay settling will be completed by subsequent process() calls
+		processSwitching();
+		return;
+	}
+	
+	finishSwitching();
+	
+	int iInitialPumpState = this->_iOutputLevel;
 	
-	if (digitalRead(this->_iPumpOutputPin) == iPumpOnState)
+	if (this->_iOutputLevel == iPumpOnState)
 	{
 		// Deactivate Pump Output
 		waitForPhaseSync();
-		digitalWrite(this->_iPumpOutputPin, iPumpOffState);
+		writeOutput(iPumpOffState);
 	}
 	
 	this->iOutputStateActual = PUMP_OUTPUT_STATE_OFF;
@@ -90,7 +157,7 @@ void AcksenPump::turnOff()
 	// If the pump was on previously, apply the relay switching delay since we've just turned it off.
 	if (iInitialPumpState != iPumpOffState)
 	{
-		delay(iPumpRelaySwitchingDelay);
+		relaySwitchingDelay();
 
 		launchCallbackInitLCDs();
 	}
@@ -104,24 +171,23 @@ void AcksenPump::ToggleState()
 	{
 
 		// Check to see if the Pump Temperature has exceeded Maximum Levels
-		if ((this->bEnableMaxPumpTemperature == true) && (this->fPumpTemperature >= this->iMaxPumpTemperature))
+		if (overTemperature() == true)
 		{
 			// Ignore Pump Activation
 		}
 		else
 		{
 		
+			// Pump One Operating Mode ON
+			this->iOperatingMode = PUMP_OPERATING_MODE_ON;
+
 			if (this->bEnablePumpVentilation == true)
 			{
 				// Pump One set to ON, Pump Vent On
 				this->iControlState = PUMP_CONTROL_VENT;
-				this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
 
 				// Start Pump Ventilation Cycle
-				this->iVentilationCycleRuntimeCount = 0;
-				//dtSystemCycleStartTime = now();
-				//dtSystemCycleEndTime = dtSystemCycleStartTime + this->iPumpVentilationLength;
-
+				startSequence(PUMP_SEQUENCE_VENTILATION);
 			}
 			else
 			{
@@ -130,9 +196,6 @@ void AcksenPump::ToggleState()
 				this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
 			}
 
-			// Pump One Operating Mode ON
-			this->iOperatingMode = PUMP_OPERATING_MODE_ON;
-
 			// setup next Grain Rest timing (if required!)
 			this->resetGrainRest();
 
@@ -145,309 +208,1861 @@ void AcksenPump::ToggleState()
 		// Pump set to off, no Pump Vent
 		this->iControlState = PUMP_CONTROL_STOP;
 		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		this->_iSequence = PUMP_SEQUENCE_NONE;
 
 		// Pump Operating Mode OFF
 		this->iOperatingMode = PUMP_OPERATING_MODE_OFF;
 
+		if (thermalGovernor() != NULL)
+		{
+			thermalGovernor()->cancelResume();
+		}
+
 	}
 	
 }
 
-void AcksenPump::resetGrainRest()
+#if ACKSEN_PUMP_ATTACHMENTS
+void AcksenPump::runSequence(const AcksenPumpStep *pSequence)
 {
-	// Resetting Grain Rest
-	dtGrainRestPeriodStartTime = now() + (this->iGrainRestPeriod * 60);
-	dtGrainRestEndTime = now();	
+
+	// Check to see if the Pump Temperature has exceeded Maximum Levels
+	if ((overTemperature() == true) || (pSequence == NULL))
+	{
+		// Ignore Pump Activation
+		return;
+	}
+
+	this->iOperatingMode = PUMP_OPERATING_MODE_ON;
+	this->iControlState = PUMP_CONTROL_SEQUENCE;
+
+	this->_atAttachments.pSequence = pSequence;
+	startSequence(PUMP_SEQUENCE_CUSTOM);
+
 }
+#endif
 
-void AcksenPump::updatePumpTemperature(float fNewPumpTemperature)
+void AcksenPump::resetGrainRest()
 {
-	this->fPumpTemperature = fNewPumpTemperature;
+	// Resetting Grain Rest
+	this->_bProcessRequired = true;
+	this->_bGrainRestOverdue = false;
+	this->_ulGrainRestDueMillis = AcksenHal::timeMillis() + ((unsigned long)this->iGrainRestPeriod * 60000UL);
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	this->dtGrainRestPeriodStartTime = AcksenHal::wallClock() + (this->iGrainRestPeriod * 60);
+	this->dtGrainRestEndTime = AcksenHal::wallClock();
+#endif
 }
 
-bool AcksenPump::stateChangeOccurred()
+bool AcksenPump::grainRestPermitted()
 {
 
-	if (this->_bStateChangeOccurred == true)
-	{
-
-		// Reset Flag
-		this->_bStateChangeOccurred = false;
-
-		return true;
-	}
-	else
+	if ((this->bEnableGrainRest == false) || (this->bCurrentlyControllingMashing == false) ||
+		(this->iGrainRestLength == 0) || (this->iGrainRestPeriod == 0) || (this->iOperatingMode != PUMP_OPERATING_MODE_ON))
 	{
-
 		return false;
 	}
 
-}
+	// Held off while close to Set Point
+	return ((this->bEnableInhibitGrainRestAroundSetPoint == false) || (this->bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint == false));
 
+}
 
-void AcksenPump::process()
+void AcksenPump::processGrainRest(unsigned long ulTimeNow)
 {
-	
-	// Check to see if the Pump Temperature has exceeded Maximum Levels
-	if ((this->bEnableMaxPumpTemperature == true) && (this->fPumpTemperature >= this->iMaxPumpTemperature))
+
+	if ((this->_bGrainRestOverdue == false) && ((int32_t)(ulTimeNow - this->_ulGrainRestDueMillis) < 0))
 	{
-		// Ensure that the Pump is turned off!				
-		this->iControlState = PUMP_CONTROL_STOP;
-		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		return;
 	}
-	else
+
+	if ((this->iControlState != PUMP_CONTROL_ON) || (grainRestPermitted() == false))
 	{
+		// Overdue - start as soon as allowed.  Latched, so it stays rollover safe however long that takes.
+		this->_bGrainRestOverdue = true;
+		return;
+	}
 
-		// Pump Ventilation Control
-		if (this->iControlState == PUMP_CONTROL_VENT)
-		{
+	// Start the Grain Rest, and set up the next one
+	resetGrainRest();
+	this->iControlState = PUMP_CONTROL_GRAIN_REST;
 
-			// Pump Vent Control Loop
+}
 
-			// Initial Setup Condition
-			if ((this->iVentilationCycleRuntimeCount == 0) && (this->iOutputStateRequested == PUMP_OUTPUT_STATE_OFF))
-			{
+int16_t AcksenPumpCentidegrees(float fTemperature)
+{
 
-				// Set initial Pump Ventilation conditions
+	// Written so NaN fails both comparisons - a failed sensor must stop the Pump, not wrap round to a safe looking value
+	if (!((fTemperature > -327.67f) && (fTemperature < 327.67f)))
+	{
+		return PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES;
+	}
 
-				// Start another Pump Ventilation Cycle
-				this->dtVentStartTime = now();
-				this->dtVentEndTime = this->dtVentStartTime + this->iPumpVentilationOnLength;
+	long lCentidegrees = (long)(fTemperature * 100.0f);
 
-				this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+	if (lCentidegrees > 32767L)
+	{
+		lCentidegrees = 32767L;
+	}
+	else if (lCentidegrees < -32767L)
+	{
+		lCentidegrees = -32767L;
+	}
 
-			}
+	return (int16_t)lCentidegrees;
 
-			// Check to see if the present condition has elapsed
-			if (now() >= this->dtVentEndTime)
-			{
+}
 
-				// Pump Vent Cycle End Check
+int16_t AcksenPumpLimitCentidegrees(long lDegrees)
+{
 
-				if (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON)
-				{
-					// ON cycle completed
-					this->iVentilationCycleRuntimeCount++;
+	const long lMaxDegrees = PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES / 100;
 
-					// Turn Pump OFF
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+	if (lDegrees > lMaxDegrees)
+	{
+		lDegrees = lMaxDegrees;
+	}
+	else if (lDegrees < -lMaxDegrees)
+	{
+		lDegrees = -lMaxDegrees;
+	}
 
-					// Setup next cycle times
-					this->dtVentStartTime = now();
-					this->dtVentEndTime = this->dtVentStartTime + this->iPumpVentilationOffLength;
+	return (int16_t)(lDegrees * 100L);
 
-				}
-				else if (this->iOutputStateRequested == PUMP_OUTPUT_STATE_OFF)
-				{
-					// OFF cycle completed
+}
 
-					// Turn Pump ON
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+void AcksenPump::updatePumpTemperature(float fNewPumpTemperature)
+{
+	// Truncation keeps the Maximum Pump Temperature comparison exact for whole degree limits
+	updatePumpTemperatureCentidegrees(AcksenPumpCentidegrees(fNewPumpTemperature));
+}
 
-					// Setup next cycle times
-					this->dtVentStartTime = now();
-					this->dtVentEndTime = this->dtVentStartTime + this->iPumpVentilationOnLength;
+void AcksenPump::updatePumpTemperatureCentidegrees(int16_t iCentidegrees)
+{
 
-				}
+	this->_iPumpTemperatureCenti = iCentidegrees;
+	this->_bProcessRequired = true;
 
-			}
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	this->fPumpTemperature = pumpTemperature();
+	this->_fPumpTemperatureWritten = this->fPumpTemperature;
+#endif
 
-			// Check to see if the pump ventilation phase has ended
-			if (this->iVentilationCycleRuntimeCount > this->iPumpVentilationCycles)
-			{
-				// Ventilation Complete
-				// Terminate Pump Ventilation.
-				// Pump Operating Mode set to this->iOperatingMode
+	if (thermalGovernor() != NULL)
+	{
+		thermalGovernor()->update((iCentidegrees / 10), (AcksenPumpLimitCentidegrees(this->iMaxPumpTemperature) / 10), AcksenHal::timeMillis());
+	}
 
-				// Move to next pump control stage
-				if (this->iOperatingMode == PUMP_OPERATING_MODE_OFF)
-				{
-					// Moving to Stop Pump 
-					this->iControlState = PUMP_CONTROL_STOP;
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
-				}
-				else if (this->iOperatingMode == PUMP_OPERATING_MODE_ON)
-				{
-					// Moving to Start Pump
-					this->iControlState = PUMP_CONTROL_ON;
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
-				}
+}
 
-			}
+float AcksenPump::pumpTemperature()
+{
+	return ((float)this->_iPumpTemperatureCenti / 100.0f);
+}
 
-		}
+int16_t AcksenPump::pumpTemperatureCentidegrees()
+{
+	return this->_iPumpTemperatureCenti;
+}
 
-		// Pump Grain Rest Control
-		if ((this->iControlState == PUMP_CONTROL_GRAIN_REST) && (this->iOperatingMode == PUMP_OPERATING_MODE_ON) && (this->iGrainRestLength != 0))
-		{
+bool AcksenPump::overTemperature()
+{
 
-			// Grain Rest Period
+	if (this->bEnableMaxPumpTemperature == false)
+	{
+		return false;
+	}
 
-			// Ensure that the Pump is temporarily turned off
-			this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
-			this->iOutputStateActual = PUMP_OUTPUT_STATE_OFF;
+	// Immediate trip on the unfiltered reading
+	if (this->_iPumpTemperatureCenti >= AcksenPumpLimitCentidegrees(this->iMaxPumpTemperature))
+	{
+		return true;
+	}
 
-			// Check to see if the present condition has elapsed
-			if (now() >= this->dtGrainRestEndTime)
-			{
+	// Filtered, predictive check with resume hysteresis
+	return ((thermalGovernor() != NULL) && (thermalGovernor()->tripped() == true));
 
-				// Grain Rest Complete
-				// Terminate Grain Rest.
+}
 
-				if (this->iOperatingMode == PUMP_OPERATING_MODE_OFF)
-				{
-					// Now disable pump again
-					// Pump Off - no need to vent.
-					this->iControlState = PUMP_CONTROL_STOP;
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
-				}
-				else
-				{
-					// Activate Post-Rest Grain Bed
+unsigned long AcksenPump::nextEventMillis()
+{
 
-					// Initialise Mandatory Pump Vent
-					this->iControlState = PUMP_CONTROL_VENT;
-					this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+	unsigned long ulTimeNow = AcksenHal::timeMillis();
 
-					// Start Pump Ventilation Cycle
-					this->iVentilationCycleRuntimeCount = 0;
-				}
+	// Output transition in progress
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+	{
+		return ulTimeNow + settlingTimeRemaining();
+	}
 
-			}
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
+	{
 
+#if ACKSEN_PUMP_ATTACHMENTS
+		if (this->_atAttachments.bPhaseSyncPredicted == true)
+		{
+			// Wake at the predicted Zero Crossing
+			int32_t lMicrosRemaining = (int32_t)(this->_atAttachments.ulPhaseSyncMicros - AcksenHal::timeMicros());
+			return (lMicrosRemaining > 0) ? (ulTimeNow + ((unsigned long)lMicrosRemaining / 1000UL)) : ulTimeNow;
 		}
-		
-	}
+#endif
 
+		// Polling the Phase Sync input
+		return ulTimeNow;
 
-	// I/O Control Function
+	}
 
-	// Check to see if a change needs to be made
-	if (this->iOutputStateRequested != this->iOutputStateActual)
+	// Output change deferred by the Relay Guard
+	if ((relayGuard() != NULL) && (relayGuard()->deferred() == true) && (this->iOutputStateRequested != this->iOutputStateActual) &&
+		(this->_bProcessRequired == false) && (this->iControlState == this->_iLastControlState))
 	{
-		// Set State Change Occurred flag for use by calling software
-		this->_bStateChangeOccurred = true;
+		return relayGuard()->nextAllowedMillis();
 	}
 
-	// Match the Demand State!
-	if (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON)
+	// Start waiting in the shared supply queue
+	if ((supply() != NULL) && (supply()->waiting(this) == true) && (this->iOutputStateRequested != this->iOutputStateActual) &&
+		(this->_bProcessRequired == false) && (this->iControlState == this->_iLastControlState))
 	{
-	
-		if (digitalRead(this->_iPumpOutputPin) == iPumpOffState)
-		{
-			waitForPhaseSync();
+		return supply()->nextReleaseMillis(this, ulTimeNow);
+	}
 
-			// Pump ON
-			digitalWrite(this->_iPumpOutputPin, iPumpOnState);
-		}
-		
-		// If thrfe relay state is changing, incur a delay.
-		if (this->iOutputStateRequested != this->iOutputStateActual)
-		{
-			delay(iPumpRelaySwitchingDelay);
-			launchCallbackInitLCDs();
-		}
-			
-		this->iOutputStateActual = PUMP_OUTPUT_STATE_ON;
+	// Output change not yet applied, or Control State changed since the last pass
+	if ((this->iOutputStateRequested != this->iOutputStateActual) || (this->_bProcessRequired == true) || (this->iControlState != this->_iLastControlState))
+	{
+		return ulTimeNow;
 	}
-	else
+
+	// Priming samples, while venting
+	if ((this->_iSequence == PUMP_SEQUENCE_VENTILATION) && (primeMonitor() != NULL) && (primeMonitor()->measuring() == true))
 	{
-		if (digitalRead(this->_iPumpOutputPin) == iPumpOnState)
-		{
-			waitForPhaseSync();
-			
-			// Pump OFF
-			digitalWrite(this->_iPumpOutputPin, iPumpOffState);
-		}
-		
-		// If the relay state is changing, incur a delay.
-		if (this->iOutputStateRequested != this->iOutputStateActual)
+		unsigned long ulSampleMillis = primeMonitor()->nextSampleMillis(ulTimeNow);
+		return ((int32_t)(ulSampleMillis - this->_ulPhaseEndMillis) < 0) ? ulSampleMillis : this->_ulPhaseEndMillis;
+	}
+
+	// Sequence step end (Ventilation ON/OFF phase, Grain Rest, etc)
+	if (this->_iSequence != PUMP_SEQUENCE_NONE)
+	{
+
+		AcksenPumpStep stStep;
+		loadStep(stStep);
+
+		if (stStep.ui8Duration != PUMP_STEP_DURATION_UNTIL_EXIT)
 		{
-			delay(iPumpRelaySwitchingDelay);
-			launchCallbackInitLCDs();
+			return this->_ulPhaseEndMillis;
 		}
 
-		this->iOutputStateActual = PUMP_OUTPUT_STATE_OFF;
 	}
 
-}
+	// Next periodic Grain Rest
+	if ((this->iControlState == PUMP_CONTROL_ON) && (grainRestPermitted() == true) &&
+		((this->_bGrainRestOverdue == true) || ((int32_t)(this->_ulGrainRestDueMillis - (ulTimeNow + PUMP_NEXT_EVENT_IDLE_INTERVAL)) < 0)))
+	{
+		return ((this->_bGrainRestOverdue == false) && ((int32_t)(this->_ulGrainRestDueMillis - ulTimeNow) > 0)) ? this->_ulGrainRestDueMillis : ulTimeNow;
+	}
+
+	// Nothing scheduled
+	return ulTimeNow + PUMP_NEXT_EVENT_IDLE_INTERVAL;
 
-void AcksenPump::beginMashingControl(void)
-{
-	bCurrentlyControllingMashing = true;
 }
 
-void AcksenPump::endMashingControl(void)
+bool AcksenPump::stateChangeOccurred()
 {
-	bCurrentlyControllingMashing = false;
+
+	if (this->_bStateChangeOccurred == true)
+	{
+
+		// Reset Flag
+		this->_bStateChangeOccurred = false;
+
+		return true;
+	}
+	else
+	{
+
+		return false;
+	}
+
 }
 
-void AcksenPump::temporaryInhibitGrainRestAsAroundPreheatSetPoint(void)
+
+void AcksenPump::process()
 {
-	bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = true;
+
+#if ACKSEN_PUMP_PROFILING
+	unsigned long ulStartMicros = AcksenHal::timeMicros();
+
+	processPass();
+
+	recordProcessTime((uint32_t)(AcksenHal::timeMicros() - ulStartMicros));
+#else
+	processPass();
+#endif
+
 }
 
-void AcksenPump::temporaryPermitGrainRestAsAroundPreheatSetPoint(void)
+uint8_t AcksenPump::step(unsigned long &ulWakeMillis)
 {
-	bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = false;
+
+	// A task must never block - waits become yields
+	this->bNonBlockingSwitching = true;
+
+	process();
+
+	ulWakeMillis = nextEventMillis();
+
+	return yieldReason();
+
 }
 
-void AcksenPump::waitForPhaseSync(void)
+uint8_t AcksenPump::yieldReason()
 {
-	
-	if ((this->bEnablePhaseSync == false) || (this->_iPhaseSyncInputPin == -1))
+
+	// Checked in the same order as nextEventMillis()
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
 	{
-			// Phase Sync not setup or disabled - return immediately.
-			return;
+		return PUMP_YIELD_SETTLING;
 	}
-	
-	// Check to see if the phase input is negative before proceeding
-	if (digitalRead(this->_iPhaseSyncInputPin) == true)
+
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
 	{
-		// Have to wait until the phase input is negative!
-		waitForPin(this->_iPhaseSyncInputPin, false, 20);
+		return PUMP_YIELD_PHASE_SYNC;
 	}
-	
-	// Check to see if the rising edge trigger has been received
-	waitForPin(this->_iPhaseSyncInputPin, true, 20);
-	
-	// Apply additional delay before continuing to operate output relay
-	delay(this->iPhaseSyncPreActivationDelay);
-	
-	
-}
 
-// Wait for the given pin to become the given value. Returns true when
-// that happened, or false when timeout ms passed
-bool AcksenPump::waitForPin(uint8_t pin, uint8_t value, uint16_t timeout)
-{
-	unsigned long start = millis();
+	if ((this->_bProcessRequired == true) || (this->iControlState != this->_iLastControlState))
+	{
+		return PUMP_YIELD_READY;
+	}
 
-	while (true)
+	if (this->iOutputStateRequested != this->iOutputStateActual)
 	{
-		if (digitalRead(pin) == value)
+		if ((relayGuard() != NULL) && (relayGuard()->deferred() == true))
 		{
-			return true;
+			return PUMP_YIELD_RELAY_GUARD;
 		}
-		if (millis() - start > timeout)
+
+		return ((supply() != NULL) && (supply()->waiting(this) == true)) ? PUMP_YIELD_SUPPLY : PUMP_YIELD_READY;
+	}
+
+	if (this->_iSequence != PUMP_SEQUENCE_NONE)
+	{
+
+		AcksenPumpStep stStep;
+		loadStep(stStep);
+
+		if (stStep.ui8Duration != PUMP_STEP_DURATION_UNTIL_EXIT)
 		{
-			return false;
+			return PUMP_YIELD_SEQUENCE_STEP;
 		}
+
 	}
+
+	return PUMP_YIELD_IDLE;
+
 }
 
-void AcksenPump::switchPumpNegativeLogic(void)
+void AcksenPump::processPass()
 {
 
-	// Set Negative Logics for Pump
+	unsigned long ulTimeNow = AcksenHal::timeMillis();
 
-	// Allow the normal logic used to be inverted
-	this->iPumpOnState = PUMP_NEGATIVE_LOGIC_ON;
-	this->iPumpOffState = PUMP_NEGATIVE_LOGIC_OFF;
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	if (memcmp(&this->fPumpTemperature, &this->_fPumpTemperatureWritten, sizeof(float)) != 0)
+	{
+		// Written directly by the sketch, rather than through updatePumpTemperature().  Compared bitwise, as a float compare is a library call on AVR.
+		updatePumpTemperature(this->fPumpTemperature);
+	}
+#endif
 
-}
+#if ACKSEN_PUMP_ATTACHMENTS
+	// Hand the Pump Output to/from the Burst-Fire edge handler, as needed
+	if ((this->_atAttachments.ui8FlowPercent < PUMP_FLOW_PERCENT_FULL) || (this->_atAttachments.ui8BurstFlowPercent != PUMP_BURST_FIRE_INACTIVE))
+	{
+		updateBurstFire();
+	}
+#endif
+
+	// Fast path - return immediately if no deadline has expired, and no input has changed
+	if ((this->_bProcessRequired == false) &&
+		(this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED) &&
+		(this->iControlState == this->_iLastControlState) &&
+		(this->iOperatingMode == this->_iLastOperatingMode) &&
+		((this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) == this->_bLastRequestedOn) &&
+		(this->iOutputStateRequested == this->iOutputStateActual) &&
+		(deadlineExpired(ulTimeNow) == false) &&
+		(overTemperature() == false))
+	{
+		return;
+	}
+
+	this->_bProcessRequired = false;
+
+	updateControlState();
+	recordControlState();
+	updateOutput();
+
+	// Record the inputs this pass was based on
+	this->_iLastOperatingMode = this->iOperatingMode;
+	this->_bLastRequestedOn = (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON);
+
+}
+
+bool AcksenPump::deadlineExpired(unsigned long ulTimeNow)
+{
+
+	// Periodic Grain Rest due, or overdue and now allowed
+	if (this->_bGrainRestOverdue == true)
+	{
+		if ((this->iControlState == PUMP_CONTROL_ON) && (grainRestPermitted() == true))
+		{
+			return true;
+		}
+	}
+	else if ((int32_t)(ulTimeNow - this->_ulGrainRestDueMillis) >= 0)
+	{
+		return true;
+	}
+
+	if (this->_iSequence == PUMP_SEQUENCE_NONE)
+	{
+		return false;
+	}
+
+	// Priming sample due, while venting
+	if ((this->_iSequence == PUMP_SEQUENCE_VENTILATION) && (primeMonitor() != NULL) && (primeMonitor()->measuring() == true) &&
+		((int32_t)(ulTimeNow - primeMonitor()->nextSampleMillis(ulTimeNow)) >= 0))
+	{
+		return true;
+	}
+
+	// End of the Sequence step, or time to look at its exit condition again
+	return ((int32_t)(ulTimeNow - this->_ulPhaseEndMillis) >= 0);
+
+}
+
+void AcksenPump::updateControlState()
+{
+
+	unsigned long ulTimeNow = AcksenHal::timeMillis();
+	
+	// Check to see if the Pump Temperature has exceeded Maximum Levels
+	if (overTemperature() == true)
+	{
+
+		if (thermalGovernor() != NULL)
+		{
+			// Reached the limit before the filter caught up - hold off under the governor's hysteresis and resume delay, as for any other trip
+			thermalGovernor()->tripLimit(ulTimeNow);
+		}
+		
+		if (this->iControlState != PUMP_CONTROL_STOP)
+		{
+			raiseEvent(PUMP_EVENT_OVER_TEMPERATURE, this->iControlState);
+
+			if (thermalGovernor() != NULL)
+			{
+				// Report why, and allow an automatic resume once cooled
+				raiseEvent(PUMP_EVENT_THERMAL_TRIP, thermalGovernor()->tripReason());
+				thermalGovernor()->recordTrip(true);
+			}
+		}
+		
+		if (relayGuard() != NULL)
+		{
+			// Never defer an over temperature stop
+			relayGuard()->bypassNext();
+		}
+
+		// Ensure that the Pump is turned off!				
+		this->iControlState = PUMP_CONTROL_STOP;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		this->_iSequence = PUMP_SEQUENCE_NONE;
+	}
+	else
+	{
+
+		// Check to see if the Pump should restart after an over temperature trip has cleared
+		if ((thermalGovernor() != NULL) && (thermalGovernor()->takeResume() == true) && (this->iControlState == PUMP_CONTROL_STOP))
+		{
+			// Start as ToggleState() would, including any Pump Ventilation
+			ToggleState();
+			raiseEvent(PUMP_EVENT_THERMAL_RESUME, this->iControlState);
+		}
+
+		// Check to see if a periodic Grain Rest is due
+		processGrainRest(ulTimeNow);
+
+		// Find the Sequence for the present Control State
+		uint8_t ui8Sequence = PUMP_SEQUENCE_NONE;
+
+		switch (this->iControlState)
+		{
+			case PUMP_CONTROL_VENT:
+				ui8Sequence = PUMP_SEQUENCE_VENTILATION;
+				break;
+			case PUMP_CONTROL_GRAIN_REST:
+				if ((this->iOperatingMode == PUMP_OPERATING_MODE_ON) && (this->iGrainRestLength != 0))
+				{
+					ui8Sequence = PUMP_SEQUENCE_GRAIN_REST;
+				}
+				break;
+			case PUMP_CONTROL_SEQUENCE:
+				// Started by runSequence()
+				ui8Sequence = this->_iSequence;
+				break;
+			default:
+				break;
+		}
+
+		// Start the Sequence, if the Control State was changed directly by the calling software (e.g. to begin a Grain Rest)
+		if (ui8Sequence != this->_iSequence)
+		{
+
+			if (ui8Sequence == PUMP_SEQUENCE_NONE)
+			{
+				this->_iSequence = PUMP_SEQUENCE_NONE;
+			}
+			else
+			{
+
+				startSequence(ui8Sequence);
+
+#if ACKSEN_PUMP_LEGACY_FIELDS
+				if (ui8Sequence == PUMP_SEQUENCE_GRAIN_REST)
+				{
+					// For display only - the rest itself is timed on millis() by its Sequence step
+					this->dtGrainRestEndTime = grainRestEndTime();
+				}
+#endif
+
+			}
+
+		}
+
+		if ((this->_iSequence != PUMP_SEQUENCE_NONE) && (processPriming(ulTimeNow) == false))
+		{
+			processSequence(ulTimeNow);
+		}
+		
+	}
+
+}
+
+void AcksenPump::startSequence(uint8_t ui8Sequence)
+{
+
+	this->_iSequence = ui8Sequence;
+	this->_ui8SequenceStep = 0;
+	this->iVentilationCycleRuntimeCount = 0;
+
+	if ((ui8Sequence == PUMP_SEQUENCE_VENTILATION) && (primeMonitor() != NULL))
+	{
+		// Watch for priming, against the time a full fixed Ventilation would take
+		unsigned long ulCycles = (this->iPumpVentilationCycles > 1) ? this->iPumpVentilationCycles : 1;
+		primeMonitor()->begin(AcksenHal::timeMillis(), (ulCycles * (ventOnLengthMillis() + ventOffLengthMillis())) + ventOnLengthMillis());
+	}
+
+	beginStep(AcksenHal::timeMillis());
+
+}
+
+void AcksenPump::processSequence(unsigned long ulTimeNow)
+{
+
+	AcksenPumpStep stStep;
+	loadStep(stStep);
+
+	// Check to see if the present step has elapsed (rollover safe), or its exit condition has been met
+	bool bStepElapsed = (stStep.ui8Duration != PUMP_STEP_DURATION_UNTIL_EXIT) && ((int32_t)(ulTimeNow - this->_ulPhaseEndMillis) >= 0);
+
+	if ((bStepElapsed == false) && (stepExitReached(stStep) == false))
+	{
+
+		if (stStep.ui8Duration == PUMP_STEP_DURATION_UNTIL_EXIT)
+		{
+			// Inputs to the exit condition flag a pass when they change - otherwise only look again after the idle interval
+			this->_ulPhaseEndMillis = ulTimeNow + PUMP_NEXT_EVENT_IDLE_INTERVAL;
+		}
+
+		return;
+
+	}
+
+	nextStep(stStep);
+
+	// Only one step is started per pass, so each pass takes constant time
+	beginStep(ulTimeNow);
+
+}
+
+void AcksenPump::nextStep(const AcksenPumpStep &stStep)
+{
+
+	uint8_t ui8Repeat = (stStep.ui8Repeat == PUMP_STEP_REPEAT_VENT_CYCLES) ? ventCycles() : stStep.ui8Repeat;
+
+	if (ui8Repeat == PUMP_STEP_REPEAT_FOREVER)
+	{
+		// Loop back
+		this->_ui8SequenceStep = stStep.ui8Goto;
+	}
+	else if (((ui8Repeat > 1) && ((this->iVentilationCycleRuntimeCount + 1) < ui8Repeat)) ||
+			 ((stStep.ui8Repeat == PUMP_STEP_REPEAT_VENT_CYCLES) && (extendVentilation() == true)))
+	{
+		// Loop back for another pass
+		this->iVentilationCycleRuntimeCount++;
+		this->_ui8SequenceStep = stStep.ui8Goto;
+	}
+	else
+	{
+
+		if (ui8Repeat > 1)
+		{
+			// Loop complete - ready for any following loop
+			this->iVentilationCycleRuntimeCount = 0;
+		}
+
+		// Move to the next step
+		this->_ui8SequenceStep++;
+
+	}
+
+}
+
+void AcksenPump::beginStep(unsigned long ulTimeNow)
+{
+
+	AcksenPumpStep stStep;
+	loadStep(stStep);
+
+	// Skip the Ventilation OFF/ON cycle when there are no Ventilation Cycles
+	while ((stStep.ui8Exit == PUMP_STEP_EXIT_NO_VENT_CYCLES) && (stepExitReached(stStep) == true))
+	{
+		nextStep(stStep);
+		loadStep(stStep);
+	}
+
+	if (stStep.ui8Output == PUMP_STEP_END)
+	{
+		endSequence((uint8_t)stStep.uiParam);
+		return;
+	}
+
+	this->iOutputStateRequested = stStep.ui8Output;
+	this->_ulPhaseEndMillis = ulTimeNow + stepLengthMillis(stStep);
+
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	if (this->iControlState == PUMP_CONTROL_VENT)
+	{
+		this->dtVentEndTime = ventEndTime();
+		this->dtVentStartTime = ventStartTime();
+	}
+#endif
+
+}
+
+void AcksenPump::endSequence(uint8_t ui8NextControlState)
+{
+
+	if ((this->_iSequence == PUMP_SEQUENCE_VENTILATION) && (primeMonitor() != NULL) && (primeMonitor()->measuring() == true) &&
+		(ui8NextControlState != PUMP_CONTROL_STOP))
+	{
+		// Never primed, even with the extra cycles - stop, rather than run dry
+		raiseEvent(PUMP_EVENT_DRY_RUN, primeMonitor()->recordDryRun() ? 1 : 0);
+		ui8NextControlState = PUMP_CONTROL_STOP;
+	}
+
+	this->_iSequence = PUMP_SEQUENCE_NONE;
+
+	// Move to next pump control stage
+	if ((this->iOperatingMode == PUMP_OPERATING_MODE_OFF) || (ui8NextControlState == PUMP_CONTROL_STOP))
+	{
+		// Moving to Stop Pump
+		this->iControlState = PUMP_CONTROL_STOP;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		this->iOperatingMode = PUMP_OPERATING_MODE_OFF;
+	}
+	else if (ui8NextControlState == PUMP_CONTROL_VENT)
+	{
+		// Initialise Mandatory Pump Vent
+		this->iControlState = PUMP_CONTROL_VENT;
+		startSequence(PUMP_SEQUENCE_VENTILATION);
+	}
+	else
+	{
+		// Moving to Start Pump
+		this->iControlState = PUMP_CONTROL_ON;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+	}
+
+}
+
+bool AcksenPump::processPriming(unsigned long ulTimeNow)
+{
+
+	if ((this->_iSequence != PUMP_SEQUENCE_VENTILATION) || (primeMonitor() == NULL) || (primeMonitor()->measuring() == false))
+	{
+		return false;
+	}
+
+	if (primeMonitor()->update((this->iOutputStateActual == PUMP_OUTPUT_STATE_ON), ulTimeNow) == false)
+	{
+		return false;
+	}
+
+	// Primed - no need to finish venting
+	unsigned long ulSeconds = primeMonitor()->timeToFullFlow() / 1000UL;
+
+	endSequence(PUMP_CONTROL_ON);
+	raiseEvent(PUMP_EVENT_PRIMED, (ulSeconds < 255) ? (int)ulSeconds : 255);
+
+	return true;
+
+}
+
+uint8_t AcksenPump::ventCycles()
+{
+
+	uint8_t ui8Cycles = this->iPumpVentilationCycles;
+
+	if ((this->_iSequence == PUMP_SEQUENCE_VENTILATION) && (primeMonitor() != NULL))
+	{
+		// The OFF/ON cycle always runs while priming is watched (see stepExitReached()), then once more for each extra cycle
+		ui8Cycles = ((ui8Cycles > 1) ? ui8Cycles : 1) + primeMonitor()->extraCycles();
+	}
+
+	return ui8Cycles;
+
+}
+
+bool AcksenPump::extendVentilation()
+{
+
+	if ((this->_iSequence != PUMP_SEQUENCE_VENTILATION) || (primeMonitor() == NULL) || (primeMonitor()->measuring() == false))
+	{
+		return false;
+	}
+
+	// Air lock persists as the cycles run out - add another, up to the limit
+	return primeMonitor()->extendCycle();
+
+}
+
+const AcksenPumpStep *AcksenPump::sequence()
+{
+
+	switch (this->_iSequence)
+	{
+		case PUMP_SEQUENCE_VENTILATION:
+			return AcksenPumpVentilationSequence;
+		case PUMP_SEQUENCE_GRAIN_REST:
+			return AcksenPumpGrainRestSequence;
+#if ACKSEN_PUMP_ATTACHMENTS
+		case PUMP_SEQUENCE_CUSTOM:
+			return this->_atAttachments.pSequence;
+#endif
+		default:
+			return NULL;
+	}
+
+}
+
+void AcksenPump::loadStep(AcksenPumpStep &stStep)
+{
+	AcksenHal::readFlash(&stStep, &sequence()[this->_ui8SequenceStep], sizeof(AcksenPumpStep));
+}
+
+unsigned long AcksenPump::stepLengthMillis(const AcksenPumpStep &stStep)
+{
+
+	switch (stStep.ui8Duration)
+	{
+		case PUMP_STEP_DURATION_MILLIS:
+			return stStep.uiParam;
+		case PUMP_STEP_DURATION_SECONDS:
+			return (unsigned long)stStep.uiParam * 1000UL;
+		case PUMP_STEP_DURATION_MINUTES:
+			return (unsigned long)stStep.uiParam * 60000UL;
+		case PUMP_STEP_DURATION_VENT_ON:
+			return ventOnLengthMillis();
+		case PUMP_STEP_DURATION_VENT_OFF:
+			return ventOffLengthMillis();
+		case PUMP_STEP_DURATION_GRAIN_REST:
+			return (unsigned long)this->iGrainRestLength * 60000UL;
+		default:
+			return 0;
+	}
+
+}
+
+bool AcksenPump::stepExitReached(const AcksenPumpStep &stStep)
+{
+
+	switch (stStep.ui8Exit)
+	{
+		case PUMP_STEP_EXIT_TEMPERATURE_ABOVE:
+			return (this->_iPumpTemperatureCenti >= ((int16_t)stStep.ui8ExitParam * 100));
+		case PUMP_STEP_EXIT_TEMPERATURE_BELOW:
+			return (this->_iPumpTemperatureCenti < ((int16_t)stStep.ui8ExitParam * 100));
+		case PUMP_STEP_EXIT_NO_VENT_CYCLES:
+			// Not while the AcksenPrimeMonitor may add cycles to clear an air lock
+			return ((this->iPumpVentilationCycles == 0) && ((primeMonitor() == NULL) || (primeMonitor()->measuring() == false)));
+		default:
+			return false;
+	}
+
+}
+
+time_t AcksenPump::ventEndTime()
+{
+
+	if (this->iControlState != PUMP_CONTROL_VENT)
+	{
+		return 0;
+	}
+
+	// Derived from the monotonic timebase, rounded up to the next whole second
+	int32_t lMillisRemaining = (int32_t)(this->_ulPhaseEndMillis - AcksenHal::timeMillis());
+
+	return AcksenHal::wallClock() + ((lMillisRemaining > 0) ? (time_t)(((unsigned long)lMillisRemaining + 999UL) / 1000UL) : 0);
+
+}
+
+time_t AcksenPump::ventStartTime()
+{
+
+	if (this->iControlState != PUMP_CONTROL_VENT)
+	{
+		return 0;
+	}
+
+	unsigned long ulLengthMillis = (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) ? ventOnLengthMillis() : ventOffLengthMillis();
+
+	return ventEndTime() - (time_t)((ulLengthMillis + 999UL) / 1000UL);
+
+}
+
+time_t AcksenPump::grainRestEndTime()
+{
+
+	if ((this->iControlState != PUMP_CONTROL_GRAIN_REST) || (this->_iSequence != PUMP_SEQUENCE_GRAIN_REST))
+	{
+		return 0;
+	}
+
+	// Derived from the monotonic timebase, rounded up to the next whole second
+	int32_t lMillisRemaining = (int32_t)(this->_ulPhaseEndMillis - AcksenHal::timeMillis());
+
+	return AcksenHal::wallClock() + ((lMillisRemaining > 0) ? (time_t)(((unsigned long)lMillisRemaining + 999UL) / 1000UL) : 0);
+
+}
+
+time_t AcksenPump::grainRestPeriodStartTime()
+{
+
+	if (this->_bGrainRestOverdue == true)
+	{
+		// Waiting until the rest is allowed
+		return AcksenHal::wallClock();
+	}
+
+	int32_t lMillisRemaining = (int32_t)(this->_ulGrainRestDueMillis - AcksenHal::timeMillis());
+
+	return AcksenHal::wallClock() + ((lMillisRemaining > 0) ? (time_t)(((unsigned long)lMillisRemaining + 999UL) / 1000UL) : 0);
+
+}
+
+unsigned long AcksenPump::ventOnLengthMillis()
+{
+#if ACKSEN_PUMP_VENT_MILLIS
+	return (this->uiPumpVentilationOnLengthMillis != 0) ? this->uiPumpVentilationOnLengthMillis : ((unsigned long)this->iPumpVentilationOnLength * 1000UL);
+#else
+	return (unsigned long)this->iPumpVentilationOnLength * 1000UL;
+#endif
+}
+
+unsigned long AcksenPump::ventOffLengthMillis()
+{
+#if ACKSEN_PUMP_VENT_MILLIS
+	return (this->uiPumpVentilationOffLengthMillis != 0) ? this->uiPumpVentilationOffLengthMillis : ((unsigned long)this->iPumpVentilationOffLength * 1000UL);
+#else
+	return (unsigned long)this->iPumpVentilationOffLength * 1000UL;
+#endif
+}
+
+void AcksenPump::updateOutput()
+{
+
+	// I/O Control Function
+
+	if (this->bNonBlockingSwitching == true)
+	{
+		// Advance any pending transition, without blocking
+		processSwitching();
+		return;
+	}
+
+	// Non-Blocking Switching was turned off part way through a transition
+	finishSwitching();
+
+	if (transitionDeferred(((this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) ? iPumpOnState : iPumpOffState), AcksenHal::timeMillis()) == true)
+	{
+		// Retried by a later pass
+		return;
+	}
+
+	// Check to see if a change needs to be made
+	if (this->iOutputStateRequested != this->iOutputStateActual)
+	{
+		// Set State Change Occurred flag for use by calling software
+		this->_bStateChangeOccurred = true;
+	}
+
+	// Match the Demand State!
+	if (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON)
+	{
+	
+		if (this->_iOutputLevel == iPumpOffState)
+		{
+			waitForPhaseSync();
+
+			// Pump ON
+			writeOutput(iPumpOnState);
+		}
+		
+		// If thrfe relay state is changing, incur a delay.
+		if (this->iOutputStateRequested != this->iOutputStateActual)
+		{
+			relaySwitchingDelay();
+			launchCallbackInitLCDs();
+		}
+			
+		this->iOutputStateActual = PUMP_OUTPUT_STATE_ON;
+	}
+	else
+	{
+		if (this->_iOutputLevel == iPumpOnState)
+		{
+			waitForPhaseSync();
+			
+			// Pump OFF
+			writeOutput(iPumpOffState);
+		}
+		
+		// If the relay state is changing, incur a delay.
+		if (this->iOutputStateRequested != this->iOutputStateActual)
+		{
+			relaySwitchingDelay();
+			launchCallbackInitLCDs();
+		}
+
+		this->iOutputStateActual = PUMP_OUTPUT_STATE_OFF;
+	}
+
+}
+
+void AcksenPump::beginMashingControl(void)
+{
+	bCurrentlyControllingMashing = true;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::endMashingControl(void)
+{
+	bCurrentlyControllingMashing = false;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::temporaryInhibitGrainRestAsAroundPreheatSetPoint(void)
+{
+	bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = true;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::temporaryPermitGrainRestAsAroundPreheatSetPoint(void)
+{
+	bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = false;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::waitForPhaseSync(void)
+{
+	
+	if ((this->bEnablePhaseSync == false) || ((this->_ui8PhaseSyncInputPin == PUMP_PIN_NONE) && (phaseSync() == NULL)))
+	{
+			// Phase Sync not setup or disabled - return immediately.
+			return;
+	}
+	
+#if ACKSEN_PUMP_ATTACHMENTS
+	if (phaseSync() != NULL)
+	{
+
+		unsigned long ulSwitchMicros;
+
+#if ACKSEN_PUMP_PROFILING
+		unsigned long ulStartMicros = AcksenHal::timeMicros();
+#endif
+
+		// Switch on the same edge as any other pump still within its delay, or the predicted Zero Crossing, plus any additional delay
+		if (phaseSync()->switchMicros((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL, ulSwitchMicros) == false)
+		{
+
+			// Not yet locked - wait for the next captured edge, rather than polling the input
+			unsigned long ulSinceMicros = AcksenHal::timeMicros();
+			unsigned long ulStart = AcksenHal::timeMillis();
+			unsigned long ulEdgeMicros;
+
+			while (phaseSync()->edgeSince(ulSinceMicros, ulEdgeMicros) == false)
+			{
+
+				AcksenHal::busyWaitTick();
+
+				if ((uint32_t)(AcksenHal::timeMillis() - ulStart) > (2 * PHASE_SYNC_TIMEOUT))
+				{
+
+					// Switching will go ahead regardless - let the calling software know
+					raiseEvent(PUMP_EVENT_PHASE_SYNC_TIMEOUT, this->iControlState);
+
+#if ACKSEN_PUMP_PROFILING
+					this->_pfProfile.uiPinTimeouts++;
+#endif
+
+					ulEdgeMicros = AcksenHal::timeMicros();
+					break;
+
+				}
+
+			}
+
+			ulSwitchMicros = ulEdgeMicros + ((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL);
+
+		}
+
+		unsigned long ulWaitMicros = (uint32_t)(ulSwitchMicros - AcksenHal::timeMicros());
+		
+		if ((int32_t)ulWaitMicros > 0)
+		{
+			AcksenHal::sleepMillis(ulWaitMicros / 1000);
+			AcksenHal::sleepMicros(ulWaitMicros % 1000);
+		}
+
+#if ACKSEN_PUMP_PROFILING
+		this->_pfProfile.ulPhaseSyncWaitMicros += (uint32_t)(AcksenHal::timeMicros() - ulStartMicros);
+#endif
+		
+		return;
+		
+	}
+#endif
+	
+	if (this->_ui8PhaseSyncInputPin == PUMP_PIN_NONE)
+	{
+		// No pin to poll - return immediately.
+		return;
+	}
+	
+	bool bEdgeSeen = true;
+	
+#if ACKSEN_PUMP_PROFILING
+	unsigned long ulStartMicros = AcksenHal::timeMicros();
+#endif
+	
+	// Resolve the pin once for the wait, for direct register access where supported
+	AcksenHal::FastPin fpPhaseSyncInput;
+	AcksenHal::resolveFastPin(fpPhaseSyncInput, this->_ui8PhaseSyncInputPin);
+	
+	// Check to see if the phase input is negative before proceeding
+	if (AcksenHal::readFastPin(fpPhaseSyncInput) == true)
+	{
+		// Have to wait until the phase input is negative!
+		bEdgeSeen = waitForPin(fpPhaseSyncInput, false, PHASE_SYNC_TIMEOUT);
+	}
+	
+	// Check to see if the rising edge trigger has been received
+	if (waitForPin(fpPhaseSyncInput, true, PHASE_SYNC_TIMEOUT) == false)
+	{
+		bEdgeSeen = false;
+	}
+	
+	if (bEdgeSeen == false)
+	{
+		// Switching will go ahead regardless - let the calling software know
+		raiseEvent(PUMP_EVENT_PHASE_SYNC_TIMEOUT, this->iControlState);
+	}
+	
+	// Apply additional delay before continuing to operate output relay
+	AcksenHal::sleepMillis(this->iPhaseSyncPreActivationDelay);
+	
+#if ACKSEN_PUMP_PROFILING
+	this->_pfProfile.ulPhaseSyncWaitMicros += (uint32_t)(AcksenHal::timeMicros() - ulStartMicros);
+#endif
+	
+}
+
+// Wait for the given pin to become the given value. Returns true when
+// that happened, or false when timeout ms passed
+bool AcksenPump::waitForPin(const AcksenHal::FastPin &fpPin, uint8_t value, uint16_t timeout)
+{
+	unsigned long start = AcksenHal::timeMillis();
+
+	while (true)
+	{
+		if (AcksenHal::readFastPin(fpPin) == value)
+		{
+			return true;
+		}
+		AcksenHal::busyWaitTick();
+		if ((uint32_t)(AcksenHal::timeMillis() - start) > timeout)
+		{
+#if ACKSEN_PUMP_PROFILING
+			this->_pfProfile.uiPinTimeouts++;
+#endif
+			return false;
+		}
+	}
+}
+
+void AcksenPump::writeOutput(int iLevel)
+{
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	// Take the output back from the Burst-Fire edge handler first
+	stopBurstFire();
+#endif
+
+	// Keep the shadow copy of the commanded level
+	writeOutputLevel(iLevel);
+	this->_iOutputLevel = iLevel;
+
+	raiseEvent((iLevel == iPumpOnState) ? PUMP_EVENT_OUTPUT_ON : PUMP_EVENT_OUTPUT_OFF, this->iControlState);
+
+	if (relayGuard() != NULL)
+	{
+		relayGuard()->recordTransition((iLevel == iPumpOnState), AcksenHal::timeMillis());
+	}
+
+#if ACKSEN_PUMP_PROFILING
+	this->_pfProfile.ulRelayTransitions++;
+#endif
+
+}
+
+void AcksenPump::writeOutputLevel(int iLevel)
+{
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	// Single register write where supported
+	AcksenHal::writeFastPin(this->_atAttachments.fpPumpOutput, iLevel);
+#else
+	// Resolved for each write, rather than held by every pump
+	AcksenHal::FastPin fpPumpOutput;
+	AcksenHal::resolveFastPin(fpPumpOutput, (this->_ui8PumpOutputPin == PUMP_PIN_NONE) ? -1 : this->_ui8PumpOutputPin);
+	AcksenHal::writeFastPin(fpPumpOutput, iLevel);
+#endif
+
+}
+
+void AcksenPump::processSwitching(void)
+{
+
+	unsigned long ulTimeNow = AcksenHal::timeMillis();
+	int iDemandLevel = (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) ? iPumpOnState : iPumpOffState;
+
+	if ((this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED) && (transitionDeferred(iDemandLevel, ulTimeNow) == true))
+	{
+		// Retried by a later pass
+		return;
+	}
+
+	// Check to see if a change needs to be made
+	if (this->iOutputStateRequested != this->iOutputStateActual)
+	{
+		// Set State Change Occurred flag for use by calling software
+		this->_bStateChangeOccurred = true;
+	}
+
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED)
+	{
+
+		if (this->_iOutputLevel == iDemandLevel)
+		{
+			// Output already matches the Demand State
+			this->iOutputStateActual = this->iOutputStateRequested;
+			return;
+		}
+
+		// Queue the transition
+		this->_iSwitchState = PUMP_SWITCH_STATE_PENDING;
+		this->_uiSwitchMillis = (uint16_t)ulTimeNow;
+		this->_bPhaseSyncEdgeSeen = false;
+		this->_iPhaseSyncLastLevel = HIGH;	// Require a LOW to HIGH edge, as per waitForPhaseSync()
+
+#if ACKSEN_PUMP_ATTACHMENTS
+		this->_atAttachments.bPhaseSyncPredicted = false;
+
+		if (phaseSync() != NULL)
+		{
+
+			// Schedule the switch for the edge shared with any other pump still within its delay, or the predicted Zero Crossing, plus any additional delay
+			this->_atAttachments.bPhaseSyncPredicted = phaseSync()->switchMicros((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL, this->_atAttachments.ulPhaseSyncMicros);
+
+			if (this->_atAttachments.bPhaseSyncPredicted == false)
+			{
+				// Not yet locked - wait for the next captured edge
+				this->_atAttachments.ulPhaseSyncMicros = AcksenHal::timeMicros();
+			}
+
+		}
+#endif
+
+	}
+
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
+	{
+
+		if (this->_iOutputLevel == iDemandLevel)
+		{
+			// Request was reversed before it was applied - nothing to do
+			this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+			this->iOutputStateActual = this->iOutputStateRequested;
+			return;
+		}
+
+		if (phaseSyncReady(ulTimeNow) == false)
+		{
+			// Still waiting for the Zero Crossing
+			return;
+		}
+
+		// Match the Demand State!
+		writeOutput(iDemandLevel);
+		this->iOutputStateActual = this->iOutputStateRequested;
+
+		// Start the relay settling window
+		this->_iSwitchState = PUMP_SWITCH_STATE_SETTLING;
+		this->_uiSwitchMillis = (uint16_t)ulTimeNow;
+
+	}
+
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+	{
+
+		// Check to see if the relay settling window has elapsed (rollover safe)
+		if ((uint16_t)((uint16_t)ulTimeNow - this->_uiSwitchMillis) >= switchingDelay())
+		{
+			this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+			launchCallbackInitLCDs();
+		}
+
+	}
+
+}
+
+void AcksenPump::finishSwitching(void)
+{
+
+	if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
+	{
+
+		int iDemandLevel = (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) ? iPumpOnState : iPumpOffState;
+
+		// Complete the queued transition as the blocking code would have done - it already passed any Relay Guard or supply
+		if (this->_iOutputLevel != iDemandLevel)
+		{
+			waitForPhaseSync();
+			writeOutput(iDemandLevel);
+			relaySwitchingDelay();
+			launchCallbackInitLCDs();
+		}
+
+		this->iOutputStateActual = this->iOutputStateRequested;
+
+	}
+	else if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+	{
+
+		// Wait out the rest of the relay settling window
+		unsigned long ulRemaining = settlingTimeRemaining();
+
+		if (ulRemaining != 0)
+		{
+			AcksenHal::sleepMillis(ulRemaining);
+		}
+
+		launchCallbackInitLCDs();
+
+	}
+
+	this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+
+}
+
+uint16_t AcksenPump::switchingDelay(void)
+{
+
+	// Held as int in the v1.8 layout - the settling window is timed in 16 bits
+	long lDelay = this->iPumpRelaySwitchingDelay;
+
+	return (lDelay < 0) ? 0 : ((lDelay > 0xFFFFL) ? 0xFFFF : (uint16_t)lDelay);
+
+}
+
+bool AcksenPump::phaseSyncReady(unsigned long ulTimeNow)
+{
+
+	if ((this->bEnablePhaseSync == false) || ((this->_ui8PhaseSyncInputPin == PUMP_PIN_NONE) && (phaseSync() == NULL)))
+	{
+		// Phase Sync not setup or disabled - ready immediately.
+		return true;
+	}
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	if (phaseSync() != NULL)
+	{
+
+		unsigned long ulDelayMicros = (unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL;
+
+		if (this->_atAttachments.bPhaseSyncPredicted == false)
+		{
+
+			unsigned long ulEdgeMicros;
+
+			// AcksenPhaseSync not yet locked - every pump waiting from before the next captured edge switches on it
+			if (phaseSync()->edgeSince(this->_atAttachments.ulPhaseSyncMicros, ulEdgeMicros) == false)
+			{
+
+				if ((uint32_t)(AcksenHal::timeMicros() - this->_atAttachments.ulPhaseSyncMicros) <= (2UL * PHASE_SYNC_TIMEOUT * 1000UL))
+				{
+					return false;
+				}
+
+				// No edge seen within the same time limit applied by waitForPhaseSync() - proceed regardless
+				raiseEvent(PUMP_EVENT_PHASE_SYNC_TIMEOUT, this->iControlState);
+
+#if ACKSEN_PUMP_PROFILING
+				this->_pfProfile.uiPinTimeouts++;
+#endif
+
+				ulEdgeMicros = AcksenHal::timeMicros();
+
+			}
+
+			this->_atAttachments.bPhaseSyncPredicted = true;
+			this->_atAttachments.ulPhaseSyncMicros = ulEdgeMicros + ulDelayMicros;
+
+		}
+
+		// Switch at the scheduled point in the mains cycle, or the same point after the next edge if this pass is too late for it
+		return phaseSync()->switchDue(ulDelayMicros, this->_atAttachments.ulPhaseSyncMicros);
+
+	}
+#endif
+
+	if (this->_ui8PhaseSyncInputPin == PUMP_PIN_NONE)
+	{
+		// No pin to poll - ready immediately.
+		return true;
+	}
+
+	if (this->_bPhaseSyncEdgeSeen == false)
+	{
+
+		AcksenHal::FastPin fpPhaseSyncInput;
+		AcksenHal::resolveFastPin(fpPhaseSyncInput, this->_ui8PhaseSyncInputPin);
+
+		int iPhaseLevel = AcksenHal::readFastPin(fpPhaseSyncInput);
+
+		if ((iPhaseLevel == HIGH) && (this->_iPhaseSyncLastLevel == LOW))
+		{
+			// Rising edge trigger has been received
+			this->_bPhaseSyncEdgeSeen = true;
+			this->_uiSwitchMillis = (uint16_t)ulTimeNow;
+		}
+		else if ((uint16_t)((uint16_t)ulTimeNow - this->_uiSwitchMillis) > (2 * PHASE_SYNC_TIMEOUT))
+		{
+			// No edge seen within the same time limit applied by waitForPhaseSync() - proceed regardless
+			this->_bPhaseSyncEdgeSeen = true;
+			this->_uiSwitchMillis = (uint16_t)ulTimeNow;
+			raiseEvent(PUMP_EVENT_PHASE_SYNC_TIMEOUT, this->iControlState);
+
+#if ACKSEN_PUMP_PROFILING
+			this->_pfProfile.uiPinTimeouts++;
+#endif
+		}
+
+		this->_iPhaseSyncLastLevel = iPhaseLevel;
+
+		if (this->_bPhaseSyncEdgeSeen == false)
+		{
+			return false;
+		}
+
+	}
+
+	// Apply additional delay before continuing to operate output relay
+	return ((uint16_t)((uint16_t)ulTimeNow - this->_uiSwitchMillis) >= (uint16_t)this->iPhaseSyncPreActivationDelay);
+
+}
+
+int AcksenPump::switchingState(void)
+{
+	return this->_iSwitchState;
+}
+
+bool AcksenPump::switchingSettled(void)
+{
+	return (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED);
+}
+
+unsigned long AcksenPump::settlingTimeRemaining(void)
+{
+
+	if (this->_iSwitchState != PUMP_SWITCH_STATE_SETTLING)
+	{
+		return 0;
+	}
+
+	uint16_t uiElapsed = (uint16_t)((uint16_t)AcksenHal::timeMillis() - this->_uiSwitchMillis);
+	uint16_t uiDelay = switchingDelay();
+
+	return (uiElapsed >= uiDelay) ? 0 : (unsigned long)(uiDelay - uiElapsed);
+
+}
+
+uint8_t AcksenPump::flowPercent(void)
+{
+#if ACKSEN_PUMP_ATTACHMENTS
+	return this->_atAttachments.ui8FlowPercent;
+#else
+	return PUMP_FLOW_PERCENT_FULL;
+#endif
+}
+
+#if ACKSEN_PUMP_ATTACHMENTS
+void AcksenPump::attachPhaseSync(AcksenPhaseSync *pPhaseSync)
+{
+
+	if (this->_atAttachments.bBurstFireListening == true)
+	{
+		// Detach Burst-Fire from the previous AcksenPhaseSync, and restore the commanded output level
+		stopBurstFire();
+		writeOutputLevel(this->_iOutputLevel);
+		this->_atAttachments.pPhaseSync->removeEdgeListener(&AcksenPump::burstFireEdge, this);
+		this->_atAttachments.bBurstFireListening = false;
+	}
+
+	this->_atAttachments.pPhaseSync = pPhaseSync;
+	this->_bProcessRequired = true;
+
+}
+
+void AcksenPump::setFlowPercent(uint8_t ui8Percent)
+{
+
+	if (ui8Percent > PUMP_FLOW_PERCENT_FULL)
+	{
+		ui8Percent = PUMP_FLOW_PERCENT_FULL;
+	}
+
+	this->_atAttachments.ui8FlowPercent = ui8Percent;
+	this->_bProcessRequired = true;
+
+}
+
+void PHASE_SYNC_ISR_ATTR AcksenPump::burstFireEdge(void *pContext)
+{
+
+	AcksenPump *pPump = (AcksenPump *)pContext;
+	AcksenPumpAttachments *pAttachments = &pPump->_atAttachments;
+	uint8_t ui8Percent = pAttachments->ui8BurstFlowPercent;
+
+	if (ui8Percent == PUMP_BURST_FIRE_INACTIVE)
+	{
+		return;
+	}
+
+	// Bresenham distribution - ON for ui8Percent cycles in every 100, spread as evenly as possible
+	pAttachments->ui8BurstAccumulator += ui8Percent;
+
+	if (pAttachments->ui8BurstAccumulator >= PUMP_FLOW_PERCENT_FULL)
+	{
+		pAttachments->ui8BurstAccumulator -= PUMP_FLOW_PERCENT_FULL;
+		AcksenHal::writeFastPin(pAttachments->fpPumpOutput, pPump->iPumpOnState);
+	}
+	else
+	{
+		AcksenHal::writeFastPin(pAttachments->fpPumpOutput, pPump->iPumpOffState);
+	}
+
+}
+
+void AcksenPump::updateBurstFire(void)
+{
+
+	// Only modulate a settled ON output, while the AcksenPhaseSync is locked to the mains supply
+	bool bActive = ((this->_atAttachments.ui8FlowPercent < PUMP_FLOW_PERCENT_FULL) &&
+					(this->_iOutputLevel == iPumpOnState) &&
+					(this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED) &&
+					(phaseSync() != NULL) &&
+					(phaseSync()->locked() == true));
+
+	if ((bActive == true) && (this->_atAttachments.bBurstFireListening == false))
+	{
+		this->_atAttachments.bBurstFireListening = phaseSync()->addEdgeListener(&AcksenPump::burstFireEdge, this);
+		bActive = this->_atAttachments.bBurstFireListening;
+	}
+
+	if (bActive == true)
+	{
+
+		if (this->_atAttachments.ui8BurstFlowPercent == PUMP_BURST_FIRE_INACTIVE)
+		{
+			// Starting - the first ON cycle will follow 100 / Flow Percentage cycles from now
+			this->_atAttachments.ui8BurstAccumulator = 0;
+		}
+
+		this->_atAttachments.ui8BurstFlowPercent = this->_atAttachments.ui8FlowPercent;
+
+	}
+	else if (this->_atAttachments.ui8BurstFlowPercent != PUMP_BURST_FIRE_INACTIVE)
+	{
+		// Fall back to the commanded output level (full flow, if ON)
+		stopBurstFire();
+		writeOutputLevel(this->_iOutputLevel);
+	}
+
+}
+
+void AcksenPump::stopBurstFire(void)
+{
+
+	// Any edge after this leaves the output alone.  The listener stays registered, for reuse.
+	this->_atAttachments.ui8BurstFlowPercent = PUMP_BURST_FIRE_INACTIVE;
+
+}
+
+void AcksenPump::attachEventQueue(AcksenPumpEventQueue *pEventQueue, uint8_t ui8PumpId)
+{
+	this->_atAttachments.pEventQueue = pEventQueue;
+	this->_atAttachments.ui8EventPumpId = ui8PumpId;
+}
+
+void AcksenPump::attachThermalGovernor(AcksenThermalGovernor *pThermalGovernor)
+{
+	this->_atAttachments.pThermalGovernor = pThermalGovernor;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::attachRelayGuard(AcksenRelayGuard *pRelayGuard)
+{
+	this->_atAttachments.pRelayGuard = pRelayGuard;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::attachPrimeMonitor(AcksenPrimeMonitor *pPrimeMonitor)
+{
+	this->_atAttachments.pPrimeMonitor = pPrimeMonitor;
+	this->_bProcessRequired = true;
+}
+
+void AcksenPump::attachNotifier(AcksenPumpNotifier *pNotifier)
+{
+	this->_atAttachments.pNotifier = pNotifier;
+}
+
+void AcksenPump::attachSupply(AcksenPumpSupply *pSupply)
+{
+	this->_atAttachments.pSupply = pSupply;
+	this->_bProcessRequired = true;
+}
+#endif
+
+bool AcksenPump::transitionDeferred(int iDemandLevel, unsigned long ulTimeNow)
+{
+
+	// The Relay Guard goes first, so a start is only queued on the supply once the relay may switch
+	if (relayGuardDefers(iDemandLevel, ulTimeNow) == true)
+	{
+		return true;
+	}
+
+	return supplyDefers(iDemandLevel, ulTimeNow);
+
+}
+
+bool AcksenPump::supplyDefers(int iDemandLevel, unsigned long ulTimeNow)
+{
+
+	if (supply() == NULL)
+	{
+		return false;
+	}
+
+	if ((this->_iOutputLevel == iDemandLevel) || (iDemandLevel == iPumpOffState))
+	{
+		// Only OFF to ON transitions draw inrush current - leave the queue
+		supply()->requestCleared(this);
+		return false;
+	}
+
+	return (supply()->requestStart(this, ulTimeNow) == false);
+
+}
+
+bool AcksenPump::relayGuardDefers(int iDemandLevel, unsigned long ulTimeNow)
+{
+
+	if (relayGuard() == NULL)
+	{
+		return false;
+	}
+
+	if (this->_iOutputLevel == iDemandLevel)
+	{
+		// No transition wanted - cancels any deferred one
+		relayGuard()->requestCleared();
+		return false;
+	}
+
+	return (relayGuard()->requestTransition((iDemandLevel == iPumpOnState), ulTimeNow) == false);
+
+}
+
+void AcksenPump::raiseEvent(uint8_t ui8Type, int iValue)
+{
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	if (this->_atAttachments.pEventQueue != NULL)
+	{
+		this->_atAttachments.pEventQueue->push(this->_atAttachments.ui8EventPumpId, ui8Type, (uint8_t)iValue);
+	}
+#else
+	(void)ui8Type;
+	(void)iValue;
+#endif
+
+}
+
+void AcksenPump::recordControlState(void)
+{
+
+	if (this->iControlState != this->_iLastControlState)
+	{
+		raiseEvent(PUMP_EVENT_CONTROL_STATE, this->iControlState);
+	}
+
+	this->_iLastControlState = this->iControlState;
+
+}
+
+void AcksenPump::relaySwitchingDelay(void)
+{
+
+#if ACKSEN_PUMP_PROFILING
+	unsigned long ulStartMicros = AcksenHal::timeMicros();
+
+	AcksenHal::sleepMillis(this->iPumpRelaySwitchingDelay);
+
+	this->_pfProfile.ulRelaySwitchingDelayMicros += (uint32_t)(AcksenHal::timeMicros() - ulStartMicros);
+#else
+	AcksenHal::sleepMillis(this->iPumpRelaySwitchingDelay);
+#endif
+
+}
+
+void AcksenPump::getProfile(AcksenPumpProfile &pfProfile)
+{
+
+#if ACKSEN_PUMP_PROFILING
+	pfProfile = this->_pfProfile;
+#else
+	memset(&pfProfile, 0, sizeof(pfProfile));
+#endif
+
+}
+
+void AcksenPump::resetProfile(void)
+{
+
+#if ACKSEN_PUMP_PROFILING
+	memset(&this->_pfProfile, 0, sizeof(this->_pfProfile));
+	this->_pfProfile.ulProcessMinMicros = 0xFFFFFFFFUL;
+#endif
+
+}
+
+#if ACKSEN_PUMP_PROFILING
+void AcksenPump::recordProcessTime(unsigned long ulMicros)
+{
+
+	this->_pfProfile.ulProcessCalls++;
+	this->_pfProfile.ulProcessTotalMicros += ulMicros;
+
+	if (ulMicros < this->_pfProfile.ulProcessMinMicros)
+	{
+		this->_pfProfile.ulProcessMinMicros = ulMicros;
+	}
+
+	if (ulMicros > this->_pfProfile.ulProcessMaxMicros)
+	{
+		this->_pfProfile.ulProcessMaxMicros = ulMicros;
+	}
+
+	// Bin by bit length - bin n holds durations from 2^(n-1) to (2^n)-1 Microseconds, with the last bin holding everything longer
+	uint8_t ui8Bin = 0;
+
+	while ((ulMicros != 0) && (ui8Bin < (PUMP_PROFILE_HISTOGRAM_BINS - 1)))
+	{
+		ulMicros >>= 1;
+		ui8Bin++;
+	}
+
+	if (this->_pfProfile.uiProcessHistogram[ui8Bin] != 0xFFFF)
+	{
+		this->_pfProfile.uiProcessHistogram[ui8Bin]++;
+	}
+
+}
+#endif
+
+void AcksenPump::switchPumpNegativeLogic(void)
+{
+
+	// Set Negative Logics for Pump
+
+	// Allow the normal logic used to be inverted
+	setOutputLogic(true);
+
+	this->_bProcessRequired = true;
+
+}
+
+void AcksenPump::setOutputLogic(bool bNegativeLogic)
+{
+
+	if (bNegativeLogic == (this->iPumpOnState == PUMP_NEGATIVE_LOGIC_ON))
+	{
+		// No change
+		return;
+	}
+
+	this->iPumpOnState = bNegativeLogic ? PUMP_NEGATIVE_LOGIC_ON : PUMP_POSITIVE_LOGIC_ON;
+	this->iPumpOffState = bNegativeLogic ? PUMP_NEGATIVE_LOGIC_OFF : PUMP_POSITIVE_LOGIC_OFF;
+
+	// Keep the Pump in the same state, at the new logic level
+	this->_iOutputLevel = (this->iOutputStateActual == PUMP_OUTPUT_STATE_ON) ? iPumpOnState : iPumpOffState;
+	writeOutputLevel(this->_iOutputLevel);
+
+}
+
+// Settings held as int in the v1.8 layout are saturated to the snapshot field, rather than wrapping round (300 must not come back as 44)
+static uint8_t configByte(long lValue)
+{
+	return (lValue < 0) ? 0 : ((lValue > 0xFF) ? 0xFF : (uint8_t)lValue);
+}
+
+static uint16_t configWord(long lValue)
+{
+	return (lValue < 0) ? 0 : ((lValue > 0xFFFFL) ? 0xFFFF : (uint16_t)lValue);
+}
+
+void AcksenPump::getConfig(AcksenPumpConfig &cfConfig)
+{
+
+#if ACKSEN_PUMP_VENT_MILLIS
+	cfConfig.uiPumpVentilationOnLengthMillis = this->uiPumpVentilationOnLengthMillis;
+	cfConfig.uiPumpVentilationOffLengthMillis = this->uiPumpVentilationOffLengthMillis;
+#else
+	cfConfig.uiPumpVentilationOnLengthMillis = 0;
+	cfConfig.uiPumpVentilationOffLengthMillis = 0;
+#endif
+	cfConfig.uiPumpRelaySwitchingDelay = configWord(this->iPumpRelaySwitchingDelay);
+	cfConfig.ui8Version = PUMP_CONFIG_VERSION;
+	cfConfig.ui8PumpVentilationCycles = configByte(this->iPumpVentilationCycles);
+	cfConfig.ui8PumpVentilationOnLength = configByte(this->iPumpVentilationOnLength);
+	cfConfig.ui8PumpVentilationOffLength = configByte(this->iPumpVentilationOffLength);
+	cfConfig.ui8GrainRestLength = configByte(this->iGrainRestLength);
+	cfConfig.ui8GrainRestPeriod = configByte(this->iGrainRestPeriod);
+	cfConfig.ui8MaxPumpTemperature = configByte(this->iMaxPumpTemperature);
+	cfConfig.ui8PhaseSyncPreActivationDelay = configByte(this->iPhaseSyncPreActivationDelay);
+	cfConfig.ui8Reserved = 0;
+
+	cfConfig.ui8Flags = 0;
+
+	if (this->iPumpOnState == PUMP_NEGATIVE_LOGIC_ON)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_NEGATIVE_LOGIC;
+	}
+	if (this->bEnablePumpVentilation == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_VENTILATION;
+	}
+	if (this->bEnableMaxPumpTemperature == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_MAX_TEMPERATURE;
+	}
+	if (this->bEnableGrainRest == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_GRAIN_REST;
+	}
+	if (this->bEnableInhibitGrainRestAroundSetPoint == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_INHIBIT_GRAIN_REST;
+	}
+	if (this->bEnablePhaseSync == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_PHASE_SYNC;
+	}
+	if (this->bNonBlockingSwitching == true)
+	{
+		cfConfig.ui8Flags |= PUMP_CONFIG_FLAG_NON_BLOCKING;
+	}
+
+}
+
+void AcksenPump::setConfig(const AcksenPumpConfig &cfConfig)
+{
+
+	if (((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_NON_BLOCKING) == 0) && (this->bNonBlockingSwitching == true))
+	{
+		// Moving to blocking switching - complete any transition in progress first, using the settings it was started with
+		finishSwitching();
+	}
+
+#if ACKSEN_PUMP_VENT_MILLIS
+	this->uiPumpVentilationOnLengthMillis = cfConfig.uiPumpVentilationOnLengthMillis;
+	this->uiPumpVentilationOffLengthMillis = cfConfig.uiPumpVentilationOffLengthMillis;
+#endif
+	this->iPumpRelaySwitchingDelay = cfConfig.uiPumpRelaySwitchingDelay;
+	this->iPumpVentilationCycles = cfConfig.ui8PumpVentilationCycles;
+	this->iPumpVentilationOnLength = cfConfig.ui8PumpVentilationOnLength;
+	this->iPumpVentilationOffLength = cfConfig.ui8PumpVentilationOffLength;
+	this->iGrainRestLength = cfConfig.ui8GrainRestLength;
+	this->iGrainRestPeriod = cfConfig.ui8GrainRestPeriod;
+	this->iMaxPumpTemperature = cfConfig.ui8MaxPumpTemperature;
+	this->iPhaseSyncPreActivationDelay = cfConfig.ui8PhaseSyncPreActivationDelay;
+
+	this->bEnablePumpVentilation = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_VENTILATION) != 0);
+	this->bEnableMaxPumpTemperature = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_MAX_TEMPERATURE) != 0);
+	this->bEnableGrainRest = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_GRAIN_REST) != 0);
+	this->bEnableInhibitGrainRestAroundSetPoint = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_INHIBIT_GRAIN_REST) != 0);
+	this->bEnablePhaseSync = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_PHASE_SYNC) != 0);
+	this->bNonBlockingSwitching = ((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_NON_BLOCKING) != 0);
+
+	setOutputLogic((cfConfig.ui8Flags & PUMP_CONFIG_FLAG_NEGATIVE_LOGIC) != 0);
+
+	this->_bProcessRequired = true;
+
+}
 
 void AcksenPump::launchCallbackInitLCDs()
 {
-	(*callbackInitLCDs)();     // call the handler  
+	if (callbackInitLCDs != NULL)
+	{
+		(*callbackInitLCDs)();     // call the handler  
+	}
+
+	if (notifier() != NULL)
+	{
+		notifier()->notify();
+	}
 }
\ No newline at end of file
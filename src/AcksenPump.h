@@ -19,11 +19,49 @@ Neither the name of the copyright holder nor the names of its contributors may b
 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ***********************************************************/
 
-// Acksen Pump Library v1.8.1
-// (c) Acksen Ltd 2022, 2023
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2022, 2023, 2026
 //
 // Collection of function libraries for Acksen Pump Control.
 // 
+// v1.9.0	16 Oct 2026
+// - Add optional Non-Blocking Switching mode, where Pump Output transitions are advanced through Pending/Settling sub-states by process() rather than using delay()
+// - Add AcksenPhaseSync, for interrupt-driven Voltage Phase Sync capture with mains period estimation and Zero Crossing prediction
+// - Add AcksenPumpBank, to process many pumps in one pass and apply their output changes with one shared Phase Sync wait and Relay Switching Delay
+// - Add Hardware Abstraction Layer (AcksenPumpHal.h), with Arduino backend by default and a Linux host backend for native builds (see extras/host)
+// - Do not call callbackInitLCDs if it has not been set
+// - Add nextEventMillis(), so hosts can sleep until the next Pump deadline, and a fast path in process() when nothing is due
+// - Time Pump Ventilation and Grain Rests using a rollover-safe millis() timebase, rather than TimeLib now().  Wall clock times are kept for reporting only.
+// - Add uiPumpVentilationOnLengthMillis/uiPumpVentilationOffLengthMillis, for Ventilation phases shorter than one second
+// - Write the Pump Output and poll the Phase Sync input using direct port access (AVR), and keep a shadow copy of the Pump Output level rather than reading it back
+// - Add AcksenPumpEventQueue, a lock-free queue of timestamped Pump events (output changes, control state changes, over temperature trips, Phase Sync timeouts)
+// - Add optional profiling counters (ACKSEN_PUMP_PROFILING) for process() duration, time lost to blocking delays and Phase Sync waits, pin timeouts and relay transitions
+// - Add AcksenPumpT, a header-only template with pins, logic and features fixed at compile time, so disabled features take no RAM or flash
+// - Reduce AcksenPump internal RAM use: private flags held in bitfields, and one shared timer for each use.  Add pumpTemperature(), ventStartTime() and ventEndTime() accessors.
+// - Add ACKSEN_PUMP_LEGACY_FIELDS build option.  The public fields keep their v1.8 names and types by default (1), including fPumpTemperature, dtVentStartTime and dtVentEndTime, so existing sketches compile unchanged.
+//   Set to 0 for the compact layout on 2KB parts, checked against PUMP_RAM_BUDGET at compile time: flags and states in bitfields, small settings in uint8_t/uint16_t, and the three fields above removed (use the accessors instead),
+//   along with dtGrainRestEndTime and dtGrainRestPeriodStartTime (use grainRestEndTime() and grainRestPeriodStartTime()).
+// - Add ACKSEN_PUMP_ATTACHMENTS build option, compiling in attachEventQueue(), attachThermalGovernor(), attachRelayGuard(), attachPrimeMonitor(), attachNotifier(), attachPhaseSync(), attachSupply(), setFlowPercent() and runSequence(),
+//   along with the state they use (AcksenPumpAttachments).  On by default, except with the compact layout.  The compact layout without attachments is 32 bytes on AVR, but the default v1.8 layout with attachments uses more RAM than v1.8 did.
+// - Add ACKSEN_PUMP_VENT_MILLIS build option, compiling in uiPumpVentilationOnLengthMillis/uiPumpVentilationOffLengthMillis.  Follows ACKSEN_PUMP_ATTACHMENTS by default.
+// - Add table-driven Pump Sequences (AcksenPumpSequence.h), stored in PROGMEM.  Pump Ventilation and Grain Rests are now built-in Sequences, and runSequence() runs custom ones (see examples/pump_sequence)
+// - Add setFlowPercent(), for Burst-Fire proportional Pump flow, switched at each Zero Crossing by an attached AcksenPhaseSync.  Add AcksenPhaseSync edge listeners.
+// - Add AcksenThermalGovernor, an optional over temperature governor with a filtered temperature, resume hysteresis, rate-of-change prediction, automatic resume and trip reasons
+// - Hold Pump Temperatures in integer hundredths of a degree, and add updatePumpTemperatureCentidegrees() to avoid floating point
+// - Add AcksenPumpProbes, for several temperature probes per pump with age/validity tracking, highest-valid or voted governing temperature, and batched updates from one sensor bus scan
+// - Add AcksenRelayGuard, an optional relay wear limiter with minimum ON/OFF dwell times, a token bucket cap on transitions, deferral/coalescing of requests and lifetime switch counters
+// - Add AcksenPumpNotifier, to run LCD reinitialisation (or other listeners, with context pointers) once after a quiet period following the last transition across all pumps.  Attached with attachNotifier()
+// - Add getConfig()/setConfig(), a versioned binary AcksenPumpConfig snapshot of the tuning settings, and AcksenPumpConfigStore for CRC-checked, wear-levelled EEPROM storage (AcksenPumpEeprom.h) or a host file (AcksenHostFileStorage)
+// - Add step(), to run a Pump as a task in a cooperative scheduler, returning a yield reason and the time to run it next
+// - Add AcksenPumpSim (host only), a time-warp simulator replaying scripted scenarios against pumps event-to-event on the virtual clock, with a transition timeline and invariant checks
+// - Add AcksenPumpTelemetry, encoding pump snapshots (unchanged fields left out) and events into compact binary frames with a sequence number and CRC, queued in a ring buffer drained without blocking, and AcksenPumpTelemetryDecoder
+// - Share one AcksenPhaseSync across any number of pumps and banks: transitions requested in the same half-cycle switch on the same edge, each after its own iPhaseSyncPreActivationDelay, including before the AcksenPhaseSync has locked
+// - A Non-Blocking Switching transition checked too late for its predicted switching time (beyond the AcksenPhaseSync jitter plus PHASE_SYNC_LATE_MARGIN_MICROS) is moved on to the next edge, rather than switched part way through the mains cycle
+// - Add AcksenPumpSupply, an inrush-aware start scheduler for pumps on a shared supply: per-pump start weights and priorities, a concurrent start budget, staggered release of queued OFF to ON transitions (Ventilation pulses included), queue depth and start latency
+// - Add AcksenTimerWheel, a hashed timer wheel with constant time arm, cancel and expiry checks.  AcksenPumpBank now runs all its Ventilation and Grain Rest deadlines through one, and only visits pumps whose deadline has expired
+// - Start periodic Grain Rests every iGrainRestPeriod minutes on AcksenPump and AcksenPumpBank, while bEnableGrainRest and mashing control are set and no temporary inhibit applies
+// - Add AcksenPrimeMonitor, for adaptive Pump Ventilation from flow meter pulses or pump current: Ventilation ends once flow is steady, extra cycles are added while an air lock persists, a dry run stops the Pump (PUMP_EVENT_DRY_RUN), and time to full flow is reported (PUMP_EVENT_PRIMED)
+//
 // v1.8.1	03 Mar 2023
 // - Add ability to reinitialise LCD displays after Pump Control operations, to help address corruption
 // - Correct typo in switchPumpNegativeLogic()
@@ -75,11 +113,36 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #ifndef AcksenPump_h
 #define AcksenPump_h
 
-#define AcksenPump_ver   181	///< Constant used to set the present library version. Can be used to ensure any code using this library, is correctly updated with necessary changes in subsequent versions, before compilation.
+#define AcksenPump_ver   190	///< Constant used to set the present library version. Can be used to ensure any code using this library, is correctly updated with necessary changes in subsequent versions, before compilation.
+
+#include "AcksenPumpHal.h"
+
+#include "AcksenPhaseSync.h"
+#include "AcksenPumpEvents.h"
+#include "AcksenPumpSequence.h"
+#include "AcksenThermalGovernor.h"
+#include "AcksenRelayGuard.h"
+#include "AcksenPumpSupply.h"
+#include "AcksenPrimeMonitor.h"
+#include "AcksenPumpNotifier.h"
+#include "AcksenPumpConfig.h"
+
+// *** BUILD OPTIONS ***
+#ifndef ACKSEN_PUMP_PROFILING
+#define ACKSEN_PUMP_PROFILING		0	///< Set to 1 (here, or using a compiler flag for the whole build) to compile in the profiling counters read by getProfile().
+#endif
+
+#ifndef ACKSEN_PUMP_LEGACY_FIELDS
+#define ACKSEN_PUMP_LEGACY_FIELDS	1	///< Set to 0 (here, or using a compiler flag for the whole build) for the compact public field layout, which fits PUMP_RAM_BUDGET but breaks sketches taking the address of a field, or using fPumpTemperature/dtVentStartTime/dtVentEndTime/dtGrainRestEndTime/dtGrainRestPeriodStartTime.
+#endif
+
+#ifndef ACKSEN_PUMP_ATTACHMENTS
+#define ACKSEN_PUMP_ATTACHMENTS		ACKSEN_PUMP_LEGACY_FIELDS	///< Set to 1 to compile in attachEventQueue(), attachThermalGovernor(), attachRelayGuard(), attachPrimeMonitor(), attachNotifier(), attachPhaseSync(), attachSupply(), setFlowPercent() and runSequence().  On by default with the v1.8 field layout, off with the compact layout.  Held outside PUMP_RAM_BUDGET when on.
+#endif
 
-#include <Time.h>
-#include <TimeLib.h>
-#include <Arduino.h>
+#ifndef ACKSEN_PUMP_VENT_MILLIS
+#define ACKSEN_PUMP_VENT_MILLIS		ACKSEN_PUMP_ATTACHMENTS	///< Set to 1 to compile in uiPumpVentilationOnLengthMillis and uiPumpVentilationOffLengthMillis (4 bytes, outside PUMP_RAM_BUDGET).  Follows ACKSEN_PUMP_ATTACHMENTS by default.
+#endif
 
 // *** PUMP CONSTANTS ***
 #define PUMP_POSITIVE_LOGIC_ON	    1	///< Output state for Pump in ON state, when positive logic is used.
@@ -108,6 +171,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #define PUMP_CONTROL_VENT							1	///< Pump State is presently Venting.
 #define PUMP_CONTROL_ON								2	///< Pump State is presently ON/Running.
 #define PUMP_CONTROL_GRAIN_REST						3	///< Pump State is presently in Grain Rest timeout.
+#define PUMP_CONTROL_SEQUENCE						4	///< Pump State is presently running a Sequence started by runSequence().
 
 // Pump Output States
 #define PUMP_OUTPUT_STATE_OFF					5	///< Set Pump Output to OFF.
@@ -123,19 +187,125 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #define MAX_GRAIN_REST_PERIOD					20	// Maximum Period between Grain Rests, in Minutes. To be used in configuration settings/menus for accompanying code, not directly utilised in library.
 
 #define ENABLE_GRAIN_REST_DEFAULT								true	///< Enable the Grain Rest system by default.
-#define TEMPORARY_INHIBIT_GRAIN_REST_AROUND_SET_POINT_DEFAULT	true	///< Do not allow Grain Rests to commence when close to the system Set Point, for heating/cooling systems. To be used by accompanying code, not directly utilised in library.
+#define TEMPORARY_INHIBIT_GRAIN_REST_AROUND_SET_POINT_DEFAULT	true	///< Do not allow periodic Grain Rests to commence when close to the system Set Point, for heating/cooling systems. While set, a rest that falls due after temporaryInhibitGrainRestAsAroundPreheatSetPoint() is held off (by processGrainRest(), or the AcksenPumpBank) until temporaryPermitGrainRestAsAroundPreheatSetPoint() is called.
 
 // Pump Operating Temperature
 #define MAX_PUMP_TEMP_DEFAULT					93		///< Maximum Pump Operating Temperature, in Celsius.  Pump will cease to function above this limit to prevent damage.
 #define ENABLE_MAX_PUMP_TEMP_DEFAULT			true	///< Enable checking of Pump Temperature (set by calling updatePumpTemperature()) against Maximum Pump Operating Temperature. 
+#define PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES	32767	///< Temperature stored for a NaN or out of range reading (e.g. a failed thermocouple), in hundredths of a degree Celsius.  Trips the Maximum Pump Temperature check.
 
 #define PUMP_RELAY_SWITCHING_DELAY					200	///< Add a delay after switching the Pump output state, to allow for relay settling, in Milliseconds.
+#define PUMP_NON_BLOCKING_SWITCHING_DEFAULT			false	///< Use Non-Blocking Switching by default.  When disabled, the Relay Switching Delay and Phase Sync wait are applied using delay()/busy-waits, as in previous library versions.
+
+// Pump Switching Sub-States (used when Non-Blocking Switching is enabled)
+#define PUMP_SWITCH_STATE_SETTLED					0	///< No Pump Output transition is in progress.
+#define PUMP_SWITCH_STATE_PENDING					1	///< A Pump Output transition has been queued, and is waiting for the Voltage Phase Sync (if enabled) before being applied.
+#define PUMP_SWITCH_STATE_SETTLING					2	///< The Pump Output has been switched, and the Relay Switching Delay is running.
 
 #define PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT		0	// Default delay after detecting Voltage Zero Crossing and switching Relay ON/OFF State, in Milliseconds.
 #define PHASE_SYNC_PRE_ACTIVATION_DELAY_MAX			9	// Minimum delay after detecting Voltage Zero Crossing and switching Relay ON/OFF State, in Milliseconds. To be used in configuration settings/menus for accompanying code, not directly utilised in library.
 #define PHASE_SYNC_PRE_ACTIVATION_DELAY_MIN			0	// Maximum delay after detecting Voltage Zero Crossing and switching Relay ON/OFF State, in Milliseconds. To be used in configuration settings/menus for accompanying code, not directly utilised in library.
+#define PUMP_NEXT_EVENT_IDLE_INTERVAL				60000	///< Interval reported by nextEventMillis() when no Pump deadline is scheduled, in Milliseconds.
+
+// Task Yield Reasons (returned by step())
+#define PUMP_YIELD_IDLE								0	///< Nothing scheduled.  Wake at the returned time, or sooner after an input change (ToggleState(), updatePumpTemperature(), etc).
+#define PUMP_YIELD_READY							1	///< More work is due now - call step() again as soon as possible.
+#define PUMP_YIELD_SEQUENCE_STEP					2	///< Waiting for the end of the present Sequence step (Ventilation phase, Grain Rest, etc).
+#define PUMP_YIELD_PHASE_SYNC						3	///< Waiting for the Voltage Phase Sync Zero Crossing (and pre-activation delay) before switching.
+#define PUMP_YIELD_SETTLING							4	///< Waiting for the Relay Switching Delay after switching.
+#define PUMP_YIELD_RELAY_GUARD						5	///< Waiting for an AcksenRelayGuard to allow a deferred transition.
+#define PUMP_YIELD_SUPPLY							6	///< Waiting in an AcksenPumpSupply start queue.
+
+#define PHASE_SYNC_TIMEOUT							20	///< Maximum time to wait for each Voltage Phase Sync input level, in Milliseconds.
 #define PHASE_SYNC_ENABLED_DEFAULT					false	///< Allow the Pump ON/OFF Switching to be synchronised with a Voltage Zero Crossing detector input, to minimise electrical issues when switching an SSR or Relay for an AC Pump.
 
+// Burst-Fire Flow Control
+#define PUMP_FLOW_PERCENT_FULL						100		///< Flow Percentage for full, continuous Pump Output.
+#define PUMP_BURST_FIRE_INACTIVE					0xFF	///< Burst-Fire edge handler is not driving the Pump Output.
+
+// Pins
+#define PUMP_PIN_NONE								0xFF	///< Pin number stored for a pin that is not used (-1).
+
+// Running Sequence
+#define PUMP_SEQUENCE_NONE							0	///< No Sequence is running.
+#define PUMP_SEQUENCE_VENTILATION					1	///< Running AcksenPumpVentilationSequence.
+#define PUMP_SEQUENCE_GRAIN_REST					2	///< Running AcksenPumpGrainRestSequence.
+#define PUMP_SEQUENCE_CUSTOM						3	///< Running the Sequence given to runSequence().
+
+// RAM Budget, per AcksenPump instance (excluding profiling counters, attachments and the millisecond Ventilation lengths) - checked at compile time for the compact layout
+#if defined(__AVR__)
+#define PUMP_RAM_BUDGET								32	///< Maximum size of an AcksenPump instance on AVR, in Bytes.
+#else
+#define PUMP_RAM_BUDGET								(32 + sizeof(void *) + (2 * sizeof(unsigned long)))	///< Maximum size of an AcksenPump instance, in Bytes, allowing for wider pointers, longs and alignment.
+#endif
+
+// Profiling
+#define PUMP_PROFILE_HISTOGRAM_BINS				16	///< Number of log2 bins in the process() duration histogram.
+
+/**************************************************************************/
+/*!
+    @brief  Convert a temperature reading to hundredths of a degree Celsius, as stored by every pump.  Truncates, so whole degree limits compare exactly.
+    @param  fTemperature
+            Temperature, in Celsius.
+    @return Temperature, in hundredths of a degree Celsius.  PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES if the reading is NaN, or outside +/-327.67C.
+*/
+/**************************************************************************/
+int16_t AcksenPumpCentidegrees(float fTemperature);
+
+/**************************************************************************/
+/*!
+    @brief  Convert a Maximum Pump Temperature to hundredths of a degree Celsius, without overflowing 16-bit int.  Limits beyond +/-327C are
+			clamped to 327C, so PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES still trips the check.
+    @param  lDegrees
+            Temperature limit, in Celsius.
+    @return Temperature limit, in hundredths of a degree Celsius.
+*/
+/**************************************************************************/
+int16_t AcksenPumpLimitCentidegrees(long lDegrees);
+
+/**************************************************************************/
+/*! 
+    @brief  Profiling counters for a Pump, read using getProfile().  All times are in Microseconds.
+*/
+/**************************************************************************/
+struct AcksenPumpProfile
+{
+	unsigned long ulProcessCalls;					///< Number of process() calls.
+	unsigned long ulProcessMinMicros;				///< Shortest process() call.
+	unsigned long ulProcessMaxMicros;				///< Longest process() call.
+	unsigned long ulProcessTotalMicros;				///< Total time spent in process().  Divide by ulProcessCalls for the mean.
+	unsigned int uiProcessHistogram[PUMP_PROFILE_HISTOGRAM_BINS];	///< process() durations by bit length: bin 0 holds 0us, bin n holds 2^(n-1) to (2^n)-1 us, and the last bin holds everything longer.
+	unsigned long ulRelaySwitchingDelayMicros;		///< Total time spent blocked in the Relay Switching Delay.
+	unsigned long ulPhaseSyncWaitMicros;			///< Total time spent blocked waiting for Voltage Phase Sync.
+	unsigned int uiPinTimeouts;						///< Number of Phase Sync input waits that timed out.
+	unsigned long ulRelayTransitions;				///< Number of Pump Output level changes.
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Optional components attached to an AcksenPump, and the state only they use.  Compiled in when ACKSEN_PUMP_ATTACHMENTS is 1.
+*/
+/**************************************************************************/
+struct AcksenPumpAttachments
+{
+	AcksenPumpEventQueue *pEventQueue = NULL;			///< Set by attachEventQueue().
+	AcksenThermalGovernor *pThermalGovernor = NULL;		///< Set by attachThermalGovernor().
+	AcksenRelayGuard *pRelayGuard = NULL;				///< Set by attachRelayGuard().
+	AcksenPrimeMonitor *pPrimeMonitor = NULL;			///< Set by attachPrimeMonitor().
+	AcksenPumpNotifier *pNotifier = NULL;				///< Set by attachNotifier().
+	AcksenPhaseSync *pPhaseSync = NULL;					///< Set by attachPhaseSync().
+	AcksenPumpSupply *pSupply = NULL;					///< Set by attachSupply().
+	const AcksenPumpStep *pSequence = NULL;				///< Sequence given to runSequence() (in PROGMEM).
+	unsigned long ulPhaseSyncMicros = 0;				///< While a transition waits for pPhaseSync: micros() it was queued, or of the shared or predicted Zero Crossing plus delay.
+	AcksenHal::FastPin fpPumpOutput;					///< Pump Output, resolved once for direct port access (also used by the Burst-Fire edge handler).
+	uint8_t ui8EventPumpId = 0;							///< Id recorded with each event.
+	uint8_t ui8FlowPercent = PUMP_FLOW_PERCENT_FULL;	///< Set by setFlowPercent().
+	volatile uint8_t ui8BurstFlowPercent = PUMP_BURST_FIRE_INACTIVE;	///< Read by the Burst-Fire edge handler.  PUMP_BURST_FIRE_INACTIVE when it must leave the output alone.
+	uint8_t ui8BurstAccumulator = 0;					///< Only accessed by the Burst-Fire edge handler, once active.
+	bool bPhaseSyncPredicted = false;					///< ulPhaseSyncMicros holds the switching time.
+	bool bBurstFireListening = false;					///< The Burst-Fire edge handler is registered with pPhaseSync.
+};
+
 /**************************************************************************/
 /*! 
     @brief  Class that defines the AcksenPump state and functions
@@ -147,45 +317,85 @@ class AcksenPump
 public:
 
 	// Variables
-	int iPumpOnState = PUMP_POSITIVE_LOGIC_ON;		///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
-	int iPumpOffState = PUMP_POSITIVE_LOGIC_OFF;	///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
+#if ACKSEN_PUMP_LEGACY_FIELDS == 0
+	// Compact layout.  Flags and small enumerations are held in bitfields, and initialised by the constructor.
+	uint8_t iOutputStateRequested : 3;			///< Pump Output State that has been Requested
+	uint8_t iOutputStateActual : 3;				///< Actual Pump Output State presently
+	uint8_t iPumpOnState : 1;					///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
+	uint8_t iPumpOffState : 1;					///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
+	uint8_t iControlState : 3;					///< Pump Control State
+	uint8_t iOperatingMode : 1;					///< Pump Operating Mode
+
+	bool bEnablePumpVentilation : 1;			///< Enable/Disable Pump Ventilation system on pump startup
+	bool bEnableMaxPumpTemperature : 1;			///< Enable the Maximum Pump Temperature monitoring system
+	bool bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint : 1;	///< Flag used to let calling code know if the Pump is presently inhibiting a Grain Rest due to being close to Set Point for Temp Control.
+	bool bEnableGrainRest : 1;					///< Enable the Grain Rest system.
+	bool bEnableInhibitGrainRestAroundSetPoint : 1;	///< Hold off periodic Grain Rests while temporaryInhibitGrainRestAsAroundPreheatSetPoint() is in effect, around the Set Point for Temperature Control.
+	bool bEnablePhaseSync : 1;					///< Enable the Voltage Phase Sync system for Zero Crossing Detection when switching Pump Output State ON/OFF.
+	bool bCurrentlyControllingMashing : 1;		///< Set when the Pump is being used for controlling Grain Mashing for Brewing.
+	bool bNonBlockingSwitching : 1;				///< Advance Pump Output transitions (Phase Sync wait and Relay Switching Delay) from process() using millis() deadlines, rather than blocking.  Set by step().
+
+	uint8_t iPumpVentilationCycles = PUMP_VENTILATION_CYCLE_COUNT_DEFAULT;	///< Number of Pump Ventilation ON/OFF cycles on startup
+	uint8_t iPumpVentilationOnLength = PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT;	///< Length of Pump being set to ON during Ventilation Cycle, in Seconds.
+	uint8_t iPumpVentilationOffLength = PUMP_VENTILATION_CYCLE_OFF_TIME_DEFAULT;///< Length of Pump being set to OFF during Ventilation Cycle, in Seconds.
+#if ACKSEN_PUMP_VENT_MILLIS
+	uint16_t uiPumpVentilationOnLengthMillis = 0;	///< Length of Pump being set to ON during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOnLength when non-zero.
+	uint16_t uiPumpVentilationOffLengthMillis = 0;	///< Length of Pump being set to OFF during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOffLength when non-zero.
+#endif
+	uint8_t iVentilationCycleRuntimeCount = 0;		///< Number of loop passes completed in the running Sequence (e.g. Pump Ventilation Cycles executed in present Ventilation phase)
+
+	uint8_t iGrainRestLength = GRAIN_REST_LENGTH_DEFAULT;	///< Length of Grain Rest (how long pump will be OFF for, before restarting), in Minutes.
+	uint8_t iGrainRestPeriod = GRAIN_REST_PERIOD_DEFAULT;	///< Interval Period between the start of periodic Grain Rests, in Minutes.  0 disables periodic Grain Rests.
+
+	uint8_t iMaxPumpTemperature = MAX_PUMP_TEMP_DEFAULT;	///< Maximum Pump Operating Temperature, in Celsius.  Pump will be disabled above this level.
+
+	uint8_t iPhaseSyncPreActivationDelay = PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT;	///< Delay between detecting Zero Crossing, and changing Pump Output State, in Milliseconds.
+
+	uint16_t iPumpRelaySwitchingDelay = PUMP_RELAY_SWITCHING_DELAY;	///< Delay added after switching Pump Output ON/OFF, to allow for relay settling, in Milliseconds.
+#else
+	// v1.8 layout, so the address of any field can be taken
+	int iOutputStateRequested;					///< Pump Output State that has been Requested
+	int iOutputStateActual;						///< Actual Pump Output State presently
+	int iPumpOnState;							///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
+	int iPumpOffState;							///< Define the Output State that is set when Pump is ON.  Positive Logic (0=OFF, 1=ON) by default, Can be overrided for Negative logic.
+	int iControlState;							///< Pump Control State
+	int iOperatingMode;							///< Pump Operating Mode
+
+	bool bEnablePumpVentilation;				///< Enable/Disable Pump Ventilation system on pump startup
+	bool bEnableMaxPumpTemperature;				///< Enable the Maximum Pump Temperature monitoring system
+	bool bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint;	///< Flag used to let calling code know if the Pump is presently inhibiting a Grain Rest due to being close to Set Point for Temp Control.
+	bool bEnableGrainRest;						///< Enable the Grain Rest system.
+	bool bEnableInhibitGrainRestAroundSetPoint;	///< Hold off periodic Grain Rests while temporaryInhibitGrainRestAsAroundPreheatSetPoint() is in effect, around the Set Point for Temperature Control.
+	bool bEnablePhaseSync;						///< Enable the Voltage Phase Sync system for Zero Crossing Detection when switching Pump Output State ON/OFF.
+	bool bCurrentlyControllingMashing;			///< Set when the Pump is being used for controlling Grain Mashing for Brewing.
+	bool bNonBlockingSwitching;					///< Advance Pump Output transitions (Phase Sync wait and Relay Switching Delay) from process() using millis() deadlines, rather than blocking.  Set by step().
 
-	bool bEnablePumpVentilation = PUMP_VENTILATION_ENABLED_DEFAULT;	///< Enable/Disable Pump Ventilation system on pump startup
 	int iPumpVentilationCycles = PUMP_VENTILATION_CYCLE_COUNT_DEFAULT;	///< Number of Pump Ventilation ON/OFF cycles on startup
 	int iPumpVentilationOnLength = PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT;	///< Length of Pump being set to ON during Ventilation Cycle, in Seconds.
 	int iPumpVentilationOffLength = PUMP_VENTILATION_CYCLE_OFF_TIME_DEFAULT;///< Length of Pump being set to OFF during Ventilation Cycle, in Seconds.
+#if ACKSEN_PUMP_VENT_MILLIS
+	uint16_t uiPumpVentilationOnLengthMillis = 0;	///< Length of Pump being set to ON during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOnLength when non-zero.
+	uint16_t uiPumpVentilationOffLengthMillis = 0;	///< Length of Pump being set to OFF during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOffLength when non-zero.
+#endif
+	int iVentilationCycleRuntimeCount = 0;			///< Number of loop passes completed in the running Sequence (e.g. Pump Ventilation Cycles executed in present Ventilation phase)
 
-	int iOperatingMode = PUMP_OPERATING_MODE_OFF;		///< Pump Operating Mode
-	int iControlState = PUMP_CONTROL_STOP;				///< Pump Control State
-	int iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;	///< Pump Output State that has been Requested
-	int iOutputStateActual = PUMP_OUTPUT_STATE_OFF;		///< Actual Pump Output State presently
-	int iVentilationCycleRuntimeCount;					///< Number of Pump Ventilation Cycles that have been executed in present Ventilation phase
+	time_t dtVentEndTime = 0;							///< Time the present Pump Ventilation ON/OFF phase will end.  Set when the phase starts, for display only - same as ventEndTime() at that point.
+	time_t dtVentStartTime = 0;							///< Time the present Pump Ventilation ON/OFF phase started.  For display only.
+	time_t dtGrainRestEndTime = 0;						///< Time that the present Grain Rest will end.  Set when PUMP_CONTROL_GRAIN_REST is entered, for display only - the rest lasts iGrainRestLength minutes on millis().
+	time_t dtGrainRestPeriodStartTime = 0;				///< Time the next periodic Grain Rest is due.  For display only - the check itself runs on millis().
 
-	time_t dtVentEndTime, dtVentStartTime;				///< Start/End Time for present Pump Ventilation Phase
-	time_t dtGrainRestEndTime;							///< Time that next Grain Rest will execute
-	time_t dtGrainRestPeriodStartTime;					///> Start Time for the present Grain Rest phase
+	int iGrainRestLength = GRAIN_REST_LENGTH_DEFAULT;	///< Length of Grain Rest (how long pump will be OFF for, before restarting), in Minutes.
+	int iGrainRestPeriod = GRAIN_REST_PERIOD_DEFAULT;	///< Interval Period between the start of periodic Grain Rests, in Minutes.  0 disables periodic Grain Rests.
 
-	int iGrainRestLength = GRAIN_REST_LENGTH_DEFAULT;	///< Length of Grain Rest (how long pump will be OFF for, before restarting)
-	int iGrainRestPeriod = GRAIN_REST_PERIOD_DEFAULT;	///< Interval Period between Grain Rests
-	
-	bool bEnableMaxPumpTemperature = ENABLE_MAX_PUMP_TEMP_DEFAULT;	///< Enable the Maximum Pump Temperature monitoring system
-	int iMaxPumpTemperature = MAX_PUMP_TEMP_DEFAULT;	///< Maximum Pump Operating Temperature.  Pump will be disabled above this level.
-	
-	float fPumpTemperature;								///< The present operating temperature of the Pump.  Updated using updatePumpTemperature() with the reading from a measurement probe.
+	int iMaxPumpTemperature = MAX_PUMP_TEMP_DEFAULT;	///< Maximum Pump Operating Temperature, in Celsius.  Pump will be disabled above this level.
+	float fPumpTemperature = 0.0f;						///< The present operating temperature of the Pump.  Updated using updatePumpTemperature() with the reading from a measurement probe, or written directly (picked up by the next process()).
 
-	bool bTempFlagForInhibitGrainRestAsAroundPreheatSetPoint = true;	///< Flag used to let calling code know if the Pump is presently inhibiting a Grain Rest due to being close to Set Point for Temp Control.
-	
-	bool bEnableGrainRest = ENABLE_GRAIN_REST_DEFAULT;	///< Enable the Grain Rest system.
-	bool bEnableInhibitGrainRestAroundSetPoint = TEMPORARY_INHIBIT_GRAIN_REST_AROUND_SET_POINT_DEFAULT;///< Inhibit the operation of the Grain Rest System around the Set Point for Temperature Control.
-	
-	bool bEnablePhaseSync = PHASE_SYNC_ENABLED_DEFAULT;	///> Enable the Voltage Phase Sync system for Zero Crossing Detection when switching Pump Output State ON/OFF.
-	int iPhaseSyncPreActivationDelay = PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT;	///< Delay between detecting Zero Crossing, and changing Pump Output State.
+	int iPhaseSyncPreActivationDelay = PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT;	///< Delay between detecting Zero Crossing, and changing Pump Output State, in Milliseconds.
 
-	bool bCurrentlyControllingMashing = false;	///< Set when the Pump is being used for controlling Grain Mashing for Brewing.
-	
-	int iPumpRelaySwitchingDelay = PUMP_RELAY_SWITCHING_DELAY;	///< Delay added after switching Pump Output ON/OFF, to allow for relay settling.
+	int iPumpRelaySwitchingDelay = PUMP_RELAY_SWITCHING_DELAY;	///< Delay added after switching Pump Output ON/OFF, to allow for relay settling, in Milliseconds.
+#endif
 
-	void (*callbackInitLCDs)();	///< Callback to allow reinitialisation of any attached LCD displays after Pump Output Change.  Used to combat display corruption due to system noise with relay/solenoid operations during Pump Control.
+	void (*callbackInitLCDs)() = NULL;	///< Callback to allow reinitialisation of any attached LCD displays after Pump Output Change.  Used to combat display corruption due to system noise with relay/solenoid operations during Pump Control.
 	
 /**************************************************************************/
 /*!
@@ -207,10 +417,25 @@ public:
 */
 /**************************************************************************/
 	void ToggleState();
-	
+
+#if ACKSEN_PUMP_ATTACHMENTS
+/**************************************************************************/
+/*!
+    @brief 	Turn the Pump ON, running the given Sequence (see AcksenPumpSequence.h).  Ignored if the Pump is above the Maximum Pump Temperature.
+    @param  pSequence
+            Sequence steps, stored in PROGMEM.  Must remain valid while the Sequence runs.
+    @return No return value.
+*/
+/**************************************************************************/
+	void runSequence(const AcksenPumpStep *pSequence);
+
+#endif
+
 /**************************************************************************/
 /*!
     @brief  Reset the start time of the next Grain Rest, based on the Grain Rest Period that has been set
+			Periodic Grain Rests start from PUMP_CONTROL_ON, while bEnableGrainRest and bCurrentlyControllingMashing are set, and no temporary inhibit applies.
+			A rest falling due while not allowed starts as soon as it is.
     @return No return value.
 */
 /**************************************************************************/
@@ -219,23 +444,105 @@ public:
 /**************************************************************************/
 /*!
     @brief  Process any updates to automatic Pump operations, including Max Temperature check, running Grain Rests and Pump Ventilation.  This should be called regularly.
+			Returns immediately if no deadline has expired and no input has changed (see nextEventMillis()).
     @return No return value.
 */
 /**************************************************************************/
 	void process();
 	
+/**************************************************************************/
+/*!
+    @brief  Get the time at which process() next has work to do (end of a Ventilation phase, Grain Rest or relay settling window).
+			Hosts can sleep until this time, or until an input changes (ToggleState(), updatePumpTemperature(), etc).
+    @return millis() time of the next deadline.  Equal to millis() if process() should be called again immediately.
+*/
+/**************************************************************************/
+	unsigned long nextEventMillis();
+
+/**************************************************************************/
+/*!
+    @brief  Run the Pump as a task in a cooperative scheduler.  Advances the Pump as far as possible without blocking, then yields.
+			Side effect: sets bNonBlockingSwitching to true, and leaves it set.  From the first call on, no call (including turnOff() and
+			process() outside step()) blocks for the Phase Sync wait or Relay Switching Delay - output changes are queued and applied by later passes.
+    @param  ulWakeMillis
+            Receives the millis() time the task should next be run, as nextEventMillis().
+    @return Reason for yielding - PUMP_YIELD_IDLE, PUMP_YIELD_READY, PUMP_YIELD_SEQUENCE_STEP, PUMP_YIELD_PHASE_SYNC, PUMP_YIELD_SETTLING, PUMP_YIELD_RELAY_GUARD or PUMP_YIELD_SUPPLY.
+*/
+/**************************************************************************/
+	uint8_t step(unsigned long &ulWakeMillis);
+	
 /**************************************************************************/
 /*!
     @brief  Set the Pump Temperature, using an external temperature reading.  This is used by the Maximum Pump Temperature supervisory system.
+			NaN or out of range readings (e.g. from a failed thermocouple) are stored as PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES, stopping the Pump.
     @return No return value.
 */
 /**************************************************************************/
 	void updatePumpTemperature(float fNewPumpTemperature);
 
+/**************************************************************************/
+/*!
+    @brief  Set the Pump Temperature, using an integer temperature reading.  Avoids floating point, and can be fed from AcksenPumpProbes.
+    @param  iCentidegrees
+            Temperature, in hundredths of a degree Celsius.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updatePumpTemperatureCentidegrees(int16_t iCentidegrees);
+
+/**************************************************************************/
+/*!
+    @brief  Get the Pump Temperature last set by updatePumpTemperature().  Replaces the fPumpTemperature field.
+    @return Pump Temperature, in Celsius, to 0.01C resolution.
+*/
+/**************************************************************************/
+	float pumpTemperature();
+
+/**************************************************************************/
+/*!
+    @brief  Get the Pump Temperature last set, without floating point.
+    @return Pump Temperature, in hundredths of a degree Celsius.
+*/
+/**************************************************************************/
+	int16_t pumpTemperatureCentidegrees();
+
+/**************************************************************************/
+/*!
+    @brief  Get the wall clock time the present Pump Ventilation ON/OFF phase started.  Also held in the dtVentStartTime field, unless ACKSEN_PUMP_LEGACY_FIELDS is 0.
+    @return Wall clock time, or 0 if the Pump is not Venting.
+*/
+/**************************************************************************/
+	time_t ventStartTime();
+
+/**************************************************************************/
+/*!
+    @brief  Get the wall clock time the present Pump Ventilation ON/OFF phase will end.  Also held in the dtVentEndTime field, unless ACKSEN_PUMP_LEGACY_FIELDS is 0.
+    @return Wall clock time, or 0 if the Pump is not Venting.
+*/
+/**************************************************************************/
+	time_t ventEndTime();
+
+/**************************************************************************/
+/*!
+    @brief  Get the wall clock time the present Grain Rest will end.  The dtGrainRestEndTime field is also set when a Grain Rest starts, unless ACKSEN_PUMP_LEGACY_FIELDS is 0.
+    @return Wall clock time, or 0 if no Grain Rest is running.
+*/
+/**************************************************************************/
+	time_t grainRestEndTime();
+
+/**************************************************************************/
+/*!
+    @brief  Get the wall clock time the next periodic Grain Rest is due.  Also held in the dtGrainRestPeriodStartTime field, unless ACKSEN_PUMP_LEGACY_FIELDS is 0.
+    @return Wall clock time.  The present time if the Grain Rest is overdue, waiting until it is allowed.
+*/
+/**************************************************************************/
+	time_t grainRestPeriodStartTime();
+
 
 /**************************************************************************/
 /*!
     @brief  Used to determine if the Actual Output State of the Pump, doesn't match the Requested Output State.
+			Only reports that a change happened - use attachEventQueue() to receive every individual transition.
     @return Returns true if the state changed.
 			Returns false if the state did not change.
 */
@@ -286,12 +593,35 @@ public:
 	
 /**************************************************************************/
 /*!
-    @brief  Set the Pump output to use Negative Logic (0=ON, 1=OFF) for control.
+    @brief  Set the Pump output to use Negative Logic (0=ON, 1=OFF) for control.  The output is rewritten straight away, so the Pump stays in its present ON/OFF state.
     @return No return value.
 */
 /**************************************************************************/
 	void switchPumpNegativeLogic(void);
 
+/**************************************************************************/
+/*!
+    @brief  Take a snapshot of the tuning settings (Ventilation, Grain Rest, Maximum Pump Temperature, logic, switching and Phase Sync), e.g. for AcksenPumpConfigStore.
+			Each setting is stored in the AcksenPumpConfig field width: 0 to 65535 for iPumpRelaySwitchingDelay, and 0 to 255 for the others.
+			With the v1.8 layout (ACKSEN_PUMP_LEGACY_FIELDS) these are int, so values outside that range are saturated to it.
+    @param  cfConfig
+            Receives the settings.
+    @return No return value.
+*/
+/**************************************************************************/
+	void getConfig(AcksenPumpConfig &cfConfig);
+
+/**************************************************************************/
+/*!
+    @brief  Apply a snapshot taken by getConfig().  If the output logic changes, the Pump Output is rewritten at the new level for its present state.
+			If the snapshot turns Non-Blocking Switching off while a transition is in progress, the transition is completed first (blocking).
+    @param  cfConfig
+            Settings to apply.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setConfig(const AcksenPumpConfig &cfConfig);
+
 /**************************************************************************/
 /*!
     @brief  Callback function to reinitialise any attached LCD displays (or other sensitive elements).
@@ -300,15 +630,268 @@ public:
 /**************************************************************************/
 	void launchCallbackInitLCDs();
 
+/**************************************************************************/
+/*!
+    @brief  Get the present Pump Switching Sub-State.  Only used when Non-Blocking Switching is enabled.
+    @return PUMP_SWITCH_STATE_SETTLED, PUMP_SWITCH_STATE_PENDING or PUMP_SWITCH_STATE_SETTLING.
+*/
+/**************************************************************************/
+	int switchingState();
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a Pump Output transition is still in progress.
+    @return Returns true if the Pump Output has settled, and no transition is pending.
+			Returns false if a transition is pending, or the relay is still settling.
+*/
+/**************************************************************************/
+	bool switchingSettled();
+
+/**************************************************************************/
+/*!
+    @brief  Get the time remaining until the present relay settling window ends.
+    @return Time remaining in Milliseconds.  Returns 0 if the relay is not presently settling.
+*/
+/**************************************************************************/
+	unsigned long settlingTimeRemaining();
+
+/**************************************************************************/
+/*!
+    @brief  Get the proportional Pump flow set by setFlowPercent().
+    @return Flow Percentage, 0 to 100.  Always PUMP_FLOW_PERCENT_FULL unless ACKSEN_PUMP_ATTACHMENTS is 1.
+*/
+/**************************************************************************/
+	uint8_t flowPercent();
+
+#if ACKSEN_PUMP_ATTACHMENTS
+/**************************************************************************/
+/*!
+    @brief  Use an interrupt-driven AcksenPhaseSync for Voltage Phase Sync, rather than polling the Phase Sync input pin.
+			Once the AcksenPhaseSync is locked to the mains supply, switching is scheduled for the predicted Zero Crossing.
+			One AcksenPhaseSync can be shared by any number of pumps (and AcksenPumpBanks) on the same supply.  Transitions requested in the same half-cycle
+			all switch on the same edge, each after its own iPhaseSyncPreActivationDelay, so N transitions cost one Zero Crossing wait.
+    @param  pPhaseSync
+            Pointer to an AcksenPhaseSync that has been started with begin().  Set to NULL to revert to polling.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachPhaseSync(AcksenPhaseSync *pPhaseSync);
+
+/**************************************************************************/
+/*!
+    @brief  Set the proportional Pump flow, using Burst-Fire control of whole mains cycles.
+			Whenever the Pump Output is ON, an attached and locked AcksenPhaseSync switches the output at each Zero Crossing, spreading the ON cycles evenly.
+			Without a locked AcksenPhaseSync the Pump runs at full flow.  Requires a zero-crossing SSR, not a mechanical relay.
+    @param  ui8Percent
+            Flow Percentage, 0 to 100 (PUMP_FLOW_PERCENT_FULL).  Values above 100 are treated as 100.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setFlowPercent(uint8_t ui8Percent);
+
+/**************************************************************************/
+/*!
+    @brief  Record Pump events (output changes, control state changes, over temperature trips and Phase Sync timeouts) in an AcksenPumpEventQueue.
+			One queue can be shared by several pumps, as long as they are all processed from the same context.
+    @param  pEventQueue
+            Pointer to the queue.  Set to NULL to stop recording events.
+    @param  ui8PumpId
+            Id recorded with each event from this pump.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachEventQueue(AcksenPumpEventQueue *pEventQueue, uint8_t ui8PumpId);
+
+/**************************************************************************/
+/*!
+    @brief  Use an AcksenThermalGovernor for the Maximum Pump Temperature check, as well as comparing each reading directly.  A reading at the limit still stops the Pump
+			immediately, and the governor can stop it earlier (prediction) and keep it stopped until cooled (hysteresis and resume delay).
+			Readings given to updatePumpTemperature() are passed on to it, along with iMaxPumpTemperature.  bEnableMaxPumpTemperature still enables/disables the check.
+    @param  pThermalGovernor
+            Pointer to the governor.  Set to NULL to revert to the direct check.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachThermalGovernor(AcksenThermalGovernor *pThermalGovernor);
+
+/**************************************************************************/
+/*!
+    @brief  Limit how often the Pump Output can switch, using an AcksenRelayGuard.  Transitions are deferred until allowed, and cancelled if the request is reversed meanwhile.
+			turnOff() and over temperature stops are never deferred.
+    @param  pRelayGuard
+            Pointer to the guard.  Set to NULL to remove the limits.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachRelayGuard(AcksenRelayGuard *pRelayGuard);
+
+/**************************************************************************/
+/*!
+    @brief  Schedule Pump starts on a shared supply, using an AcksenPumpSupply.  OFF to ON transitions (including Ventilation pulses) wait until the supply releases them.
+			Usually called by AcksenPumpSupply::addPump().  OFF transitions are never delayed.
+    @param  pSupply
+            Pointer to the supply.  Set to NULL to start without waiting.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachSupply(AcksenPumpSupply *pSupply);
+
+/**************************************************************************/
+/*!
+    @brief  Adapt Pump Ventilation to a flow meter or pump current, using an AcksenPrimeMonitor.  Ventilation ends as soon as the Pump is primed,
+			gains up to ui8MaxExtraCycles more cycles while an air lock persists, and stops the Pump (raising PUMP_EVENT_DRY_RUN) if it never primes.
+    @param  pPrimeMonitor
+            Pointer to the monitor.  Set to NULL for fixed Ventilation.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachPrimeMonitor(AcksenPrimeMonitor *pPrimeMonitor);
+
+/**************************************************************************/
+/*!
+    @brief  Notify an AcksenPumpNotifier of each Pump Output transition, as well as calling callbackInitLCDs.  One notifier can be attached to any number of pumps.
+    @param  pNotifier
+            Pointer to the notifier.  Set to NULL to stop notifying it.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachNotifier(AcksenPumpNotifier *pNotifier);
+
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Read the profiling counters.  Only collected when ACKSEN_PUMP_PROFILING is set to 1.
+    @param  pfProfile
+            Receives a copy of the counters.  Zeroed when profiling is not compiled in.
+    @return No return value.
+*/
+/**************************************************************************/
+	void getProfile(AcksenPumpProfile &pfProfile);
+
+/**************************************************************************/
+/*!
+    @brief  Reset the profiling counters.
+    @return No return value.
+*/
+/**************************************************************************/
+	void resetProfile();
+
 protected: 
 	
-	int _iPumpOutputPin;
-	int _iPhaseSyncInputPin;
+	// Pin numbers, or PUMP_PIN_NONE
+	uint8_t _ui8PumpOutputPin;
+	uint8_t _ui8PhaseSyncInputPin;
+	
+	void writeOutput(int iLevel);
+	void writeOutputLevel(int iLevel);
+	void setOutputLogic(bool bNegativeLogic);
+	
+#if ACKSEN_PUMP_ATTACHMENTS
+	AcksenPumpAttachments _atAttachments;
+	
+	AcksenPumpEventQueue *eventQueue() { return this->_atAttachments.pEventQueue; }
+	AcksenThermalGovernor *thermalGovernor() { return this->_atAttachments.pThermalGovernor; }
+	AcksenRelayGuard *relayGuard() { return this->_atAttachments.pRelayGuard; }
+	AcksenPrimeMonitor *primeMonitor() { return this->_atAttachments.pPrimeMonitor; }
+	AcksenPumpNotifier *notifier() { return this->_atAttachments.pNotifier; }
+	AcksenPhaseSync *phaseSync() { return this->_atAttachments.pPhaseSync; }
+	AcksenPumpSupply *supply() { return this->_atAttachments.pSupply; }
+	
+	static void PHASE_SYNC_ISR_ATTR burstFireEdge(void *pContext);
+	void updateBurstFire();
+	void stopBurstFire();
+#else
+	// Compiled out - checks against NULL fold away
+	AcksenPumpEventQueue *eventQueue() { return NULL; }
+	AcksenThermalGovernor *thermalGovernor() { return NULL; }
+	AcksenRelayGuard *relayGuard() { return NULL; }
+	AcksenPrimeMonitor *primeMonitor() { return NULL; }
+	AcksenPumpNotifier *notifier() { return NULL; }
+	AcksenPhaseSync *phaseSync() { return NULL; }
+	AcksenPumpSupply *supply() { return NULL; }
+#endif
+	
+	void raiseEvent(uint8_t ui8Type, int iValue);
+	
+#if ACKSEN_PUMP_PROFILING
+	AcksenPumpProfile _pfProfile;
+	
+	void recordProcessTime(unsigned long ulMicros);
+#endif
+
+	void recordControlState();
+	
+	// End of the present Sequence step (Ventilation ON/OFF phase, Grain Rest, etc)
+	unsigned long _ulPhaseEndMillis = 0;
+	
+	// Next periodic Grain Rest.  Ignored once _bGrainRestOverdue is set.
+	unsigned long _ulGrainRestDueMillis = 0;
+	
+	int16_t _iPumpTemperatureCenti = 0;		// Pump Temperature, in hundredths of a degree Celsius
+
+#if ACKSEN_PUMP_LEGACY_FIELDS
+	// Last value written to fPumpTemperature by the library.  Bitwise compared with the field each process(), to pick up direct writes without float maths.
+	float _fPumpTemperatureWritten = 0.0f;
+#endif
+	
+	// 16-bit millis() timer for the present Pump Output transition, compared as (now - _uiSwitchMillis) >= length.  Only one use is live at a time:
+	// - PENDING, polling before the edge: when the transition was queued
+	// - PENDING, polling after the edge: the Zero Crossing
+	// - SETTLING: the start of the relay settling window
+	// Waits on an AcksenPhaseSync are timed in micros() by AcksenPumpAttachments::ulPhaseSyncMicros instead.
+	uint16_t _uiSwitchMillis = 0;
+	
+	uint8_t _ui8SequenceStep = 0;
+	
+	// Internal flags, initialised by the constructor
+	uint8_t _iOutputLevel : 1;				// Shadow copy of the level last written to the Pump Output
+	uint8_t _iSwitchState : 2;
+	uint8_t _iPhaseSyncLastLevel : 1;
+	bool _bPhaseSyncEdgeSeen : 1;
+	uint8_t _iLastControlState : 3;			// Inputs the last pass of process() was based on
+	bool _bLastRequestedOn : 1;
+	uint8_t _iLastOperatingMode : 1;
+	bool _bStateChangeOccurred : 1;
+	bool _bProcessRequired : 1;
+	bool _bGrainRestOverdue : 1;			// Periodic Grain Rest fell due while not allowed - starts as soon as it is
+	uint8_t _iSequence : 2;					// Running Sequence - PUMP_SEQUENCE_NONE, PUMP_SEQUENCE_VENTILATION, etc
+	
+	void processPass();
+	bool deadlineExpired(unsigned long ulTimeNow);
+	uint8_t yieldReason();
+	void updateControlState();
+	void updateOutput();
+	bool overTemperature();
+	bool grainRestPermitted();
+	void processGrainRest(unsigned long ulTimeNow);
+	
+	void startSequence(uint8_t ui8Sequence);
+	void processSequence(unsigned long ulTimeNow);
+	void nextStep(const AcksenPumpStep &stStep);
+	void beginStep(unsigned long ulTimeNow);
+	void endSequence(uint8_t ui8NextControlState);
+	const AcksenPumpStep *sequence();
+	void loadStep(AcksenPumpStep &stStep);
+	unsigned long stepLengthMillis(const AcksenPumpStep &stStep);
+	bool stepExitReached(const AcksenPumpStep &stStep);
+	unsigned long ventOnLengthMillis();
+	unsigned long ventOffLengthMillis();
+	uint8_t ventCycles();
+	bool extendVentilation();
+	bool processPriming(unsigned long ulTimeNow);
 	
-	bool _bStateChangeOccurred = false;
+	void processSwitching();
+	void finishSwitching();
+	uint16_t switchingDelay();
+	bool transitionDeferred(int iDemandLevel, unsigned long ulTimeNow);
+	bool relayGuardDefers(int iDemandLevel, unsigned long ulTimeNow);
+	bool supplyDefers(int iDemandLevel, unsigned long ulTimeNow);
+	bool phaseSyncReady(unsigned long ulTimeNow);
 	
+	void relaySwitchingDelay();
 	void waitForPhaseSync();
-	bool waitForPin(uint8_t pin, uint8_t value, uint16_t timeout);
+	bool waitForPin(const AcksenHal::FastPin &fpPin, uint8_t value, uint16_t timeout);
 	
 	void setNegativeSwichingLogic(bool bPositiveSwitchingState);
 
@@ -0,0 +1,1008 @@
+/*!
+@file AcksenPumpBank.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Bank of pumps sharing one process() pass, stored in a compact struct-of-arrays layout.
+// All output changes resulting from a pass are applied together, with one shared Phase Sync wait and Relay Switching Delay.
+//
+// The bank runs its own Pump Ventilation, Grain Rest (manual and periodic) and Maximum Pump Temperature logic, rather than the AcksenPump Sequence engine.
+// It supports AcksenPhaseSync (attachPhaseSync()), AcksenPumpEventQueue, Non-Blocking Switching, the LCD callback and AcksenPumpNotifier (attachNotifier()).  It does NOT support, and a pump needing any of these should be an AcksenPump:
+//   - Pump Sequences (runSequence()) and Burst-Fire flow (setFlowPercent())
+//   - AcksenThermalGovernor, AcksenRelayGuard, AcksenPumpSupply and AcksenPrimeMonitor
+//   - A polled Phase Sync input pin, getConfig()/setConfig(), step(), profiling counters, AcksenPumpTelemetry and AcksenPumpSim
+//
+
+#ifndef AcksenPumpBank_h
+#define AcksenPumpBank_h
+
+#include "AcksenPumpHal.h"
+#include "AcksenPump.h"
+#include "AcksenPhaseSync.h"
+#include "AcksenPumpEvents.h"
+#include "AcksenTimerWheel.h"
+
+// Per-pump Grain Rest flags
+#define PUMP_BANK_GRAIN_REST_MASHING			0x01	///< Pump is controlling Grain Mashing (beginMashingControl()).
+#define PUMP_BANK_GRAIN_REST_INHIBIT			0x02	///< Grain Rests temporarily inhibited, as close to Set Point.
+#define PUMP_BANK_GRAIN_REST_DUE				0x04	///< Periodic Grain Rest is due, and waiting for the pump to be free to rest.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that holds up to N pumps, and processes them in a single pass.  Supports a subset of AcksenPump features - see the notes at the top of this file.
+*/
+/**************************************************************************/
+template <uint8_t N>
+class AcksenPumpBank
+{
+
+public:
+
+	// Bank-wide Configuration (applies to every pump in the bank)
+	int iPumpOnState = PUMP_POSITIVE_LOGIC_ON;		///< Define the Output State that is set when a Pump is ON.
+	int iPumpOffState = PUMP_POSITIVE_LOGIC_OFF;	///< Define the Output State that is set when a Pump is OFF.
+
+	bool bEnablePumpVentilation = PUMP_VENTILATION_ENABLED_DEFAULT;	///< Enable/Disable Pump Ventilation system on pump startup
+	int iPumpVentilationCycles = PUMP_VENTILATION_CYCLE_COUNT_DEFAULT;	///< Number of Pump Ventilation ON/OFF cycles on startup
+	int iPumpVentilationOnLength = PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT;	///< Length of Pump being set to ON during Ventilation Cycle, in Seconds.
+	int iPumpVentilationOffLength = PUMP_VENTILATION_CYCLE_OFF_TIME_DEFAULT;///< Length of Pump being set to OFF during Ventilation Cycle, in Seconds.
+	uint16_t uiPumpVentilationOnLengthMillis = 0;	///< Length of Pump being set to ON during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOnLength when non-zero.
+	uint16_t uiPumpVentilationOffLengthMillis = 0;	///< Length of Pump being set to OFF during Ventilation Cycle, in Milliseconds.  Overrides iPumpVentilationOffLength when non-zero.
+
+	int iGrainRestLength = GRAIN_REST_LENGTH_DEFAULT;	///< Length of Grain Rest (how long a pump will be OFF for, before restarting), in Minutes.
+	int iGrainRestPeriod = GRAIN_REST_PERIOD_DEFAULT;	///< Interval Period between the start of periodic Grain Rests, in Minutes.  0 disables periodic Grain Rests.
+	bool bEnableGrainRest = ENABLE_GRAIN_REST_DEFAULT;	///< Enable periodic Grain Rests, for pumps controlling Grain Mashing.
+	bool bEnableInhibitGrainRestAroundSetPoint = TEMPORARY_INHIBIT_GRAIN_REST_AROUND_SET_POINT_DEFAULT;	///< Allow temporaryInhibitGrainRestAsAroundPreheatSetPoint() to hold off periodic Grain Rests.
+
+	bool bEnableMaxPumpTemperature = ENABLE_MAX_PUMP_TEMP_DEFAULT;	///< Enable the Maximum Pump Temperature monitoring system
+	int iMaxPumpTemperature = MAX_PUMP_TEMP_DEFAULT;	///< Maximum Pump Operating Temperature.  Pumps will be disabled above this level.
+
+	bool bEnablePhaseSync = PHASE_SYNC_ENABLED_DEFAULT;	///< Enable the Voltage Phase Sync system (requires attachPhaseSync()).
+	int iPhaseSyncPreActivationDelay = PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT;	///< Delay between detecting Zero Crossing, and changing Pump Output States.
+
+	int iPumpRelaySwitchingDelay = PUMP_RELAY_SWITCHING_DELAY;	///< Delay added once after switching a batch of Pump Outputs, to allow for relay settling.
+
+	bool bNonBlockingSwitching = PUMP_NON_BLOCKING_SWITCHING_DEFAULT;	///< Advance batched transitions from process() using millis() deadlines, rather than blocking.
+
+	void (*callbackInitLCDs)() = NULL;	///< Callback to allow reinitialisation of any attached LCD displays, once after each batch of Pump Output changes.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.  Pumps are added using addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpBank() {}
+
+/**************************************************************************/
+/*!
+    @brief  Add a pump to the bank, configure its output pin, and set it OFF.
+    @param  iPumpOutputPin
+            The Arduino I/O pin assigned to the Pump Output.
+    @return Index of the new pump, used by all other per-pump functions, which ignore any index not returned by addPump().  Returns -1 if the bank is full.
+*/
+/**************************************************************************/
+	int addPump(int iPumpOutputPin)
+	{
+
+		if (this->_ui8PumpCount >= N)
+		{
+			return -1;
+		}
+
+		uint8_t i = this->_ui8PumpCount++;
+
+		this->_ui8ControlState[i] = PUMP_CONTROL_STOP;
+		this->_ui8OperatingMode[i] = PUMP_OPERATING_MODE_OFF;
+		this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_OFF;
+		this->_ui8OutputActual[i] = PUMP_OUTPUT_STATE_OFF;
+		this->_ui8VentilationCycleRuntimeCount[i] = 0;
+		this->_ui8StateChangeOccurred[i] = false;
+		this->_iPumpTemperatureCenti[i] = 0;
+		this->_ui8GrainRestFlags[i] = PUMP_BANK_GRAIN_REST_INHIBIT;
+
+		// Set as Output, and set Pump Off
+		AcksenHal::setPinMode(iPumpOutputPin, OUTPUT);
+		AcksenHal::writePin(iPumpOutputPin, iPumpOffState);
+		this->_ui8OutputLevel[i] = (uint8_t)iPumpOffState;
+
+		// Resolve the pin once, for direct register access where supported
+		AcksenHal::resolveFastPin(this->_fpOutput[i], iPumpOutputPin);
+
+		return i;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of pumps that have been added to the bank.
+    @return Pump count.
+*/
+/**************************************************************************/
+	int pumpCount() { return this->_ui8PumpCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Use an interrupt-driven AcksenPhaseSync for Voltage Phase Sync of all pumps in the bank.
+    @param  pPhaseSync
+            Pointer to an AcksenPhaseSync that has been started with begin().
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachPhaseSync(AcksenPhaseSync *pPhaseSync) { this->_pPhaseSync = pPhaseSync; }
+
+/**************************************************************************/
+/*!
+    @brief 	Toggle a Pump State (from ON to OFF, or OFF to ON)
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void ToggleState(int iPump)
+	{
+
+		if (validPump(iPump) == false)
+		{
+			return;
+		}
+
+		if (this->_ui8ControlState[iPump] == PUMP_CONTROL_STOP)
+		{
+
+			// Check to see if the Pump Temperature has exceeded Maximum Levels
+			if (overTemperature(iPump) == true)
+			{
+				// Ignore Pump Activation
+				return;
+			}
+
+			unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+			this->_ui8OperatingMode[iPump] = PUMP_OPERATING_MODE_ON;
+
+			if (this->bEnablePumpVentilation == true)
+			{
+				// Pump set to ON, Pump Vent On
+				startVent(iPump, ulTimeNow);
+			}
+			else
+			{
+				// Pump set to ON, no Pump Vent
+				setControlState(iPump, PUMP_CONTROL_ON);
+				this->_ui8OutputRequested[iPump] = PUMP_OUTPUT_STATE_ON;
+			}
+
+			// setup next Grain Rest timing (if required!)
+			resetGrainRest(iPump, ulTimeNow);
+
+		}
+		else
+		{
+
+			// Pump set to off, no Pump Vent
+			turnOff(iPump);
+
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Turn a Pump OFF.  The output change is applied by the next process() call, together with any other pending changes.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void turnOff(int iPump)
+	{
+
+		if (validPump(iPump) == false)
+		{
+			return;
+		}
+
+		stopPump(iPump);
+		this->_ui8OperatingMode[iPump] = PUMP_OPERATING_MODE_OFF;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Turn every Pump in the bank OFF, and apply the change as one batch.
+			With bNonBlockingSwitching false, the outputs are written before returning (after the Phase Sync wait and Relay Switching Delay).
+			With bNonBlockingSwitching true, the batch is only queued - the outputs change on a later process() call, once any Phase Sync wait or relay settling window ends.
+    @return No return value.
+*/
+/**************************************************************************/
+	void turnOffAll()
+	{
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+			turnOff(i);
+		}
+
+		applyOutputs();
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Start a Grain Rest on a running Pump, of iGrainRestLength minutes.  The pump is vented again when the rest ends.
+			The next periodic Grain Rest is due iGrainRestPeriod minutes after this one starts.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void beginGrainRest(int iPump)
+	{
+
+		if ((validPump(iPump) == false) || (this->_ui8OperatingMode[iPump] != PUMP_OPERATING_MODE_ON) || (this->iGrainRestLength == 0))
+		{
+			return;
+		}
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		// Ensure that the Pump is temporarily turned off
+		setControlState(iPump, PUMP_CONTROL_GRAIN_REST);
+		this->_ui8OutputRequested[iPump] = PUMP_OUTPUT_STATE_OFF;
+		this->_twTimers.arm(iPump, ulTimeNow, (unsigned long)this->iGrainRestLength * 60000UL);
+
+		resetGrainRest(iPump, ulTimeNow);
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Mark a Pump as controlling Grain Mashing for Brewing.  Periodic Grain Rests only run on these pumps.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void beginMashingControl(int iPump)
+	{
+
+		if (validPump(iPump) == false)
+		{
+			return;
+		}
+
+		this->_ui8GrainRestFlags[iPump] |= PUMP_BANK_GRAIN_REST_MASHING;
+		startDueGrainRest(iPump);
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Mark a Pump as no longer controlling Grain Mashing.  Stops periodic Grain Rests on it, but not one already running.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void endMashingControl(int iPump)
+	{
+
+		if (validPump(iPump) == true)
+		{
+			this->_ui8GrainRestFlags[iPump] &= ~PUMP_BANK_GRAIN_REST_MASHING;
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Hold off periodic Grain Rests on a Pump, as close to Set Point.  A rest falling due meanwhile starts once permitted again.
+			Only applies while bEnableInhibitGrainRestAroundSetPoint is set.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void temporaryInhibitGrainRestAsAroundPreheatSetPoint(int iPump)
+	{
+
+		if (validPump(iPump) == true)
+		{
+			this->_ui8GrainRestFlags[iPump] |= PUMP_BANK_GRAIN_REST_INHIBIT;
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Permit periodic Grain Rests on a Pump again.  Starts any rest that fell due while inhibited.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return No return value.
+*/
+/**************************************************************************/
+	void temporaryPermitGrainRestAsAroundPreheatSetPoint(int iPump)
+	{
+
+		if (validPump(iPump) == false)
+		{
+			return;
+		}
+
+		this->_ui8GrainRestFlags[iPump] &= ~PUMP_BANK_GRAIN_REST_INHIBIT;
+		startDueGrainRest(iPump);
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Set a Pump Temperature, using an external temperature reading.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @param  fNewPumpTemperature
+            Temperature, in Celsius.  Stored to 0.01C resolution.  NaN or out of range readings are stored as PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updatePumpTemperature(int iPump, float fNewPumpTemperature)
+	{
+
+		if (validPump(iPump) == true)
+		{
+			this->_iPumpTemperatureCenti[iPump] = AcksenPumpCentidegrees(fNewPumpTemperature);
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Set a Pump Temperature, using an integer temperature reading.  Avoids floating point.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @param  iCentidegrees
+            Temperature, in hundredths of a degree Celsius.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updatePumpTemperatureCentidegrees(int iPump, int16_t iCentidegrees)
+	{
+
+		if (validPump(iPump) == true)
+		{
+			this->_iPumpTemperatureCenti[iPump] = iCentidegrees;
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get a Pump Control State.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return PUMP_CONTROL_STOP, PUMP_CONTROL_VENT, PUMP_CONTROL_ON or PUMP_CONTROL_GRAIN_REST.  PUMP_CONTROL_STOP for an invalid index.
+*/
+/**************************************************************************/
+	int controlState(int iPump) { return (validPump(iPump) == true) ? this->_ui8ControlState[iPump] : PUMP_CONTROL_STOP; }
+
+/**************************************************************************/
+/*!
+    @brief  Get a Pump Actual Output State.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return PUMP_OUTPUT_STATE_OFF or PUMP_OUTPUT_STATE_ON.  PUMP_OUTPUT_STATE_OFF for an invalid index.
+*/
+/**************************************************************************/
+	int outputState(int iPump) { return (validPump(iPump) == true) ? this->_ui8OutputActual[iPump] : PUMP_OUTPUT_STATE_OFF; }
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a Pump Actual Output State has needed to change since last called.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return Returns true if the state changed.
+			Returns false if the state did not change.
+*/
+/**************************************************************************/
+	bool stateChangeOccurred(int iPump)
+	{
+
+		if ((validPump(iPump) == true) && (this->_ui8StateChangeOccurred[iPump] == true))
+		{
+			// Reset Flag
+			this->_ui8StateChangeOccurred[iPump] = false;
+			return true;
+		}
+
+		return false;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a batch of Pump Output transitions is still in progress.
+    @return Returns true if all outputs have settled, and no transition is pending.
+*/
+/**************************************************************************/
+	bool switchingSettled() { return (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED); }
+
+/**************************************************************************/
+/*!
+    @brief  Process automatic operations (Max Temperature check, Grain Rests and Pump Ventilation) for every pump, then apply all resulting output changes together.  This should be called regularly.
+    @return No return value.
+*/
+/**************************************************************************/
+	void process()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+			checkTemperature(i);
+		}
+
+		// Only expired deadlines are visited, however many are armed
+		int iTimer;
+
+		while ((iTimer = this->_twTimers.expired(ulTimeNow)) != -1)
+		{
+			timerExpired((uint8_t)iTimer, ulTimeNow);
+		}
+
+		applyOutputs();
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the time at which process() next has work to do, across every pump in the bank.
+    @return millis() time of the earliest deadline.  Equal to millis() if process() should be called again immediately.
+*/
+/**************************************************************************/
+	unsigned long nextEventMillis()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+		{
+			return this->_ulSettlingEndTime;
+		}
+
+		if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
+		{
+			return ulTimeNow;
+		}
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+
+			if (this->_ui8OutputRequested[i] != this->_ui8OutputActual[i])
+			{
+				// Change not yet applied
+				return ulTimeNow;
+			}
+
+		}
+
+		// Ventilation phase ends, Grain Rest ends and periodic Grain Rests
+		unsigned long ulNextEvent = ulTimeNow + PUMP_NEXT_EVENT_IDLE_INTERVAL;
+		unsigned long ulDeadline;
+
+		if ((this->_twTimers.nextDeadline(ulTimeNow, ulDeadline) == true) && ((int32_t)(ulDeadline - ulNextEvent) < 0))
+		{
+			ulNextEvent = ulDeadline;
+		}
+
+		return ulNextEvent;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Record events for every pump in the bank in an AcksenPumpEventQueue.
+    @param  pEventQueue
+            Pointer to the queue.  Set to NULL to stop recording events.
+    @param  ui8FirstPumpId
+            Id recorded with events from the first pump.  Each subsequent pump uses the next id.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachEventQueue(AcksenPumpEventQueue *pEventQueue, uint8_t ui8FirstPumpId)
+	{
+		this->_pEventQueue = pEventQueue;
+		this->_ui8EventFirstPumpId = ui8FirstPumpId;
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Notify an AcksenPumpNotifier once after each batch of Pump Output changes, as well as calling callbackInitLCDs.
+    @param  pNotifier
+            Pointer to the notifier.  Set to NULL to stop notifying it.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachNotifier(AcksenPumpNotifier *pNotifier) { this->_pNotifier = pNotifier; }
+
+protected:
+
+	// Per-pump state, one array per field
+	AcksenHal::FastPin _fpOutput[N];
+	uint8_t _ui8OutputLevel[N];		// Shadow copy of the level last written to each Pump Output
+	uint8_t _ui8ControlState[N];
+	uint8_t _ui8OperatingMode[N];
+	uint8_t _ui8OutputRequested[N];
+	uint8_t _ui8OutputActual[N];
+	uint8_t _ui8VentilationCycleRuntimeCount[N];
+	uint8_t _ui8StateChangeOccurred[N];
+	int16_t _iPumpTemperatureCenti[N];	// Pump Temperatures, in hundredths of a degree Celsius
+	uint8_t _ui8GrainRestFlags[N];		// PUMP_BANK_GRAIN_REST_* flags
+
+	// Deadlines - timer i ends the present Vent ON/OFF phase or Grain Rest of pump i, and timer N + i is its next periodic Grain Rest
+	AcksenTimerWheel<2 * N> _twTimers;
+
+	uint8_t _ui8PumpCount = 0;
+
+	// Shared switching state
+	AcksenPhaseSync *_pPhaseSync = NULL;
+	int _iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+	unsigned long _ulSwitchStartTime;
+	unsigned long _ulSettlingEndTime;
+	unsigned long _ulPhaseSyncQueueMicros;
+	unsigned long _ulPhaseSyncTargetMicros;
+	bool _bPhaseSyncPredicted;
+
+	AcksenPumpEventQueue *_pEventQueue = NULL;
+	uint8_t _ui8EventFirstPumpId = 0;
+
+	AcksenPumpNotifier *_pNotifier = NULL;
+
+	void raiseEvent(uint8_t i, uint8_t ui8Type, uint8_t ui8Value)
+	{
+
+		if (this->_pEventQueue != NULL)
+		{
+			this->_pEventQueue->push(this->_ui8EventFirstPumpId + i, ui8Type, ui8Value);
+		}
+
+	}
+
+	void setControlState(uint8_t i, uint8_t ui8ControlState)
+	{
+
+		if (this->_ui8ControlState[i] != ui8ControlState)
+		{
+			this->_ui8ControlState[i] = ui8ControlState;
+			raiseEvent(i, PUMP_EVENT_CONTROL_STATE, ui8ControlState);
+		}
+
+	}
+
+	unsigned long ventOnLengthMillis()
+	{
+		return (this->uiPumpVentilationOnLengthMillis != 0) ? this->uiPumpVentilationOnLengthMillis : ((unsigned long)this->iPumpVentilationOnLength * 1000UL);
+	}
+
+	unsigned long ventOffLengthMillis()
+	{
+		return (this->uiPumpVentilationOffLengthMillis != 0) ? this->uiPumpVentilationOffLengthMillis : ((unsigned long)this->iPumpVentilationOffLength * 1000UL);
+	}
+
+	bool validPump(int iPump)
+	{
+		return ((iPump >= 0) && (iPump < this->_ui8PumpCount));
+	}
+
+	bool overTemperature(uint8_t i)
+	{
+		return ((this->bEnableMaxPumpTemperature == true) && (this->_iPumpTemperatureCenti[i] >= AcksenPumpLimitCentidegrees(this->iMaxPumpTemperature)));
+	}
+
+	void stopPump(uint8_t i)
+	{
+
+		setControlState(i, PUMP_CONTROL_STOP);
+		this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_OFF;
+
+		this->_twTimers.cancel(i);
+		this->_twTimers.cancel(N + i);
+		this->_ui8GrainRestFlags[i] &= ~PUMP_BANK_GRAIN_REST_DUE;
+
+	}
+
+	void checkTemperature(uint8_t i)
+	{
+
+		// Check to see if the Pump Temperature has exceeded Maximum Levels
+		if (overTemperature(i) == true)
+		{
+
+			if (this->_ui8ControlState[i] != PUMP_CONTROL_STOP)
+			{
+				raiseEvent(i, PUMP_EVENT_OVER_TEMPERATURE, this->_ui8ControlState[i]);
+			}
+
+			// Ensure that the Pump is turned off!
+			stopPump(i);
+
+		}
+
+	}
+
+	void startVent(uint8_t i, unsigned long ulTimeNow)
+	{
+
+		// Start with an ON phase
+		setControlState(i, PUMP_CONTROL_VENT);
+		this->_ui8VentilationCycleRuntimeCount[i] = 0;
+		this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_ON;
+		this->_twTimers.arm(i, ulTimeNow, ventOnLengthMillis());
+
+	}
+
+	void resetGrainRest(uint8_t i, unsigned long ulTimeNow)
+	{
+
+		this->_ui8GrainRestFlags[i] &= ~PUMP_BANK_GRAIN_REST_DUE;
+
+		if (this->iGrainRestPeriod != 0)
+		{
+			this->_twTimers.arm(N + i, ulTimeNow, (unsigned long)this->iGrainRestPeriod * 60000UL);
+		}
+		else
+		{
+			this->_twTimers.cancel(N + i);
+		}
+
+	}
+
+	void startDueGrainRest(uint8_t i)
+	{
+
+		// Only a running pump, controlling mashing and not inhibited, can rest - otherwise stay due until it can
+		if (((this->_ui8GrainRestFlags[i] & PUMP_BANK_GRAIN_REST_DUE) == 0) ||
+			(this->_ui8ControlState[i] != PUMP_CONTROL_ON) ||
+			((this->_ui8GrainRestFlags[i] & PUMP_BANK_GRAIN_REST_MASHING) == 0) ||
+			((this->bEnableInhibitGrainRestAroundSetPoint == true) && ((this->_ui8GrainRestFlags[i] & PUMP_BANK_GRAIN_REST_INHIBIT) != 0)))
+		{
+			return;
+		}
+
+		beginGrainRest(i);
+
+	}
+
+	void timerExpired(uint8_t ui8Timer, unsigned long ulTimeNow)
+	{
+
+		if (ui8Timer >= N)
+		{
+
+			uint8_t i = ui8Timer - N;
+
+			if ((this->bEnableGrainRest == false) || (this->iGrainRestLength == 0))
+			{
+				// Grain Rests disabled for the whole bank - look again next period
+				resetGrainRest(i, ulTimeNow);
+				return;
+			}
+
+			this->_ui8GrainRestFlags[i] |= PUMP_BANK_GRAIN_REST_DUE;
+			startDueGrainRest(i);
+			return;
+
+		}
+
+		uint8_t i = ui8Timer;
+
+		// Pump Ventilation Control
+		if (this->_ui8ControlState[i] == PUMP_CONTROL_VENT)
+		{
+
+			if (this->_ui8OutputRequested[i] == PUMP_OUTPUT_STATE_ON)
+			{
+				// ON cycle completed
+				this->_ui8VentilationCycleRuntimeCount[i]++;
+				this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_OFF;
+				this->_twTimers.arm(i, ulTimeNow, ventOffLengthMillis());
+			}
+			else
+			{
+				// OFF cycle completed
+				this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_ON;
+				this->_twTimers.arm(i, ulTimeNow, ventOnLengthMillis());
+			}
+
+			// Check to see if the pump ventilation phase has ended
+			if (this->_ui8VentilationCycleRuntimeCount[i] > this->iPumpVentilationCycles)
+			{
+
+				this->_twTimers.cancel(i);
+
+				if (this->_ui8OperatingMode[i] == PUMP_OPERATING_MODE_ON)
+				{
+					setControlState(i, PUMP_CONTROL_ON);
+					this->_ui8OutputRequested[i] = PUMP_OUTPUT_STATE_ON;
+
+					// Any Grain Rest that fell due while venting
+					startDueGrainRest(i);
+				}
+				else
+				{
+					stopPump(i);
+				}
+
+			}
+
+		}
+
+		// Pump Grain Rest Control
+		else if (this->_ui8ControlState[i] == PUMP_CONTROL_GRAIN_REST)
+		{
+			// Grain Rest Complete - Initialise Mandatory Pump Vent
+			startVent(i, ulTimeNow);
+		}
+
+	}
+
+	uint8_t demandLevel(uint8_t i)
+	{
+		return (uint8_t)((this->_ui8OutputRequested[i] == PUMP_OUTPUT_STATE_ON) ? this->iPumpOnState : this->iPumpOffState);
+	}
+
+	bool outputsPending()
+	{
+
+		bool bPending = false;
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+
+			if (this->_ui8OutputRequested[i] != this->_ui8OutputActual[i])
+			{
+				// Set State Change Occurred flag for use by calling software
+				this->_ui8StateChangeOccurred[i] = true;
+			}
+
+			if (this->_ui8OutputLevel[i] != demandLevel(i))
+			{
+				bPending = true;
+			}
+			else
+			{
+				this->_ui8OutputActual[i] = this->_ui8OutputRequested[i];
+			}
+
+		}
+
+		return bPending;
+
+	}
+
+	void writeOutputs()
+	{
+
+		// Match the Demand State for every pump, back to back
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+
+			uint8_t ui8Level = demandLevel(i);
+
+			if (this->_ui8OutputLevel[i] != ui8Level)
+			{
+				AcksenHal::writeFastPin(this->_fpOutput[i], ui8Level);
+				this->_ui8OutputLevel[i] = ui8Level;
+
+				raiseEvent(i, (ui8Level == this->iPumpOnState) ? PUMP_EVENT_OUTPUT_ON : PUMP_EVENT_OUTPUT_OFF, this->_ui8ControlState[i]);
+			}
+
+			this->_ui8OutputActual[i] = this->_ui8OutputRequested[i];
+
+		}
+
+	}
+
+	void launchCallbackInitLCDs()
+	{
+
+		if (this->callbackInitLCDs != NULL)
+		{
+			(*callbackInitLCDs)();
+		}
+
+		if (this->_pNotifier != NULL)
+		{
+			this->_pNotifier->notify();
+		}
+
+	}
+
+	bool phaseSyncActive()
+	{
+		return ((this->bEnablePhaseSync == true) && (this->_pPhaseSync != NULL));
+	}
+
+	void queueSwitch(unsigned long ulTimeNow)
+	{
+
+		this->_iSwitchState = PUMP_SWITCH_STATE_PENDING;
+		this->_ulSwitchStartTime = ulTimeNow;
+		this->_bPhaseSyncPredicted = false;
+
+		if (phaseSyncActive() == true)
+		{
+
+			// Schedule the batch for the edge shared with any other pump still within its delay, or the predicted Zero Crossing, plus any additional delay
+			this->_bPhaseSyncPredicted = this->_pPhaseSync->switchMicros((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL, this->_ulPhaseSyncTargetMicros);
+			this->_ulPhaseSyncQueueMicros = AcksenHal::timeMicros();
+
+		}
+
+	}
+
+	bool phaseSyncReady(unsigned long ulTimeNow)
+	{
+
+		if (phaseSyncActive() == false)
+		{
+			return true;
+		}
+
+		if (this->_bPhaseSyncPredicted == false)
+		{
+
+			unsigned long ulEdgeMicros;
+
+			// Not yet locked - wait for a fresh captured edge, or give up after the usual Phase Sync timeout
+			if (this->_pPhaseSync->edgeSince(this->_ulPhaseSyncQueueMicros, ulEdgeMicros) == false)
+			{
+
+				if ((uint32_t)(ulTimeNow - this->_ulSwitchStartTime) <= (2 * PHASE_SYNC_TIMEOUT))
+				{
+					return false;
+				}
+
+				// Switching will go ahead regardless - let the calling software know, for every pump in the batch
+				for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+				{
+
+					if (this->_ui8OutputLevel[i] != demandLevel(i))
+					{
+						raiseEvent(i, PUMP_EVENT_PHASE_SYNC_TIMEOUT, this->_ui8ControlState[i]);
+					}
+
+				}
+
+				ulEdgeMicros = AcksenHal::timeMicros();
+
+			}
+
+			this->_bPhaseSyncPredicted = true;
+			this->_ulPhaseSyncTargetMicros = ulEdgeMicros + ((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL);
+
+		}
+
+		// Switch at the scheduled point in the mains cycle, or the same point after the next edge if this pass is too late for it
+		return this->_pPhaseSync->switchDue((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL, this->_ulPhaseSyncTargetMicros);
+
+	}
+
+	void applyOutputs()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		if (this->bNonBlockingSwitching == false)
+		{
+
+			if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+			{
+
+				// Non-Blocking Switching was turned off part way through a batch - wait out the rest of the settling window
+				if ((int32_t)(this->_ulSettlingEndTime - ulTimeNow) > 0)
+				{
+					AcksenHal::sleepMillis((uint32_t)(this->_ulSettlingEndTime - ulTimeNow));
+				}
+
+				launchCallbackInitLCDs();
+
+			}
+
+			// A batch still pending is switched below, as any other
+			this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+
+			if (outputsPending() == false)
+			{
+				return;
+			}
+
+			// One Phase Sync wait for the whole batch
+			queueSwitch(ulTimeNow);
+
+			while (phaseSyncReady(AcksenHal::timeMillis()) == false)
+			{
+				AcksenHal::busyWaitTick();
+			}
+
+			writeOutputs();
+
+			// One Relay Switching Delay for the whole batch
+			AcksenHal::sleepMillis(this->iPumpRelaySwitchingDelay);
+			launchCallbackInitLCDs();
+
+			this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+			return;
+
+		}
+
+		if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLED)
+		{
+
+			if (outputsPending() == false)
+			{
+				return;
+			}
+
+			queueSwitch(ulTimeNow);
+
+		}
+
+		if (this->_iSwitchState == PUMP_SWITCH_STATE_PENDING)
+		{
+
+			if (outputsPending() == false)
+			{
+				// Requests were reversed before being applied - nothing to do
+				this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+				return;
+			}
+
+			if (phaseSyncReady(ulTimeNow) == false)
+			{
+				return;
+			}
+
+			writeOutputs();
+
+			// Start the shared relay settling window
+			this->_iSwitchState = PUMP_SWITCH_STATE_SETTLING;
+			this->_ulSettlingEndTime = ulTimeNow + this->iPumpRelaySwitchingDelay;
+
+		}
+
+		if (this->_iSwitchState == PUMP_SWITCH_STATE_SETTLING)
+		{
+
+			if ((int32_t)(ulTimeNow - this->_ulSettlingEndTime) >= 0)
+			{
+				this->_iSwitchState = PUMP_SWITCH_STATE_SETTLED;
+				launchCallbackInitLCDs();
+			}
+
+		}
+
+	}
+
+};
+
+#endif
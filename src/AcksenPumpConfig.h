@@ -0,0 +1,82 @@
+/*!
+@file AcksenPumpConfig.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Compact, versioned binary snapshot of the AcksenPump tuning settings, and the CRC used to protect stored records.
+//
+
+#ifndef AcksenPumpConfig_h
+#define AcksenPumpConfig_h
+
+#include "AcksenPumpHal.h"
+
+// *** CONFIG CONSTANTS ***
+#define PUMP_CONFIG_VERSION						1		///< Layout version of AcksenPumpConfig.  Stored records with another version are ignored.
+
+// Config Flags
+#define PUMP_CONFIG_FLAG_NEGATIVE_LOGIC			0x01	///< Pump Output uses Negative Logic.
+#define PUMP_CONFIG_FLAG_VENTILATION			0x02	///< bEnablePumpVentilation.
+#define PUMP_CONFIG_FLAG_MAX_TEMPERATURE		0x04	///< bEnableMaxPumpTemperature.
+#define PUMP_CONFIG_FLAG_GRAIN_REST				0x08	///< bEnableGrainRest.
+#define PUMP_CONFIG_FLAG_INHIBIT_GRAIN_REST		0x10	///< bEnableInhibitGrainRestAroundSetPoint.
+#define PUMP_CONFIG_FLAG_PHASE_SYNC				0x20	///< bEnablePhaseSync.
+#define PUMP_CONFIG_FLAG_NON_BLOCKING			0x40	///< bNonBlockingSwitching.
+
+/**************************************************************************/
+/*! 
+    @brief  Snapshot of the AcksenPump tuning settings.  Filled by AcksenPump::getConfig(), applied by AcksenPump::setConfig().
+			16 Bytes, with no padding on any supported target.  Settings are limited to their field width - getConfig() saturates any int setting outside it.
+*/
+/**************************************************************************/
+struct AcksenPumpConfig
+{
+	uint16_t uiPumpVentilationOnLengthMillis;	///< As AcksenPump::uiPumpVentilationOnLengthMillis.
+	uint16_t uiPumpVentilationOffLengthMillis;	///< As AcksenPump::uiPumpVentilationOffLengthMillis.
+	uint16_t uiPumpRelaySwitchingDelay;			///< As AcksenPump::iPumpRelaySwitchingDelay.
+	uint8_t ui8Version;							///< PUMP_CONFIG_VERSION.
+	uint8_t ui8Flags;							///< PUMP_CONFIG_FLAG_* bits.
+	uint8_t ui8PumpVentilationCycles;			///< As AcksenPump::iPumpVentilationCycles.
+	uint8_t ui8PumpVentilationOnLength;			///< As AcksenPump::iPumpVentilationOnLength.
+	uint8_t ui8PumpVentilationOffLength;		///< As AcksenPump::iPumpVentilationOffLength.
+	uint8_t ui8GrainRestLength;					///< As AcksenPump::iGrainRestLength.
+	uint8_t ui8GrainRestPeriod;					///< As AcksenPump::iGrainRestPeriod.
+	uint8_t ui8MaxPumpTemperature;				///< As AcksenPump::iMaxPumpTemperature.
+	uint8_t ui8PhaseSyncPreActivationDelay;		///< As AcksenPump::iPhaseSyncPreActivationDelay.
+	uint8_t ui8Reserved;						///< Set to 0.
+};
+
+/**************************************************************************/
+/*!
+    @brief  Calculate a CRC-16/CCITT (polynomial 0x1021) over a block of data.
+    @param  pData
+            Data to check.
+    @param  uiLength
+            Length of the data, in Bytes.
+    @param  uiCrc
+            Starting value, or the result of a previous call to continue over several blocks.
+    @return CRC value.
+*/
+/**************************************************************************/
+uint16_t AcksenPumpCrc16(const void *pData, size_t uiLength, uint16_t uiCrc = 0xFFFF);
+
+#endif
@@ -0,0 +1,262 @@
+/*!
+@file AcksenPumpConfigStore.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Wear-levelled storage of AcksenPumpConfig records, rotating across several slots, with a CRC on each record.
+// The Storage class provides the memory - AcksenEepromStorage (AcksenPumpEeprom.h) on Arduino, or AcksenHostFileStorage on a Linux host.
+//
+
+#ifndef AcksenPumpConfigStore_h
+#define AcksenPumpConfigStore_h
+
+#include "AcksenPumpHal.h"
+#include "AcksenPump.h"
+#include "AcksenPumpConfig.h"
+
+// *** CONFIG STORE CONSTANTS ***
+#define PUMP_CONFIG_SLOTS_DEFAULT				4		///< Number of slots records are rotated across.
+#define PUMP_CONFIG_SLOTS_MAX					8		///< Maximum number of slots.  All slots are read in one bulk read on load, using a buffer of this many records.
+
+/**************************************************************************/
+/*! 
+    @brief  Stored form of an AcksenPumpConfig, with a sequence number to find the newest slot, and a CRC
+*/
+/**************************************************************************/
+struct AcksenPumpConfigRecord
+{
+	uint16_t uiSequence;			///< Incremented on each write.  The valid record with the highest sequence number is the newest.
+	AcksenPumpConfig cfConfig;		///< Settings.
+	uint16_t uiCrc;					///< AcksenPumpCrc16() of uiSequence and cfConfig.
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Class that saves and loads AcksenPumpConfig records in a block of Storage, rotating writes across slots for wear levelling
+			Storage must provide read(uint16_t uiAddress, void *pData, size_t uiLength) and write(uint16_t uiAddress, const void *pData, size_t uiLength), where write() skips unchanged bytes.
+*/
+/**************************************************************************/
+template <class Storage>
+class AcksenPumpConfigStore
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @param  stStorage
+            Storage backend.
+    @param  uiBaseAddress
+            First address of the block used, in Bytes.  The block is storageSize() Bytes long.
+    @param  ui8Slots
+            Number of slots to rotate across, up to PUMP_CONFIG_SLOTS_MAX.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpConfigStore(Storage &stStorage, uint16_t uiBaseAddress, uint8_t ui8Slots = PUMP_CONFIG_SLOTS_DEFAULT) :
+		_stStorage(stStorage)
+	{
+		this->_uiBaseAddress = uiBaseAddress;
+		this->_ui8Slots = ((ui8Slots == 0) || (ui8Slots > PUMP_CONFIG_SLOTS_MAX)) ? PUMP_CONFIG_SLOTS_DEFAULT : ui8Slots;
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the size of the block of Storage used.
+    @return Size, in Bytes.
+*/
+/**************************************************************************/
+	uint16_t storageSize()
+	{
+		return (uint16_t)(this->_ui8Slots * sizeof(AcksenPumpConfigRecord));
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Load the newest valid record, using one bulk read of all slots.
+    @param  cfConfig
+            Receives the settings.  Unchanged if no valid record is found.
+    @return Returns true if a valid record of the present PUMP_CONFIG_VERSION was found.
+			Returns false otherwise (e.g. blank or corrupted Storage).
+*/
+/**************************************************************************/
+	bool load(AcksenPumpConfig &cfConfig)
+	{
+
+		AcksenPumpConfigRecord arRecords[PUMP_CONFIG_SLOTS_MAX];
+		int iNewest = -1;
+
+		this->_stStorage.read(this->_uiBaseAddress, arRecords, storageSize());
+
+		for (uint8_t i = 0; i < this->_ui8Slots; i++)
+		{
+
+			if ((recordValid(arRecords[i]) == false) || (arRecords[i].cfConfig.ui8Version != PUMP_CONFIG_VERSION))
+			{
+				continue;
+			}
+
+			// Newest by sequence number, allowing for wraparound
+			if ((iNewest == -1) || ((int16_t)(arRecords[i].uiSequence - arRecords[iNewest].uiSequence) > 0))
+			{
+				iNewest = i;
+			}
+
+		}
+
+		this->_bLoaded = true;
+
+		if (iNewest == -1)
+		{
+			// Nothing stored - the first save() goes to slot 0
+			this->_bValid = false;
+			this->_ui8Slot = this->_ui8Slots - 1;
+			this->_uiSequence = 0;
+			return false;
+		}
+
+		this->_bValid = true;
+		this->_ui8Slot = (uint8_t)iNewest;
+		this->_uiSequence = arRecords[iNewest].uiSequence;
+		this->_cfStored = arRecords[iNewest].cfConfig;
+
+		cfConfig = this->_cfStored;
+
+		return true;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Load the newest valid record, and apply it to a pump.
+    @param  pmPump
+            Pump to configure.  Unchanged if no valid record is found.
+    @return Returns true if a valid record was found and applied.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool load(AcksenPump &pmPump)
+	{
+
+		AcksenPumpConfig cfConfig;
+
+		if (load(cfConfig) == false)
+		{
+			return false;
+		}
+
+		pmPump.setConfig(cfConfig);
+
+		return true;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Save settings to the next slot, unless they match the newest stored record.
+    @param  cfConfig
+            Settings to save.
+    @return Returns true if a record was written.
+			Returns false if the settings were unchanged, and nothing was written.
+*/
+/**************************************************************************/
+	bool save(const AcksenPumpConfig &cfConfig)
+	{
+
+		if (this->_bLoaded == false)
+		{
+			// Find the newest slot first
+			AcksenPumpConfig cfIgnored;
+			load(cfIgnored);
+		}
+
+		if ((this->_bValid == true) && (memcmp(&cfConfig, &this->_cfStored, sizeof(AcksenPumpConfig)) == 0))
+		{
+			// Unchanged - skip the write
+			return false;
+		}
+
+		AcksenPumpConfigRecord rcRecord;
+
+		rcRecord.uiSequence = this->_uiSequence + 1;
+		rcRecord.cfConfig = cfConfig;
+		rcRecord.cfConfig.ui8Version = PUMP_CONFIG_VERSION;
+		rcRecord.uiCrc = recordCrc(rcRecord);
+
+		// Rotate to the next slot.  The previous record stays valid until this one is complete, so a power loss during the write falls back to it.
+		uint8_t ui8Slot = (uint8_t)((this->_ui8Slot + 1) % this->_ui8Slots);
+
+		this->_stStorage.write(this->_uiBaseAddress + (ui8Slot * sizeof(AcksenPumpConfigRecord)), &rcRecord, sizeof(AcksenPumpConfigRecord));
+
+		this->_bValid = true;
+		this->_ui8Slot = ui8Slot;
+		this->_uiSequence = rcRecord.uiSequence;
+		this->_cfStored = rcRecord.cfConfig;
+
+		return true;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Save a pump's settings, unless they match the newest stored record.
+    @param  pmPump
+            Pump to save.
+    @return Returns true if a record was written.
+			Returns false if the settings were unchanged, and nothing was written.
+*/
+/**************************************************************************/
+	bool save(AcksenPump &pmPump)
+	{
+
+		AcksenPumpConfig cfConfig;
+		pmPump.getConfig(cfConfig);
+
+		return save(cfConfig);
+
+	}
+
+protected:
+
+	Storage &_stStorage;
+	uint16_t _uiBaseAddress;
+	uint8_t _ui8Slots;
+	uint8_t _ui8Slot = 0;				// Slot holding the newest record
+	uint16_t _uiSequence = 0;
+	bool _bLoaded = false;
+	bool _bValid = false;				// _cfStored holds the newest record
+	AcksenPumpConfig _cfStored;
+
+	static uint16_t recordCrc(const AcksenPumpConfigRecord &rcRecord)
+	{
+		return AcksenPumpCrc16(&rcRecord, sizeof(rcRecord.uiSequence) + sizeof(rcRecord.cfConfig));
+	}
+
+	static bool recordValid(const AcksenPumpConfigRecord &rcRecord)
+	{
+		return (rcRecord.uiCrc == recordCrc(rcRecord));
+	}
+
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*!
+@file AcksenPumpEeprom.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// EEPROM Storage backend for AcksenPumpConfigStore, using the Arduino EEPROM library.
+// Only included when used, so sketches without it do not depend on the EEPROM library.
+//
+
+#ifndef AcksenPumpEeprom_h
+#define AcksenPumpEeprom_h
+
+#include <EEPROM.h>
+
+/**************************************************************************/
+/*! 
+    @brief  Storage backend for AcksenPumpConfigStore, using the Arduino EEPROM library.  On ESP8266/ESP32, EEPROM.begin() must be called first.
+*/
+/**************************************************************************/
+class AcksenEepromStorage
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Read a block of EEPROM.
+    @param  uiAddress
+            First EEPROM address.
+    @param  pData
+            Receives the data.
+    @param  uiLength
+            Length, in Bytes.
+    @return No return value.
+*/
+/**************************************************************************/
+	void read(uint16_t uiAddress, void *pData, size_t uiLength)
+	{
+
+		uint8_t *pui8Data = (uint8_t *)pData;
+
+		for (size_t i = 0; i < uiLength; i++)
+		{
+			pui8Data[i] = EEPROM.read(uiAddress + i);
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Write a block of EEPROM, skipping bytes that already hold the same value.
+    @param  uiAddress
+            First EEPROM address.
+    @param  pData
+            Data to write.
+    @param  uiLength
+            Length, in Bytes.
+    @return No return value.
+*/
+/**************************************************************************/
+	void write(uint16_t uiAddress, const void *pData, size_t uiLength)
+	{
+
+		const uint8_t *pui8Data = (const uint8_t *)pData;
+		bool bChanged = false;
+
+		for (size_t i = 0; i < uiLength; i++)
+		{
+
+			if (EEPROM.read(uiAddress + i) != pui8Data[i])
+			{
+				EEPROM.write(uiAddress + i, pui8Data[i]);
+				this->_ulBytesWritten++;
+				bChanged = true;
+			}
+
+		}
+
+#if defined(ESP8266) || defined(ESP32)
+		if (bChanged == true)
+		{
+			EEPROM.commit();
+		}
+#else
+		(void)bChanged;
+#endif
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of bytes actually written, for wear monitoring.
+    @return Bytes written since initialisation.
+*/
+/**************************************************************************/
+	unsigned long bytesWritten() { return this->_ulBytesWritten; }
+
+protected:
+
+	unsigned long _ulBytesWritten = 0;
+
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*!
+@file AcksenPumpEvents.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPumpEvents.h"
+
+#if (PUMP_EVENT_QUEUE_SIZE & (PUMP_EVENT_QUEUE_SIZE - 1)) != 0 || PUMP_EVENT_QUEUE_SIZE > 128
+#error "PUMP_EVENT_QUEUE_SIZE must be a power of 2, no greater than 128"
+#endif
+
+#define PUMP_EVENT_QUEUE_MASK		(PUMP_EVENT_QUEUE_SIZE - 1)
+
+// Prevent the compiler reordering the slot contents and the index update
+#define PUMP_EVENT_QUEUE_BARRIER()	__asm__ __volatile__("" ::: "memory")
+
+bool AcksenPumpEventQueue::push(uint8_t ui8PumpId, uint8_t ui8Type, uint8_t ui8Value)
+{
+
+	uint8_t ui8Head = this->_ui8Head;
+
+	// Indexes run freely modulo 256, so full is head - tail == size
+	if ((uint8_t)(ui8Head - this->_ui8Tail) >= PUMP_EVENT_QUEUE_SIZE)
+	{
+		this->_uiOverflowCount++;
+		return false;
+	}
+
+	AcksenPumpEvent &evEvent = this->_evEvents[ui8Head & PUMP_EVENT_QUEUE_MASK];
+
+	evEvent.ulTimeMillis = AcksenHal::timeMillis();
+	evEvent.ui8PumpId = ui8PumpId;
+	evEvent.ui8Type = ui8Type;
+	evEvent.ui8Value = ui8Value;
+
+	// Publish the event
+	PUMP_EVENT_QUEUE_BARRIER();
+	this->_ui8Head = ui8Head + 1;
+
+	return true;
+
+}
+
+bool AcksenPumpEventQueue::pop(AcksenPumpEvent &evEvent)
+{
+
+	uint8_t ui8Tail = this->_ui8Tail;
+
+	if (ui8Tail == this->_ui8Head)
+	{
+		return false;
+	}
+
+	PUMP_EVENT_QUEUE_BARRIER();
+	evEvent = this->_evEvents[ui8Tail & PUMP_EVENT_QUEUE_MASK];
+
+	// Release the slot
+	PUMP_EVENT_QUEUE_BARRIER();
+	this->_ui8Tail = ui8Tail + 1;
+
+	return true;
+
+}
+
+uint8_t AcksenPumpEventQueue::available(void)
+{
+	return (uint8_t)(this->_ui8Head - this->_ui8Tail);
+}
+
+unsigned int AcksenPumpEventQueue::overflowCount(void)
+{
+
+	// Multi-byte counter may be updated by an ISR mid-read - re-read until stable
+	unsigned int uiOverflowCount;
+
+	do
+	{
+		uiOverflowCount = this->_uiOverflowCount;
+	}
+	while (uiOverflowCount != this->_uiOverflowCount);
+
+	return uiOverflowCount;
+
+}
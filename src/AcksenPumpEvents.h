@@ -0,0 +1,123 @@
+/*!
+@file AcksenPumpEvents.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Fixed-capacity, lock-free single-producer/single-consumer queue of timestamped Pump events.
+// Events are pushed by process() (or an ISR), and drained by the main loop.  Each queue must only be filled from one context (main loop or ISR), and drained from one context.
+//
+
+#ifndef AcksenPumpEvents_h
+#define AcksenPumpEvents_h
+
+#include "AcksenPumpHal.h"
+
+// *** EVENT CONSTANTS ***
+#define PUMP_EVENT_QUEUE_SIZE					16	///< Capacity of each AcksenPumpEventQueue, in events.  Must be a power of 2, no greater than 128.
+
+// Event Types
+#define PUMP_EVENT_OUTPUT_OFF					0	///< Pump Output was switched OFF.  Value holds the Pump Control State at the time.
+#define PUMP_EVENT_OUTPUT_ON					1	///< Pump Output was switched ON.  Value holds the Pump Control State at the time.
+#define PUMP_EVENT_CONTROL_STATE				2	///< Pump Control State changed.  Value holds the new Pump Control State.
+#define PUMP_EVENT_OVER_TEMPERATURE				3	///< Pump was stopped due to exceeding the Maximum Pump Temperature.  Value holds the Pump Control State before the trip.
+#define PUMP_EVENT_PHASE_SYNC_TIMEOUT			4	///< No Voltage Phase Sync edge was seen in time, and the Pump Output was switched regardless.
+#define PUMP_EVENT_THERMAL_TRIP					5	///< An attached AcksenThermalGovernor tripped.  Value holds the Trip Reason (THERMAL_TRIP_*).
+#define PUMP_EVENT_THERMAL_RESUME				6	///< Pump was restarted automatically after an AcksenThermalGovernor trip cleared.  Value holds the new Pump Control State.
+#define PUMP_EVENT_PRIMED						7	///< An attached AcksenPrimeMonitor found the Pump primed, and Ventilation ended.  Value holds the time to full flow, in Seconds (up to 255).
+#define PUMP_EVENT_DRY_RUN						8	///< Pump was stopped as it never primed during Ventilation.  Value is 1 if some flow was seen (air lock), 0 if none (dry).
+
+/**************************************************************************/
+/*! 
+    @brief  Timestamped Pump event
+*/
+/**************************************************************************/
+struct AcksenPumpEvent
+{
+	unsigned long ulTimeMillis;	///< millis() time the event occurred.
+	uint8_t ui8PumpId;			///< Id of the Pump that raised the event, as given to attachEventQueue().
+	uint8_t ui8Type;			///< Event Type (PUMP_EVENT_*).
+	uint8_t ui8Value;			///< Event Value, depending on the Event Type.
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Lock-free single-producer/single-consumer ring of AcksenPumpEvents
+*/
+/**************************************************************************/
+class AcksenPumpEventQueue
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Add an event to the queue.  Producer side - safe to call from an ISR.
+    @param  ui8PumpId
+            Id of the Pump raising the event.
+    @param  ui8Type
+            Event Type (PUMP_EVENT_*).
+    @param  ui8Value
+            Event Value.
+    @return Returns true if the event was queued.
+			Returns false if the queue was full.  The event is dropped, and counted by overflowCount().
+*/
+/**************************************************************************/
+	bool push(uint8_t ui8PumpId, uint8_t ui8Type, uint8_t ui8Value);
+
+/**************************************************************************/
+/*!
+    @brief  Remove the oldest event from the queue.  Consumer side.
+    @param  evEvent
+            Receives the event.
+    @return Returns true if an event was removed.
+			Returns false if the queue was empty.
+*/
+/**************************************************************************/
+	bool pop(AcksenPumpEvent &evEvent);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of events waiting in the queue.
+    @return Event count.
+*/
+/**************************************************************************/
+	uint8_t available();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of events dropped because the queue was full.
+    @return Overflow count.
+*/
+/**************************************************************************/
+	unsigned int overflowCount();
+
+protected:
+
+	AcksenPumpEvent _evEvents[PUMP_EVENT_QUEUE_SIZE];
+
+	volatile uint8_t _ui8Head = 0;		// Written by producer only
+	volatile uint8_t _ui8Tail = 0;		// Written by consumer only
+	volatile unsigned int _uiOverflowCount = 0;	// Written by producer only
+
+};
+
+#endif
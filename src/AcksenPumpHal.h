@@ -0,0 +1,199 @@
+/*!
+@file AcksenPumpHal.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Hardware Abstraction Layer (GPIO, monotonic clock, sleep, reads of PROGMEM data) used by the AcksenPump library.
+//
+// The backend is selected at compile time using ACKSEN_PUMP_HAL:
+// - AcksenHalArduino (default on Arduino targets), which forwards to the Arduino core and TimeLib.
+// - AcksenHalHost (default on other targets), a Linux host backend with a simulated pin array and injectable clock.
+// Each backend also provides FastPin, a pin handle resolved once (e.g. to a port register and bitmask on AVR) for use in frequently called code.
+// A custom backend can be used by defining ACKSEN_PUMP_HAL as the name of a class providing the same static functions, before including AcksenPump.h.
+//
+// saveInterrupts() disables interrupts and returns the previous state, for restoreInterrupts() to put back.  Unlike disableInterrupts()/enableInterrupts(),
+// this is safe in code that may also be called from an ISR (e.g. AcksenPhaseSync::handleEdge() from a user supplied ISR), as it never re-enables interrupts there.
+//
+// timeMillis() and timeMicros() are 32-bit counters on every backend, wrapping as millis() and micros() do.  unsigned long is 64-bit on a Linux host,
+// so time differences are cast to int32_t/uint32_t (rather than long/unsigned long) before being compared, to stay rollover safe there as well.
+//
+
+#ifndef AcksenPumpHal_h
+#define AcksenPumpHal_h
+
+#if defined(ARDUINO)
+
+#include <Time.h>
+#include <TimeLib.h>
+#include <Arduino.h>
+
+/**************************************************************************/
+/*! 
+    @brief  HAL backend that forwards to the Arduino core
+*/
+/**************************************************************************/
+struct AcksenHalArduino
+{
+
+/**************************************************************************/
+/*! 
+    @brief  Pin handle resolved once by resolveFastPin(), for single register access on cores that support it
+*/
+/**************************************************************************/
+	struct FastPin
+	{
+		int iPin = -1;									///< Arduino I/O pin number.
+#if defined(__AVR__)
+		volatile uint8_t *pOutputRegister = NULL;		///< Port output register, or NULL to use the portable calls.
+		volatile uint8_t *pInputRegister = NULL;		///< Port input register.
+		uint8_t ui8Mask = 0;							///< Bitmask for the pin within the port.
+#endif
+	};
+
+	static inline void resolveFastPin(FastPin &fpPin, int iPin)
+	{
+
+		fpPin.iPin = iPin;
+
+#if defined(__AVR__)
+		// Disabled pins (-1) must not index the port table
+		uint8_t ui8Port = (iPin < 0) ? NOT_A_PIN : digitalPinToPort(iPin);
+
+		if (ui8Port == NOT_A_PIN)
+		{
+			// Fall back to the portable calls
+			fpPin.pOutputRegister = NULL;
+			return;
+		}
+
+		fpPin.pOutputRegister = portOutputRegister(ui8Port);
+		fpPin.pInputRegister = portInputRegister(ui8Port);
+		fpPin.ui8Mask = digitalPinToBitMask(iPin);
+#endif
+
+	}
+
+	static inline void writeFastPin(const FastPin &fpPin, int iLevel)
+	{
+
+#if defined(__AVR__)
+		if (fpPin.pOutputRegister != NULL)
+		{
+
+			// Single read-modify-write of the port register, protected from ISRs writing other pins on the same port
+			uint8_t ui8SREG = SREG;
+			cli();
+
+			if (iLevel == LOW)
+			{
+				*fpPin.pOutputRegister &= ~fpPin.ui8Mask;
+			}
+			else
+			{
+				*fpPin.pOutputRegister |= fpPin.ui8Mask;
+			}
+
+			SREG = ui8SREG;
+			return;
+
+		}
+#endif
+
+		writePin(fpPin.iPin, iLevel);
+
+	}
+
+	static inline int readFastPin(const FastPin &fpPin)
+	{
+
+#if defined(__AVR__)
+		if (fpPin.pOutputRegister != NULL)
+		{
+			return ((*fpPin.pInputRegister & fpPin.ui8Mask) != 0) ? HIGH : LOW;
+		}
+#endif
+
+		return readPin(fpPin.iPin);
+
+	}
+
+	static inline void setPinMode(int iPin, int iMode) { pinMode(iPin, (decltype(OUTPUT))iMode); }
+	static inline int readPin(int iPin) { return (int)digitalRead(iPin); }
+	static inline void writePin(int iPin, int iLevel) { digitalWrite(iPin, (decltype(HIGH))iLevel); }
+
+	static inline unsigned long timeMillis() { return millis(); }
+	static inline unsigned long timeMicros() { return micros(); }
+	static inline void sleepMillis(unsigned long ulMillis) { delay(ulMillis); }
+	static inline void sleepMicros(unsigned int uiMicros) { delayMicroseconds(uiMicros); }
+	static inline void busyWaitTick() { yield(); }
+	static inline time_t wallClock() { return now(); }
+
+	static inline int pinInterrupt(int iPin) { return digitalPinToInterrupt(iPin); }
+	static inline void attachPinInterrupt(int iInterrupt, void (*isr)(), int iMode) { attachInterrupt(iInterrupt, isr, (decltype(RISING))iMode); }
+	static inline void detachPinInterrupt(int iInterrupt) { detachInterrupt(iInterrupt); }
+	static inline void disableInterrupts() { noInterrupts(); }
+	static inline void enableInterrupts() { interrupts(); }
+
+#if defined(__AVR__)
+	typedef uint8_t InterruptState;				///< Interrupt enable state saved by saveInterrupts().
+	static inline InterruptState saveInterrupts() { uint8_t ui8SREG = SREG; cli(); return ui8SREG; }
+	static inline void restoreInterrupts(InterruptState isState) { SREG = isState; }
+#elif defined(ESP8266)
+	typedef uint32_t InterruptState;			///< Interrupt enable state saved by saveInterrupts().
+	static inline InterruptState saveInterrupts() { return xt_rsil(15); }
+	static inline void restoreInterrupts(InterruptState isState) { xt_wsr_ps(isState); }
+#elif defined(ESP32)
+	typedef UBaseType_t InterruptState;			///< Interrupt enable state saved by saveInterrupts().
+	static inline InterruptState saveInterrupts() { return portSET_INTERRUPT_MASK_FROM_ISR(); }
+	static inline void restoreInterrupts(InterruptState isState) { portCLEAR_INTERRUPT_MASK_FROM_ISR(isState); }
+#elif defined(__arm__)
+	typedef uint32_t InterruptState;			///< Interrupt enable state saved by saveInterrupts().
+	static inline InterruptState saveInterrupts() { uint32_t ui32Primask = __get_PRIMASK(); __disable_irq(); return ui32Primask; }
+	static inline void restoreInterrupts(InterruptState isState) { __set_PRIMASK(isState); }
+#else
+	// No way to read the interrupt state on this core - only safe outside ISRs
+	typedef uint8_t InterruptState;				///< Interrupt enable state saved by saveInterrupts().
+	static inline InterruptState saveInterrupts() { noInterrupts(); return 1; }
+	static inline void restoreInterrupts(InterruptState isState) { if (isState != 0) { interrupts(); } }
+#endif
+
+	static inline void readFlash(void *pDestination, const void *pSource, size_t uiLength) { memcpy_P(pDestination, pSource, uiLength); }
+
+};
+
+#ifndef ACKSEN_PUMP_HAL
+#define ACKSEN_PUMP_HAL		AcksenHalArduino	///< HAL backend used by the library.
+#endif
+
+#else
+
+#include "AcksenPumpHalHost.h"
+
+#ifndef ACKSEN_PUMP_HAL
+#define ACKSEN_PUMP_HAL		AcksenHalHost		///< HAL backend used by the library.
+#endif
+
+#endif
+
+typedef ACKSEN_PUMP_HAL AcksenHal;
+
+#endif
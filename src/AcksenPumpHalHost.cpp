@@ -0,0 +1,344 @@
+/*!
+@file AcksenPumpHalHost.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#if !defined(ARDUINO)
+
+#include "AcksenPumpHalHost.h"
+
+#include <string.h>
+#include <stdio.h>
+
+static uint8_t _ui8PinLevel[ACKSEN_HAL_HOST_PIN_COUNT];
+static uint8_t _ui8PinMode[ACKSEN_HAL_HOST_PIN_COUNT];
+static unsigned long _ulPinChangeCount[ACKSEN_HAL_HOST_PIN_COUNT];
+
+static void (*_pfnPinIsr[ACKSEN_HAL_HOST_PIN_COUNT])();
+static uint8_t _ui8PinIsrMode[ACKSEN_HAL_HOST_PIN_COUNT];
+
+static bool _bVirtualClock = false;
+static uint64_t _ullVirtualMicros = 0;
+static uint64_t _ullRealClockOrigin = 0;
+static bool _bRealClockStarted = false;
+static time_t _tWallClockBase = 0;
+static uint64_t _ullWallClockBaseMicros = 0;
+
+static bool validPin(int iPin)
+{
+	return ((iPin >= 0) && (iPin < ACKSEN_HAL_HOST_PIN_COUNT));
+}
+
+static uint64_t realClockMicros(void)
+{
+
+	struct timespec tsNow;
+	clock_gettime(CLOCK_MONOTONIC, &tsNow);
+
+	uint64_t ullMicros = ((uint64_t)tsNow.tv_sec * 1000000ULL) + ((uint64_t)tsNow.tv_nsec / 1000ULL);
+
+	if (_bRealClockStarted == false)
+	{
+		// Start from zero, as millis() does after reset
+		_bRealClockStarted = true;
+		_ullRealClockOrigin = ullMicros;
+	}
+
+	return ullMicros - _ullRealClockOrigin;
+
+}
+
+void AcksenHalHost::setPinMode(int iPin, int iMode)
+{
+
+	if (validPin(iPin) == true)
+	{
+		_ui8PinMode[iPin] = (uint8_t)iMode;
+	}
+
+}
+
+int AcksenHalHost::readPin(int iPin)
+{
+	return (validPin(iPin) == true) ? _ui8PinLevel[iPin] : LOW;
+}
+
+void AcksenHalHost::writePin(int iPin, int iLevel)
+{
+
+	if (validPin(iPin) == false)
+	{
+		return;
+	}
+
+	uint8_t ui8Level = (iLevel != LOW) ? HIGH : LOW;
+
+	if (_ui8PinLevel[iPin] != ui8Level)
+	{
+		_ui8PinLevel[iPin] = ui8Level;
+		_ulPinChangeCount[iPin]++;
+	}
+
+}
+
+unsigned long AcksenHalHost::timeMillis(void)
+{
+	// 32-bit, as millis() on Arduino, so host runs see the rollover (unsigned long is 64-bit here)
+	return (uint32_t)(clockMicros() / 1000ULL);
+}
+
+unsigned long AcksenHalHost::timeMicros(void)
+{
+	return (uint32_t)clockMicros();
+}
+
+void AcksenHalHost::sleepMillis(unsigned long ulMillis)
+{
+	advanceMicros((uint64_t)ulMillis * 1000ULL);
+}
+
+void AcksenHalHost::sleepMicros(unsigned int uiMicros)
+{
+	advanceMicros(uiMicros);
+}
+
+void AcksenHalHost::busyWaitTick(void)
+{
+
+	// Time only moves on the virtual clock when advanced, so let busy-wait loops make progress
+	if (_bVirtualClock == true)
+	{
+		_ullVirtualMicros += ACKSEN_HAL_HOST_BUSY_WAIT_TICK;
+	}
+
+}
+
+time_t AcksenHalHost::wallClock(void)
+{
+
+	if (_bVirtualClock == false)
+	{
+		return time(NULL);
+	}
+
+	return _tWallClockBase + (time_t)((_ullVirtualMicros - _ullWallClockBaseMicros) / 1000000ULL);
+
+}
+
+int AcksenHalHost::pinInterrupt(int iPin)
+{
+	// One simulated interrupt per pin
+	return (validPin(iPin) == true) ? iPin : -1;
+}
+
+void AcksenHalHost::attachPinInterrupt(int iInterrupt, void (*isr)(), int iMode)
+{
+
+	if (validPin(iInterrupt) == true)
+	{
+		_pfnPinIsr[iInterrupt] = isr;
+		_ui8PinIsrMode[iInterrupt] = (uint8_t)iMode;
+	}
+
+}
+
+void AcksenHalHost::detachPinInterrupt(int iInterrupt)
+{
+
+	if (validPin(iInterrupt) == true)
+	{
+		_pfnPinIsr[iInterrupt] = NULL;
+	}
+
+}
+
+void AcksenHalHost::useVirtualClock(uint64_t ullStartMicros)
+{
+	_bVirtualClock = true;
+	_ullVirtualMicros = ullStartMicros;
+	_ullWallClockBaseMicros = ullStartMicros;
+	_tWallClockBase = time(NULL);
+}
+
+void AcksenHalHost::useRealClock(void)
+{
+	_bVirtualClock = false;
+}
+
+void AcksenHalHost::advanceMicros(uint64_t ullMicros)
+{
+
+	if (_bVirtualClock == true)
+	{
+		_ullVirtualMicros += ullMicros;
+		return;
+	}
+
+	// Real clock - actually sleep
+	struct timespec tsSleep;
+	tsSleep.tv_sec = (time_t)(ullMicros / 1000000ULL);
+	tsSleep.tv_nsec = (long)((ullMicros % 1000000ULL) * 1000ULL);
+	nanosleep(&tsSleep, NULL);
+
+}
+
+uint64_t AcksenHalHost::clockMicros(void)
+{
+	return (_bVirtualClock == true) ? _ullVirtualMicros : realClockMicros();
+}
+
+void AcksenHalHost::setWallClock(time_t tWallClock)
+{
+	_tWallClockBase = tWallClock;
+	_ullWallClockBaseMicros = _ullVirtualMicros;
+}
+
+void AcksenHalHost::setInputLevel(int iPin, int iLevel)
+{
+
+	if (validPin(iPin) == false)
+	{
+		return;
+	}
+
+	uint8_t ui8Previous = _ui8PinLevel[iPin];
+	uint8_t ui8Level = (iLevel != LOW) ? HIGH : LOW;
+
+	if (ui8Previous == ui8Level)
+	{
+		return;
+	}
+
+	_ui8PinLevel[iPin] = ui8Level;
+	_ulPinChangeCount[iPin]++;
+
+	if (_pfnPinIsr[iPin] == NULL)
+	{
+		return;
+	}
+
+	// Fire the simulated interrupt on a matching edge
+	if ((_ui8PinIsrMode[iPin] == CHANGE) || ((_ui8PinIsrMode[iPin] == RISING) && (ui8Level == HIGH)) || ((_ui8PinIsrMode[iPin] == FALLING) && (ui8Level == LOW)))
+	{
+		(*_pfnPinIsr[iPin])();
+	}
+
+}
+
+int AcksenHalHost::pinLevel(int iPin)
+{
+	return readPin(iPin);
+}
+
+unsigned long AcksenHalHost::pinChangeCount(int iPin)
+{
+	return (validPin(iPin) == true) ? _ulPinChangeCount[iPin] : 0;
+}
+
+void AcksenHalHost::reset(void)
+{
+	memset(_ui8PinLevel, 0, sizeof(_ui8PinLevel));
+	memset(_ui8PinMode, 0, sizeof(_ui8PinMode));
+	memset(_ulPinChangeCount, 0, sizeof(_ulPinChangeCount));
+	memset(_pfnPinIsr, 0, sizeof(_pfnPinIsr));
+	memset(_ui8PinIsrMode, 0, sizeof(_ui8PinIsrMode));
+}
+
+AcksenHostFileStorage::AcksenHostFileStorage(const char *pPath)
+{
+	this->_pPath = pPath;
+}
+
+void AcksenHostFileStorage::read(uint16_t uiAddress, void *pData, size_t uiLength)
+{
+
+	// Erased EEPROM reads as 0xFF
+	memset(pData, 0xFF, uiLength);
+
+	FILE *pFile = fopen(this->_pPath, "rb");
+
+	if (pFile == NULL)
+	{
+		return;
+	}
+
+	if (fseek(pFile, uiAddress, SEEK_SET) == 0)
+	{
+		size_t uiRead = fread(pData, 1, uiLength, pFile);
+		(void)uiRead;
+	}
+
+	fclose(pFile);
+
+}
+
+void AcksenHostFileStorage::write(uint16_t uiAddress, const void *pData, size_t uiLength)
+{
+
+	const uint8_t *pui8Data = (const uint8_t *)pData;
+	FILE *pFile = fopen(this->_pPath, "r+b");
+
+	if (pFile == NULL)
+	{
+		pFile = fopen(this->_pPath, "w+b");
+
+		if (pFile == NULL)
+		{
+			return;
+		}
+	}
+
+	// Pad the file out to the write address, as erased EEPROM
+	fseek(pFile, 0, SEEK_END);
+
+	for (long lSize = ftell(pFile); lSize < (long)uiAddress; lSize++)
+	{
+		fputc(0xFF, pFile);
+	}
+
+	for (size_t i = 0; i < uiLength; i++)
+	{
+
+		int iStored = EOF;
+
+		fseek(pFile, (long)(uiAddress + i), SEEK_SET);
+		iStored = fgetc(pFile);
+
+		// Only write bytes that differ, as EEPROM update does
+		if (iStored != (int)pui8Data[i])
+		{
+			fseek(pFile, (long)(uiAddress + i), SEEK_SET);
+			fputc(pui8Data[i], pFile);
+			this->_ulBytesWritten++;
+		}
+
+	}
+
+	fclose(pFile);
+
+}
+
+unsigned long AcksenHostFileStorage::bytesWritten(void)
+{
+	return this->_ulBytesWritten;
+}
+
+#endif
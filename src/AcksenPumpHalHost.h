@@ -0,0 +1,251 @@
+/*!
+@file AcksenPumpHalHost.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Linux host HAL backend, used to build and run the library natively for profiling and testing.
+// Provides a simulated pin array, simulated pin interrupts, and either the real monotonic clock or an injectable virtual clock.
+//
+
+#ifndef AcksenPumpHalHost_h
+#define AcksenPumpHalHost_h
+
+#if !defined(ARDUINO)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <string.h>
+
+#ifndef HIGH
+#define HIGH		1
+#define LOW			0
+#endif
+
+#ifndef INPUT
+#define INPUT		0
+#define OUTPUT		1
+#define INPUT_PULLUP	2
+#endif
+
+#ifndef CHANGE
+#define CHANGE		1
+#define FALLING		2
+#define RISING		3
+#endif
+
+#ifndef PROGMEM
+#define PROGMEM		// No separate flash address space on the host
+#endif
+
+#define ACKSEN_HAL_HOST_PIN_COUNT		64	///< Number of simulated pins.
+#define ACKSEN_HAL_HOST_BUSY_WAIT_TICK	10	///< Virtual time that passes on each iteration of a busy-wait loop, in Microseconds.
+
+/**************************************************************************/
+/*! 
+    @brief  HAL backend for Linux hosts, with simulated pins and an injectable clock
+*/
+/**************************************************************************/
+struct AcksenHalHost
+{
+
+	/// Pin handle - the host backend always uses the simulated pin array directly
+	struct FastPin
+	{
+		int iPin = -1;	///< Simulated pin number.
+	};
+
+	// HAL interface
+	static void setPinMode(int iPin, int iMode);
+	static int readPin(int iPin);
+	static void writePin(int iPin, int iLevel);
+
+	static unsigned long timeMillis();
+	static unsigned long timeMicros();
+	static void sleepMillis(unsigned long ulMillis);
+	static void sleepMicros(unsigned int uiMicros);
+	static void busyWaitTick();
+	static time_t wallClock();
+
+	static int pinInterrupt(int iPin);
+	static void attachPinInterrupt(int iInterrupt, void (*isr)(), int iMode);
+	static void detachPinInterrupt(int iInterrupt);
+	static void resolveFastPin(FastPin &fpPin, int iPin) { fpPin.iPin = iPin; }
+	static void writeFastPin(const FastPin &fpPin, int iLevel) { writePin(fpPin.iPin, iLevel); }
+	static int readFastPin(const FastPin &fpPin) { return readPin(fpPin.iPin); }
+
+	static void disableInterrupts() {}
+	static void enableInterrupts() {}
+
+	typedef uint8_t InterruptState;
+	static InterruptState saveInterrupts() { return 0; }
+	static void restoreInterrupts(InterruptState isState) { (void)isState; }
+
+	static void readFlash(void *pDestination, const void *pSource, size_t uiLength) { memcpy(pDestination, pSource, uiLength); }
+
+/**************************************************************************/
+/*!
+    @brief  Switch to the virtual clock.  Time then only moves when advanceMicros() is called, or the library sleeps.
+    @param  ullStartMicros
+            Initial virtual time, in Microseconds.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void useVirtualClock(uint64_t ullStartMicros = 0);
+
+/**************************************************************************/
+/*!
+    @brief  Switch back to the real monotonic clock.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void useRealClock();
+
+/**************************************************************************/
+/*!
+    @brief  Advance the virtual clock.  Has no effect when using the real clock.
+    @param  ullMicros
+            Time to advance by, in Microseconds.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void advanceMicros(uint64_t ullMicros);
+
+/**************************************************************************/
+/*!
+    @brief  Get the present time at full 64-bit resolution.
+    @return Time in Microseconds since the clock was started.
+*/
+/**************************************************************************/
+	static uint64_t clockMicros();
+
+/**************************************************************************/
+/*!
+    @brief  Set the wall clock time reported by wallClock() when using the virtual clock.
+    @param  tWallClock
+            Wall clock time corresponding to the present virtual time.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void setWallClock(time_t tWallClock);
+
+/**************************************************************************/
+/*!
+    @brief  Drive a simulated input pin, firing any attached interrupt on a matching edge.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void setInputLevel(int iPin, int iLevel);
+
+/**************************************************************************/
+/*!
+    @brief  Get the present level of a simulated pin.
+    @return HIGH or LOW.
+*/
+/**************************************************************************/
+	static int pinLevel(int iPin);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of writes to a simulated pin that changed its level.
+    @return Level change count since reset().
+*/
+/**************************************************************************/
+	static unsigned long pinChangeCount(int iPin);
+
+/**************************************************************************/
+/*!
+    @brief  Reset all simulated pins and interrupts to their power-on state.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void reset();
+
+};
+
+/**************************************************************************/
+/*! 
+    @brief  File-backed stand-in for EEPROM, used as the Storage backend for AcksenPumpConfigStore on a Linux host
+			Bytes beyond the end of the file read as 0xFF, as for erased EEPROM.
+*/
+/**************************************************************************/
+class AcksenHostFileStorage
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @param  pPath
+            Path of the backing file.  Created on the first write if it does not exist.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenHostFileStorage(const char *pPath);
+
+/**************************************************************************/
+/*!
+    @brief  Read a block of the file.
+    @param  uiAddress
+            First address.
+    @param  pData
+            Receives the data.
+    @param  uiLength
+            Length, in Bytes.
+    @return No return value.
+*/
+/**************************************************************************/
+	void read(uint16_t uiAddress, void *pData, size_t uiLength);
+
+/**************************************************************************/
+/*!
+    @brief  Write a block of the file, skipping bytes that already hold the same value.
+    @param  uiAddress
+            First address.
+    @param  pData
+            Data to write.
+    @param  uiLength
+            Length, in Bytes.
+    @return No return value.
+*/
+/**************************************************************************/
+	void write(uint16_t uiAddress, const void *pData, size_t uiLength);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of bytes actually written, for wear testing.
+    @return Bytes written since initialisation.
+*/
+/**************************************************************************/
+	unsigned long bytesWritten();
+
+protected:
+
+	const char *_pPath;
+	unsigned long _ulBytesWritten = 0;
+
+};
+
+#endif
+
+#endif
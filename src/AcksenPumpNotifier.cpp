@@ -0,0 +1,164 @@
+/*!
+@file AcksenPumpNotifier.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPumpNotifier.h"
+#include "AcksenPump.h"
+
+AcksenPumpNotifier *AcksenPumpNotifier::_pDefault = NULL;
+
+AcksenPumpNotifier::AcksenPumpNotifier()
+{
+}
+
+void AcksenPumpNotifier::begin(void)
+{
+	_pDefault = this;
+}
+
+void AcksenPumpNotifier::notifyDefault(void)
+{
+
+	if (_pDefault != NULL)
+	{
+		_pDefault->notify();
+	}
+
+}
+
+void AcksenPumpNotifier::notify(void)
+{
+	this->_ulLastNotifyMillis = AcksenHal::timeMillis();
+	this->_ulNotifyCount++;
+	this->_bPending = true;
+}
+
+bool AcksenPumpNotifier::addListener(AcksenPumpListener pfListener, void *pContext)
+{
+
+	int iFreeSlot = -1;
+
+	for (int i = 0; i < PUMP_NOTIFIER_MAX_LISTENERS; i++)
+	{
+
+		if ((this->_pfListeners[i] == pfListener) && (this->_pListenerContexts[i] == pContext))
+		{
+			// Already present
+			return true;
+		}
+
+		if ((this->_pfListeners[i] == NULL) && (iFreeSlot == -1))
+		{
+			iFreeSlot = i;
+		}
+
+	}
+
+	if (iFreeSlot == -1)
+	{
+		return false;
+	}
+
+	this->_pfListeners[iFreeSlot] = pfListener;
+	this->_pListenerContexts[iFreeSlot] = pContext;
+
+	return true;
+
+}
+
+void AcksenPumpNotifier::removeListener(AcksenPumpListener pfListener, void *pContext)
+{
+
+	for (int i = 0; i < PUMP_NOTIFIER_MAX_LISTENERS; i++)
+	{
+
+		if ((this->_pfListeners[i] == pfListener) && (this->_pListenerContexts[i] == pContext))
+		{
+			this->_pfListeners[i] = NULL;
+			this->_pListenerContexts[i] = NULL;
+		}
+
+	}
+
+}
+
+bool AcksenPumpNotifier::process(void)
+{
+
+	if (this->_bPending == false)
+	{
+		return false;
+	}
+
+	// Check to see if the quiet period since the last transition has elapsed (rollover safe)
+	if ((uint32_t)(AcksenHal::timeMillis() - this->_ulLastNotifyMillis) < this->uiQuietPeriod)
+	{
+		return false;
+	}
+
+	// Clear first, so a listener that switches a pump is notified again
+	this->_bPending = false;
+	this->_ulDispatchCount++;
+
+	for (int i = 0; i < PUMP_NOTIFIER_MAX_LISTENERS; i++)
+	{
+
+		if (this->_pfListeners[i] != NULL)
+		{
+			(*this->_pfListeners[i])(this->_pListenerContexts[i]);
+		}
+
+	}
+
+	return true;
+
+}
+
+bool AcksenPumpNotifier::pending(void)
+{
+	return this->_bPending;
+}
+
+unsigned long AcksenPumpNotifier::nextEventMillis(void)
+{
+
+	if (this->_bPending == false)
+	{
+		return AcksenHal::timeMillis() + PUMP_NEXT_EVENT_IDLE_INTERVAL;
+	}
+
+	unsigned long ulTimeNow = AcksenHal::timeMillis();
+	unsigned long ulQuietEnd = this->_ulLastNotifyMillis + this->uiQuietPeriod;
+
+	return ((int32_t)(ulQuietEnd - ulTimeNow) > 0) ? ulQuietEnd : ulTimeNow;
+
+}
+
+unsigned long AcksenPumpNotifier::notifyCount(void)
+{
+	return this->_ulNotifyCount;
+}
+
+unsigned long AcksenPumpNotifier::dispatchCount(void)
+{
+	return this->_ulDispatchCount;
+}
@@ -0,0 +1,166 @@
+/*!
+@file AcksenPumpNotifier.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Deferred, coalesced notification of Pump Output transitions, for LCD reinitialisation and similar slow handlers.
+//
+
+#ifndef AcksenPumpNotifier_h
+#define AcksenPumpNotifier_h
+
+#include "AcksenPumpHal.h"
+
+// *** NOTIFIER CONSTANTS ***
+#define PUMP_NOTIFIER_MAX_LISTENERS				4		///< Maximum number of listeners per AcksenPumpNotifier.
+#define PUMP_NOTIFIER_QUIET_PERIOD_DEFAULT		6000	///< Time after the last transition before listeners are run, in Milliseconds.  Longer than the default Ventilation phases, so a whole Ventilation sequence gives one notification.
+
+typedef void (*AcksenPumpListener)(void *pContext);	///< Function run by AcksenPumpNotifier::process(), once transitions have stopped.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that collects Pump Output transition notifications from any number of pumps, and runs its listeners once they have stopped
+			Attach it to each pump with attachNotifier() (on AcksenPump, this needs ACKSEN_PUMP_ATTACHMENTS), and call process() from the main loop.
+			Alternatively, call begin() and set each pump's callbackInitLCDs to AcksenPumpNotifier::notifyDefault.
+*/
+/**************************************************************************/
+class AcksenPumpNotifier
+{
+
+public:
+
+	uint16_t uiQuietPeriod = PUMP_NOTIFIER_QUIET_PERIOD_DEFAULT;	///< Time after the last transition before listeners are run, in Milliseconds.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpNotifier();
+
+/**************************************************************************/
+/*!
+    @brief  Make this the notifier used by notifyDefault().  Not needed for pumps using attachNotifier().
+    @return No return value.
+*/
+/**************************************************************************/
+	void begin();
+
+/**************************************************************************/
+/*!
+    @brief  Notify the notifier started with begin().  Has the same signature as callbackInitLCDs, so can be assigned to it on any AcksenPump, AcksenPumpT or AcksenPumpBank.
+    @return No return value.
+*/
+/**************************************************************************/
+	static void notifyDefault();
+
+/**************************************************************************/
+/*!
+    @brief  Record a Pump Output transition.  Marks the listeners due, and restarts the quiet period.
+    @return No return value.
+*/
+/**************************************************************************/
+	void notify();
+
+/**************************************************************************/
+/*!
+    @brief  Add a listener, run once after each burst of transitions.
+    @param  pfListener
+            Function to run.
+    @param  pContext
+            Pointer passed to the function.
+    @return Returns true if the listener was added, or was already present.
+			Returns false if PUMP_NOTIFIER_MAX_LISTENERS are already in use.
+*/
+/**************************************************************************/
+	bool addListener(AcksenPumpListener pfListener, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Remove a listener added with addListener().
+    @param  pfListener
+            Function to remove.
+    @param  pContext
+            Pointer it was added with.
+    @return No return value.
+*/
+/**************************************************************************/
+	void removeListener(AcksenPumpListener pfListener, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Run the listeners, if a notification is pending and the quiet period has elapsed.  This should be called regularly.
+    @return Returns true if the listeners were run.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool process();
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a notification is waiting for the quiet period to end.
+    @return Returns true if the listeners are due to be run.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool pending();
+
+/**************************************************************************/
+/*!
+    @brief  Get the time at which process() next has work to do.
+    @return millis() time the quiet period ends.  Equal to millis() plus PUMP_NEXT_EVENT_IDLE_INTERVAL if nothing is pending.
+*/
+/**************************************************************************/
+	unsigned long nextEventMillis();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of notifications received.
+    @return Notification count.
+*/
+/**************************************************************************/
+	unsigned long notifyCount();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of times the listeners have been run.
+    @return Dispatch count.
+*/
+/**************************************************************************/
+	unsigned long dispatchCount();
+
+protected:
+
+	static AcksenPumpNotifier *_pDefault;
+
+	AcksenPumpListener _pfListeners[PUMP_NOTIFIER_MAX_LISTENERS] = { NULL };
+	void *_pListenerContexts[PUMP_NOTIFIER_MAX_LISTENERS] = { NULL };
+
+	unsigned long _ulLastNotifyMillis = 0;
+	unsigned long _ulNotifyCount = 0;
+	unsigned long _ulDispatchCount = 0;
+	bool _bPending = false;
+
+};
+
+#endif
@@ -0,0 +1,319 @@
+/*!
+@file AcksenPumpProbes.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Set of temperature probes feeding one or more pumps, in integer hundredths of a degree Celsius.
+// Each probe's age and validity is tracked, and each pump is given the highest valid reading, or a configurable vote.
+//
+
+#ifndef AcksenPumpProbes_h
+#define AcksenPumpProbes_h
+
+#include "AcksenPumpHal.h"
+#include "AcksenPump.h"
+
+// *** PROBE CONSTANTS ***
+#define PROBE_READING_FAILED					(-32767 - 1)	///< Reading value marking a failed sensor read (disconnected, CRC error, etc).
+#define PROBE_STALE_MILLIS_DEFAULT				5000	///< Probes not updated within this time are treated as invalid, in Milliseconds.
+#define PROBE_VOTE_MAX							1		///< Give each pump the highest of its valid probe readings.
+#define PROBE_FAIL_SAFE_CENTIDEGREES			PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES	///< Temperature given to a pump with too few valid probes, when bFailSafe is set.  Trips the Maximum Pump Temperature check.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that holds up to N temperature probes, each assigned to an AcksenPump, and feeds each pump its governing temperature
+*/
+/**************************************************************************/
+template <uint8_t N>
+class AcksenPumpProbes
+{
+
+public:
+
+	uint16_t uiStaleMillis = PROBE_STALE_MILLIS_DEFAULT;	///< Probes not updated within this time are invalid, in Milliseconds.
+	uint8_t ui8Vote = PROBE_VOTE_MAX;	///< Governing temperature is the Nth highest valid reading, so N probes must agree (e.g. 2 ignores one probe failing high).  PROBE_VOTE_MAX (1) uses the highest.
+	bool bFailSafe = true;				///< With too few valid probes, give the pump PROBE_FAIL_SAFE_CENTIDEGREES (stopping it) rather than leaving its last temperature.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.  Probes are added using addProbe().
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpProbes() {}
+
+/**************************************************************************/
+/*!
+    @brief  Add a probe, and assign it to a pump.  Several probes can be assigned to the same pump (e.g. inlet, housing and motor).
+    @param  pPump
+            Pump the probe measures.
+    @return Index of the new probe, used by all other per-probe functions.  Returns -1 if the set is full.
+*/
+/**************************************************************************/
+	int addProbe(AcksenPump *pPump)
+	{
+
+		if (this->_ui8ProbeCount >= N)
+		{
+			return -1;
+		}
+
+		uint8_t i = this->_ui8ProbeCount++;
+
+		this->_pPump[i] = pPump;
+		this->_iCentidegrees[i] = PROBE_READING_FAILED;
+		this->_ulUpdatedMillis[i] = 0;
+
+		return i;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of probes that have been added.
+    @return Probe count.
+*/
+/**************************************************************************/
+	int probeCount() { return this->_ui8ProbeCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Record one probe reading.  Pumps are not updated until feedPumps() is called.
+    @param  iProbe
+            Probe index, as returned by addProbe().
+    @param  iCentidegrees
+            Temperature, in hundredths of a degree Celsius, or PROBE_READING_FAILED.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updateProbe(int iProbe, int16_t iCentidegrees)
+	{
+		this->_iCentidegrees[iProbe] = iCentidegrees;
+		this->_ulUpdatedMillis[iProbe] = AcksenHal::timeMillis();
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Record a reading for every probe from one sensor bus scan, then feed every pump.
+    @param  aiCentidegrees
+            Array of probeCount() temperatures, in hundredths of a degree Celsius, in probe index order.  Use PROBE_READING_FAILED for failed reads.
+    @return No return value.
+*/
+/**************************************************************************/
+	void update(const int16_t aiCentidegrees[])
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		for (uint8_t i = 0; i < this->_ui8ProbeCount; i++)
+		{
+			this->_iCentidegrees[i] = aiCentidegrees[i];
+			this->_ulUpdatedMillis[i] = ulTimeNow;
+		}
+
+		feedPumps();
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Give every assigned pump its governing temperature.  Call regularly, so stale probes are detected even when no readings arrive.
+    @return No return value.
+*/
+/**************************************************************************/
+	void feedPumps()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		for (uint8_t i = 0; i < this->_ui8ProbeCount; i++)
+		{
+
+			AcksenPump *pPump = this->_pPump[i];
+
+			if ((pPump == NULL) || (firstProbeOf(pPump) != i))
+			{
+				// Pump already fed from an earlier probe
+				continue;
+			}
+
+			int16_t iCentidegrees;
+
+			if (governingTemperature(pPump, iCentidegrees, ulTimeNow) == true)
+			{
+				pPump->updatePumpTemperatureCentidegrees(iCentidegrees);
+			}
+			else if (this->bFailSafe == true)
+			{
+				pPump->updatePumpTemperatureCentidegrees(PROBE_FAIL_SAFE_CENTIDEGREES);
+			}
+
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get a pump's governing temperature, from its valid probes.
+    @param  pPump
+            Pump to check.
+    @param  iCentidegrees
+            Receives the governing temperature, in hundredths of a degree Celsius.
+    @return Returns true if the pump has at least ui8Vote valid probes.
+			Returns false otherwise, and iCentidegrees is unchanged.
+*/
+/**************************************************************************/
+	bool governingTemperature(AcksenPump *pPump, int16_t &iCentidegrees)
+	{
+		return governingTemperature(pPump, iCentidegrees, AcksenHal::timeMillis());
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a probe has a current, successful reading.
+    @param  iProbe
+            Probe index, as returned by addProbe().
+    @return Returns true if the last reading succeeded, and is no older than uiStaleMillis.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool probeValid(int iProbe)
+	{
+		return probeValid(iProbe, AcksenHal::timeMillis());
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the time since a probe was last updated.
+    @param  iProbe
+            Probe index, as returned by addProbe().
+    @return Age of the last reading, in Milliseconds.
+*/
+/**************************************************************************/
+	unsigned long probeAge(int iProbe)
+	{
+		return (uint32_t)(AcksenHal::timeMillis() - this->_ulUpdatedMillis[iProbe]);
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the last reading of a probe.
+    @param  iProbe
+            Probe index, as returned by addProbe().
+    @return Temperature, in hundredths of a degree Celsius, or PROBE_READING_FAILED.
+*/
+/**************************************************************************/
+	int16_t probeTemperature(int iProbe)
+	{
+		return this->_iCentidegrees[iProbe];
+	}
+
+protected:
+
+	AcksenPump *_pPump[N];
+	int16_t _iCentidegrees[N];
+	unsigned long _ulUpdatedMillis[N];
+
+	uint8_t _ui8ProbeCount = 0;
+
+	bool probeValid(uint8_t i, unsigned long ulTimeNow)
+	{
+		return ((this->_iCentidegrees[i] != PROBE_READING_FAILED) && ((uint32_t)(ulTimeNow - this->_ulUpdatedMillis[i]) <= this->uiStaleMillis));
+	}
+
+	uint8_t firstProbeOf(AcksenPump *pPump)
+	{
+
+		uint8_t i = 0;
+
+		while (this->_pPump[i] != pPump)
+		{
+			i++;
+		}
+
+		return i;
+
+	}
+
+	bool governingTemperature(AcksenPump *pPump, int16_t &iCentidegrees, unsigned long ulTimeNow)
+	{
+
+		// Keep the ui8Vote highest valid readings, in descending order
+		int16_t aiHighest[N];
+		uint8_t ui8Vote = (this->ui8Vote == 0) ? 1 : this->ui8Vote;
+		uint8_t ui8Kept = 0;
+
+		if (ui8Vote > N)
+		{
+			return false;
+		}
+
+		for (uint8_t i = 0; i < this->_ui8ProbeCount; i++)
+		{
+
+			if ((this->_pPump[i] != pPump) || (probeValid(i, ulTimeNow) == false))
+			{
+				continue;
+			}
+
+			int16_t iReading = this->_iCentidegrees[i];
+			uint8_t j = ui8Kept;
+
+			if (ui8Kept < ui8Vote)
+			{
+				ui8Kept++;
+			}
+			else if (iReading <= aiHighest[ui8Kept - 1])
+			{
+				continue;
+			}
+			else
+			{
+				j = ui8Kept - 1;
+			}
+
+			// Insert, moving lower readings down
+			while ((j > 0) && (aiHighest[j - 1] < iReading))
+			{
+				aiHighest[j] = aiHighest[j - 1];
+				j--;
+			}
+
+			aiHighest[j] = iReading;
+
+		}
+
+		if (ui8Kept < ui8Vote)
+		{
+			// Too few valid probes to agree
+			return false;
+		}
+
+		iCentidegrees = aiHighest[ui8Vote - 1];
+
+		return true;
+
+	}
+
+};
+
+#endif
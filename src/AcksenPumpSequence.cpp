@@ -0,0 +1,40 @@
+/*!
+@file AcksenPumpSequence.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPump.h"
+
+// Pump Ventilation - ON, then OFF/ON for each Ventilation Cycle, then run.  A single ON with no Ventilation Cycles, as in v1.8.
+const AcksenPumpStep AcksenPumpVentilationSequence[] PROGMEM =
+{
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_VENT_ON,		0,					0,								0,	PUMP_STEP_EXIT_NONE,			0 },
+	{ PUMP_OUTPUT_STATE_OFF,	PUMP_STEP_DURATION_VENT_OFF,	0,					0,								0,	PUMP_STEP_EXIT_NO_VENT_CYCLES,	0 },
+	{ PUMP_OUTPUT_STATE_ON,		PUMP_STEP_DURATION_VENT_ON,		0,					PUMP_STEP_REPEAT_VENT_CYCLES,	1,	PUMP_STEP_EXIT_NO_VENT_CYCLES,	0 },
+	{ PUMP_STEP_END,			0,								PUMP_CONTROL_ON,	0,								0,	PUMP_STEP_EXIT_NONE,			0 }
+};
+
+// Grain Rest - OFF for iGrainRestLength minutes, then vent and run
+const AcksenPumpStep AcksenPumpGrainRestSequence[] PROGMEM =
+{
+	{ PUMP_OUTPUT_STATE_OFF,	PUMP_STEP_DURATION_GRAIN_REST,	0,					0,								0,	PUMP_STEP_EXIT_NONE,			0 },
+	{ PUMP_STEP_END,			0,								PUMP_CONTROL_VENT,	0,								0,	PUMP_STEP_EXIT_NONE,			0 }
+};
@@ -0,0 +1,84 @@
+/*!
+@file AcksenPumpSequence.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Table-driven Pump Sequences.  A Sequence is an array of AcksenPumpStep, stored in PROGMEM, and run by AcksenPump::process() one step at a time.
+// Pump Ventilation and Grain Rests are built-in Sequences.  Further Sequences (priming, pulse recirculation, whirlpool, etc) can be run using AcksenPump::runSequence().
+//
+// Example - pulse recirculation, 30s ON / 90s OFF, 20 times, then stop:
+//   const AcksenPumpStep PulseRecirculation[] PROGMEM =
+//   {
+//   	{ PUMP_OUTPUT_STATE_ON,  PUMP_STEP_DURATION_SECONDS, 30, 0,  0, PUMP_STEP_EXIT_NONE, 0 },
+//   	{ PUMP_OUTPUT_STATE_OFF, PUMP_STEP_DURATION_SECONDS, 90, 20, 0, PUMP_STEP_EXIT_NONE, 0 },
+//   	{ PUMP_STEP_END, 0, PUMP_CONTROL_STOP, 0, 0, PUMP_STEP_EXIT_NONE, 0 }
+//   };
+//
+
+#ifndef AcksenPumpSequence_h
+#define AcksenPumpSequence_h
+
+#include "AcksenPumpHal.h"
+
+// *** SEQUENCE CONSTANTS ***
+#define PUMP_STEP_END							0xFF	///< Output value marking the final step of a Sequence.  uiParam holds the Control State to move to (PUMP_CONTROL_STOP, PUMP_CONTROL_ON or PUMP_CONTROL_VENT).
+
+// Step Durations
+#define PUMP_STEP_DURATION_MILLIS				0	///< Step lasts uiParam Milliseconds.
+#define PUMP_STEP_DURATION_SECONDS				1	///< Step lasts uiParam Seconds.
+#define PUMP_STEP_DURATION_MINUTES				2	///< Step lasts uiParam Minutes (up to 35000).
+#define PUMP_STEP_DURATION_VENT_ON				3	///< Step lasts the configured Pump Ventilation ON length.
+#define PUMP_STEP_DURATION_VENT_OFF				4	///< Step lasts the configured Pump Ventilation OFF length.
+#define PUMP_STEP_DURATION_GRAIN_REST			5	///< Step lasts iGrainRestLength minutes.
+#define PUMP_STEP_DURATION_UNTIL_EXIT			6	///< Step lasts until its exit condition is met.
+
+// Step Repeat Counts
+#define PUMP_STEP_REPEAT_VENT_CYCLES			0xFE	///< Repeat the configured number of Pump Ventilation Cycles.
+#define PUMP_STEP_REPEAT_FOREVER				0xFF	///< Repeat until the Pump is turned off.
+
+// Step Exit Conditions
+#define PUMP_STEP_EXIT_NONE						0	///< Step only ends when its duration has elapsed.
+#define PUMP_STEP_EXIT_TEMPERATURE_ABOVE		1	///< Step also ends when the Pump Temperature is at or above ui8ExitParam, in Celsius.
+#define PUMP_STEP_EXIT_TEMPERATURE_BELOW		2	///< Step also ends when the Pump Temperature is below ui8ExitParam, in Celsius.
+#define PUMP_STEP_EXIT_NO_VENT_CYCLES			3	///< Step is skipped, or ends early, when no Pump Ventilation Cycles are configured.  Must not be used in a PUMP_STEP_REPEAT_FOREVER loop.
+
+/**************************************************************************/
+/*! 
+    @brief  One step of a Pump Sequence.  Sequences are stored in PROGMEM, and must end with a PUMP_STEP_END step.
+			Each Sequence has one loop counter, so loops may follow one another but must not be nested.
+*/
+/**************************************************************************/
+struct AcksenPumpStep
+{
+	uint8_t ui8Output;		///< Pump Output State for the step (PUMP_OUTPUT_STATE_ON or PUMP_OUTPUT_STATE_OFF), or PUMP_STEP_END.
+	uint8_t ui8Duration;	///< How long the step lasts (PUMP_STEP_DURATION_*).
+	uint16_t uiParam;		///< Length of the step, in the units given by ui8Duration.  For PUMP_STEP_END, the Control State to move to.
+	uint8_t ui8Repeat;		///< Total number of passes through the steps from ui8Goto to this one (or PUMP_STEP_REPEAT_*).  0 or 1 to run once.
+	uint8_t ui8Goto;		///< Index of the step to loop back to, while repeating.
+	uint8_t ui8Exit;		///< Condition that ends the step early (PUMP_STEP_EXIT_*).
+	uint8_t ui8ExitParam;	///< Parameter for ui8Exit.
+};
+
+extern const AcksenPumpStep AcksenPumpVentilationSequence[] PROGMEM;	///< Built-in Pump Ventilation Sequence.
+extern const AcksenPumpStep AcksenPumpGrainRestSequence[] PROGMEM;		///< Built-in Grain Rest Sequence.
+
+#endif
@@ -0,0 +1,478 @@
+/*!
+@file AcksenPumpSim.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#if !defined(ARDUINO)
+
+#include "AcksenPumpSim.h"
+
+#include <string.h>
+
+AcksenPumpSim::AcksenPumpSim(uint64_t ullStartMicros)
+{
+
+	memset(this->_pPumps, 0, sizeof(this->_pPumps));
+	memset(this->_ui8LastControlState, 0, sizeof(this->_ui8LastControlState));
+	memset(this->_ui8LastOutputState, 0, sizeof(this->_ui8LastOutputState));
+	memset(this->_bOverTemperatureViolated, 0, sizeof(this->_bOverTemperatureViolated));
+	memset(this->_bCustomViolated, 0, sizeof(this->_bCustomViolated));
+
+	this->_ullStartMicros = ullStartMicros;
+	AcksenHalHost::useVirtualClock(ullStartMicros);
+
+}
+
+int AcksenPumpSim::addPump(AcksenPump *pPump)
+{
+
+	if ((pPump == NULL) || (this->_ui8PumpCount >= PUMP_SIM_MAX_PUMPS))
+	{
+		return -1;
+	}
+
+	uint8_t ui8Pump = this->_ui8PumpCount++;
+
+	this->_pPumps[ui8Pump] = pPump;
+	this->_ui8LastControlState[ui8Pump] = 0xFF;
+	this->_ullOverTemperatureSince[ui8Pump] = UINT64_MAX;
+	pPump->bNonBlockingSwitching = true;
+
+	// Timeline starts from the present state
+	recordTransition(ui8Pump, AcksenHalHost::clockMicros());
+
+	return ui8Pump;
+
+}
+
+void AcksenPumpSim::setScenario(const AcksenPumpSimEvent *pEvents, uint16_t uiCount, unsigned long ulRepeatMillis)
+{
+	this->_pEvents = pEvents;
+	this->_uiEventCount = (pEvents != NULL) ? uiCount : 0;
+	this->_uiNextEvent = 0;
+	this->_ulRepeatMillis = ulRepeatMillis;
+	this->_ullScenarioStart = AcksenHalHost::clockMicros();
+}
+
+void AcksenPumpSim::setPhaseInput(int iPin, uint8_t ui8Hz)
+{
+	this->_iPhasePin = iPin;
+	this->_ui8PhaseHz = ui8Hz;
+}
+
+void AcksenPumpSim::setScript(AcksenPumpSimScript pfScript, void *pContext)
+{
+	this->_pfScript = pfScript;
+	this->_pScriptContext = pContext;
+}
+
+void AcksenPumpSim::setInvariant(AcksenPumpSimInvariant pfInvariant, void *pContext)
+{
+	this->_pfInvariant = pfInvariant;
+	this->_pInvariantContext = pContext;
+}
+
+void AcksenPumpSim::setTransitionListener(AcksenPumpSimTransitionListener pfListener, void *pContext)
+{
+	this->_pfTransitionListener = pfListener;
+	this->_pTransitionContext = pContext;
+}
+
+void AcksenPumpSim::setTimeline(AcksenPumpSimTransition *pTimeline, uint16_t uiLength)
+{
+	this->_pTimeline = pTimeline;
+	this->_uiTimelineLength = (pTimeline != NULL) ? uiLength : 0;
+	this->_ulTransitionCount = 0;
+}
+
+unsigned long AcksenPumpSim::run(unsigned long ulDurationMillis)
+{
+
+	uint64_t ullNow = AcksenHalHost::clockMicros();
+	uint64_t ullEnd = ullNow + ((uint64_t)ulDurationMillis * 1000ULL);
+	uint8_t ui8Passes = 0;
+
+	while (ullNow < ullEnd)
+	{
+
+		applyEvents(ullNow);
+
+		uint64_t ullNext = ullEnd;
+		bool bReady = false;
+		bool bPoll = false;
+		bool bWalkPhase = this->bPhaseContinuous;
+		unsigned long ulNowMillis = AcksenHal::timeMillis();
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+
+			AcksenPump *pPump = this->_pPumps[i];
+			unsigned long ulWakeMillis;
+			uint8_t ui8Reason = pPump->step(ulWakeMillis);
+
+			this->_ulStepCount++;
+
+			recordTransition(i, ullNow);
+			checkInvariants(i, ullNow);
+
+			if (ui8Reason == PUMP_YIELD_PHASE_SYNC)
+			{
+				// Waiting for a Zero Crossing - generate edges
+				bWalkPhase = true;
+			}
+
+			if ((pPump->flowPercent() < PUMP_FLOW_PERCENT_FULL) && (pPump->iOutputStateRequested == PUMP_OUTPUT_STATE_ON))
+			{
+				// Burst Fire switches on edges
+				bWalkPhase = true;
+			}
+
+			int32_t lWakeMillis = (int32_t)(ulWakeMillis - ulNowMillis);
+
+			if (lWakeMillis > 0)
+			{
+
+				// Deadline on a whole millisecond, as millis() would first report it
+				uint64_t ullWake = (ullNow - (ullNow % 1000ULL)) + ((uint64_t)lWakeMillis * 1000ULL);
+
+				if (ullWake < ullNext)
+				{
+					ullNext = ullWake;
+				}
+
+			}
+			else if (ui8Reason == PUMP_YIELD_READY)
+			{
+				bReady = true;
+			}
+			else
+			{
+				// Polling (Phase Sync input, pre-activation delay, etc)
+				bPoll = true;
+			}
+
+		}
+
+		if ((bReady == true) && (ui8Passes < PUMP_SIM_MAX_PASSES))
+		{
+			// More work due at this instant
+			ui8Passes++;
+			continue;
+		}
+
+		ui8Passes = 0;
+
+		if (((bReady == true) || (bPoll == true)) && ((ullNow + PUMP_SIM_POLL_MICROS) < ullNext))
+		{
+			ullNext = ullNow + PUMP_SIM_POLL_MICROS;
+		}
+
+		uint64_t ullScenario = nextScenarioMicros();
+
+		if (ullScenario < ullNext)
+		{
+			ullNext = ullScenario;
+		}
+
+		uint64_t ullEdge = ullEnd;
+
+		if (bWalkPhase == true)
+		{
+
+			ullEdge = nextPhaseEdgeMicros(ullNow);
+
+			if (ullEdge < ullNext)
+			{
+				ullNext = ullEdge;
+			}
+
+		}
+
+		if (ullNext <= ullNow)
+		{
+			// Never stall
+			ullNext = ullNow + PUMP_SIM_POLL_MICROS;
+		}
+
+		// Warp to the next event
+		AcksenHalHost::advanceMicros(ullNext - ullNow);
+		ullNow = ullNext;
+
+		if (ullNow == ullEdge)
+		{
+			phaseEdge(ullNow);
+		}
+
+	}
+
+	return this->_ulViolationCount;
+
+}
+
+void AcksenPumpSim::applyEvents(uint64_t ullNow)
+{
+
+	while (ullNow >= nextScenarioMicros())
+	{
+
+		applyEvent(this->_pEvents[this->_uiNextEvent]);
+
+		this->_uiNextEvent++;
+
+		if ((this->_uiNextEvent >= this->_uiEventCount) && (this->_ulRepeatMillis != 0))
+		{
+			// Start the next repeat
+			this->_uiNextEvent = 0;
+			this->_ullScenarioStart += (uint64_t)this->_ulRepeatMillis * 1000ULL;
+		}
+
+	}
+
+}
+
+void AcksenPumpSim::applyEvent(const AcksenPumpSimEvent &evEvent)
+{
+
+	AcksenPump *pPump = (evEvent.ui8Target < this->_ui8PumpCount) ? this->_pPumps[evEvent.ui8Target] : NULL;
+
+	switch (evEvent.ui8Action)
+	{
+		case PUMP_SIM_ACTION_TOGGLE:
+			if (pPump != NULL)
+			{
+				pPump->ToggleState();
+			}
+			break;
+
+		case PUMP_SIM_ACTION_TURN_OFF:
+			if (pPump != NULL)
+			{
+				pPump->turnOff();
+			}
+			break;
+
+		case PUMP_SIM_ACTION_TEMPERATURE:
+			if (pPump != NULL)
+			{
+				pPump->updatePumpTemperatureCentidegrees(evEvent.iValue);
+			}
+			break;
+
+		case PUMP_SIM_ACTION_FLOW:
+#if ACKSEN_PUMP_ATTACHMENTS
+			if (pPump != NULL)
+			{
+				pPump->setFlowPercent((uint8_t)evEvent.iValue);
+			}
+#endif
+			break;
+
+		case PUMP_SIM_ACTION_INPUT:
+			AcksenHalHost::setInputLevel(evEvent.ui8Target, evEvent.iValue);
+			break;
+
+		case PUMP_SIM_ACTION_PHASE_FREQUENCY:
+			this->_ui8PhaseHz = (uint8_t)evEvent.iValue;
+			break;
+
+		case PUMP_SIM_ACTION_SCRIPT:
+			if (this->_pfScript != NULL)
+			{
+				(*this->_pfScript)(evEvent.ui8Target, evEvent.iValue, this->_pScriptContext);
+			}
+			break;
+
+		default:
+			break;
+	}
+
+}
+
+uint64_t AcksenPumpSim::nextScenarioMicros()
+{
+
+	if (this->_uiNextEvent >= this->_uiEventCount)
+	{
+		// Scenario complete
+		return UINT64_MAX;
+	}
+
+	return this->_ullScenarioStart + ((uint64_t)this->_pEvents[this->_uiNextEvent].ulTimeMillis * 1000ULL);
+
+}
+
+uint64_t AcksenPumpSim::nextPhaseEdgeMicros(uint64_t ullNow)
+{
+
+	if ((this->_iPhasePin == -1) || (this->_ui8PhaseHz == 0))
+	{
+		return UINT64_MAX;
+	}
+
+	// Two edges per cycle, on a fixed grid from time zero
+	uint64_t ullHalfCycle = 500000ULL / this->_ui8PhaseHz;
+
+	return ((ullNow / ullHalfCycle) + 1) * ullHalfCycle;
+
+}
+
+void AcksenPumpSim::phaseEdge(uint64_t ullNow)
+{
+
+	if ((this->_iPhasePin == -1) || (this->_ui8PhaseHz == 0))
+	{
+		return;
+	}
+
+	uint64_t ullHalfCycle = 500000ULL / this->_ui8PhaseHz;
+
+	// Even edges are rising (the Zero Crossings)
+	AcksenHalHost::setInputLevel(this->_iPhasePin, (((ullNow / ullHalfCycle) & 1ULL) == 0) ? HIGH : LOW);
+
+}
+
+void AcksenPumpSim::recordTransition(uint8_t ui8Pump, uint64_t ullNow)
+{
+
+	AcksenPump *pPump = this->_pPumps[ui8Pump];
+	uint8_t ui8ControlState = (uint8_t)pPump->iControlState;
+	uint8_t ui8OutputState = (uint8_t)pPump->iOutputStateActual;
+
+	if ((ui8ControlState == this->_ui8LastControlState[ui8Pump]) && (ui8OutputState == this->_ui8LastOutputState[ui8Pump]))
+	{
+		// No change
+		return;
+	}
+
+	this->_ui8LastControlState[ui8Pump] = ui8ControlState;
+	this->_ui8LastOutputState[ui8Pump] = ui8OutputState;
+
+	AcksenPumpSimTransition stTransition;
+	stTransition.ullMicros = ullNow - this->_ullStartMicros;
+	stTransition.ui8Pump = ui8Pump;
+	stTransition.ui8ControlState = ui8ControlState;
+	stTransition.ui8OutputState = ui8OutputState;
+
+	if (this->_ulTransitionCount < this->_uiTimelineLength)
+	{
+		this->_pTimeline[this->_ulTransitionCount] = stTransition;
+	}
+
+	this->_ulTransitionCount++;
+
+	if (this->_pfTransitionListener != NULL)
+	{
+		(*this->_pfTransitionListener)(stTransition, this->_pTransitionContext);
+	}
+
+}
+
+void AcksenPumpSim::checkInvariants(uint8_t ui8Pump, uint64_t ullNow)
+{
+
+	AcksenPump *pPump = this->_pPumps[ui8Pump];
+
+	// Output must not stay ON above the Maximum Pump Temperature
+	bool bOverTemperature = (pPump->bEnableMaxPumpTemperature == true) && (pPump->iOutputStateActual == PUMP_OUTPUT_STATE_ON) &&
+		((long)pPump->pumpTemperatureCentidegrees() > ((long)pPump->iMaxPumpTemperature * 100L));
+
+	if (bOverTemperature == false)
+	{
+		this->_bOverTemperatureViolated[ui8Pump] = false;
+		this->_ullOverTemperatureSince[ui8Pump] = UINT64_MAX;
+	}
+	else if (this->_ullOverTemperatureSince[ui8Pump] == UINT64_MAX)
+	{
+		// Start of the grace period
+		this->_ullOverTemperatureSince[ui8Pump] = ullNow;
+	}
+	else if ((this->_bOverTemperatureViolated[ui8Pump] == false) && ((ullNow - this->_ullOverTemperatureSince[ui8Pump]) > ((uint64_t)this->ulTripGraceMillis * 1000ULL)))
+	{
+		this->_bOverTemperatureViolated[ui8Pump] = true;
+		violation(ui8Pump, PUMP_SIM_INVARIANT_OVER_TEMPERATURE, ullNow);
+	}
+
+	if (this->_pfInvariant != NULL)
+	{
+
+		bool bHeld = (*this->_pfInvariant)(pPump, ui8Pump, this->_pInvariantContext);
+
+		if ((bHeld == false) && (this->_bCustomViolated[ui8Pump] == false))
+		{
+			violation(ui8Pump, PUMP_SIM_INVARIANT_CUSTOM, ullNow);
+		}
+
+		this->_bCustomViolated[ui8Pump] = !bHeld;
+
+	}
+
+}
+
+void AcksenPumpSim::violation(uint8_t ui8Pump, uint8_t ui8Invariant, uint64_t ullNow)
+{
+
+	if (this->_ulViolationCount == 0)
+	{
+		this->_ui8FirstViolation = ui8Invariant;
+		this->_ui8FirstViolationPump = ui8Pump;
+		this->_ullFirstViolationMicros = ullNow - this->_ullStartMicros;
+	}
+
+	this->_ulViolationCount++;
+
+}
+
+uint8_t AcksenPumpSim::firstViolation(uint8_t &ui8Pump, uint64_t &ullMicros)
+{
+	ui8Pump = this->_ui8FirstViolationPump;
+	ullMicros = this->_ullFirstViolationMicros;
+	return this->_ui8FirstViolation;
+}
+
+void AcksenPumpSim::printTimeline(FILE *pFile)
+{
+
+	static const char *pControlStates[] = { "STOP", "VENT", "ON", "GRAIN REST", "SEQUENCE" };
+
+	unsigned long ulStored = (this->_ulTransitionCount < this->_uiTimelineLength) ? this->_ulTransitionCount : this->_uiTimelineLength;
+
+	for (unsigned long i = 0; i < ulStored; i++)
+	{
+
+		const AcksenPumpSimTransition &stTransition = this->_pTimeline[i];
+		unsigned long ulSeconds = (unsigned long)(stTransition.ullMicros / 1000000ULL);
+
+		fprintf(pFile, "%3lud %02lu:%02lu:%02lu.%03lu  pump %u  %-10s  output %s\n",
+			ulSeconds / 86400UL, (ulSeconds / 3600UL) % 24UL, (ulSeconds / 60UL) % 60UL, ulSeconds % 60UL,
+			(unsigned long)((stTransition.ullMicros / 1000ULL) % 1000ULL), stTransition.ui8Pump,
+			(stTransition.ui8ControlState <= PUMP_CONTROL_SEQUENCE) ? pControlStates[stTransition.ui8ControlState] : "?",
+			(stTransition.ui8OutputState == PUMP_OUTPUT_STATE_ON) ? "ON" : "OFF");
+
+	}
+
+	if (this->_ulTransitionCount > ulStored)
+	{
+		fprintf(pFile, "... %lu more transitions not stored\n", this->_ulTransitionCount - ulStored);
+	}
+
+}
+
+#endif
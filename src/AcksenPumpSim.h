@@ -0,0 +1,286 @@
+/*!
+@file AcksenPumpSim.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Time-warp simulator for Linux hosts.  Replays scripted scenarios against one or more pumps on the AcksenHalHost virtual clock,
+// jumping straight from one pump deadline or scenario event to the next, so days of operation run in a fraction of a second.
+// Records a timeline of Control State/Output transitions, and checks invariants after every step.
+//
+
+#ifndef AcksenPumpSim_h
+#define AcksenPumpSim_h
+
+#if !defined(ARDUINO)
+
+#include "AcksenPump.h"
+
+#include <stdio.h>
+
+#define PUMP_SIM_MAX_PUMPS						8		///< Maximum number of pumps driven by one simulator.
+#define PUMP_SIM_POLL_MICROS					1000	///< Time step used while a pump is polling (e.g. the Phase Sync input, or the pre-activation delay), in Microseconds.
+#define PUMP_SIM_MAX_PASSES						8		///< Maximum passes at the same instant while pumps report PUMP_YIELD_READY, before time is forced on.
+#define PUMP_SIM_TRIP_GRACE_MILLIS_DEFAULT		100		///< Default time a pump output may remain ON above iMaxPumpTemperature before an invariant violation, in Milliseconds.
+
+// Scenario Actions
+#define PUMP_SIM_ACTION_TOGGLE					0	///< Call ToggleState() on pump ui8Target.
+#define PUMP_SIM_ACTION_TURN_OFF				1	///< Call turnOff() on pump ui8Target.
+#define PUMP_SIM_ACTION_TEMPERATURE				2	///< Set the Pump Temperature of pump ui8Target to iValue, in hundredths of a degree Celsius.
+#define PUMP_SIM_ACTION_FLOW					3	///< Set the flow of pump ui8Target to iValue percent, with setFlowPercent().  Ignored unless ACKSEN_PUMP_ATTACHMENTS is 1.
+#define PUMP_SIM_ACTION_INPUT					4	///< Drive simulated input pin ui8Target to level iValue.
+#define PUMP_SIM_ACTION_PHASE_FREQUENCY			5	///< Set the Phase Sync waveform frequency to iValue Hz.  0 removes the waveform (supply lost).
+#define PUMP_SIM_ACTION_SCRIPT					6	///< Call the script callback with ui8Target and iValue.
+
+// Invariant Violations
+#define PUMP_SIM_INVARIANT_NONE					0	///< No violation.
+#define PUMP_SIM_INVARIANT_OVER_TEMPERATURE		1	///< Output ON while the Pump Temperature exceeded iMaxPumpTemperature, for longer than ulTripGraceMillis.
+#define PUMP_SIM_INVARIANT_CUSTOM				2	///< Invariant callback returned false.
+
+/// One scripted scenario event.  Scenarios are arrays of these, in time order.
+struct AcksenPumpSimEvent
+{
+	unsigned long ulTimeMillis;		///< Time from the start of the scenario (or of each repeat), in Milliseconds.
+	uint8_t ui8Action;				///< PUMP_SIM_ACTION_ value.
+	uint8_t ui8Target;				///< Pump index (as returned by addPump()), or pin number for PUMP_SIM_ACTION_INPUT.
+	int16_t iValue;					///< Action value.
+};
+
+/// One timeline entry, recorded whenever a pump Control State or Output State changes.
+struct AcksenPumpSimTransition
+{
+	uint64_t ullMicros;				///< Simulated time of the transition since the simulator started, in Microseconds.
+	uint8_t ui8Pump;				///< Pump index.
+	uint8_t ui8ControlState;		///< New Control State (PUMP_CONTROL_).
+	uint8_t ui8OutputState;			///< New Output State (PUMP_OUTPUT_STATE_).
+};
+
+/// Script callback, for PUMP_SIM_ACTION_SCRIPT events.
+typedef void (*AcksenPumpSimScript)(uint8_t ui8Target, int16_t iValue, void *pContext);
+
+/// Invariant callback, run for each pump after every step.  Return false on a violation.
+typedef bool (*AcksenPumpSimInvariant)(AcksenPump *pPump, uint8_t ui8Pump, void *pContext);
+
+/// Transition callback, run for each new timeline entry.
+typedef void (*AcksenPumpSimTransitionListener)(const AcksenPumpSimTransition &stTransition, void *pContext);
+
+/**************************************************************************/
+/*! 
+    @brief  Time-warp simulator, driving pumps through step() on the AcksenHalHost virtual clock
+*/
+/**************************************************************************/
+class AcksenPumpSim
+{
+
+public:
+
+	unsigned long ulTripGraceMillis = PUMP_SIM_TRIP_GRACE_MILLIS_DEFAULT;	///< Time a pump output may remain ON above iMaxPumpTemperature (Phase Sync wait, Thermal Governor filter, etc) before a violation is recorded, in Milliseconds.
+	bool bPhaseContinuous = false;		///< Generate every Phase Sync waveform edge, so an AcksenPhaseSync stays locked.  Otherwise edges are only generated while a pump is waiting for them, which is far faster.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.  Switches AcksenHalHost to the virtual clock.
+    @param  ullStartMicros
+            Virtual clock start time, in Microseconds.  Start within a few days of 2^32 Milliseconds to run a scenario across the millis() rollover.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpSim(uint64_t ullStartMicros = 0);
+
+/**************************************************************************/
+/*!
+    @brief  Add a pump to the simulation.  The pump is run with step(), so Non-Blocking Switching is enabled.
+    @param  pPump
+            Pump to add.
+    @return Index of the pump, used by scenario events and the timeline.  Returns -1 if the simulator is full.
+*/
+/**************************************************************************/
+	int addPump(AcksenPump *pPump);
+
+/**************************************************************************/
+/*!
+    @brief  Set the scenario to replay.  Events are applied from the present simulated time.
+    @param  pEvents
+            Array of scenario events, in time order.  Must remain valid while the simulation runs.
+    @param  uiCount
+            Number of events.
+    @param  ulRepeatMillis
+            Repeat the scenario with this period, in Milliseconds.  0 plays it once.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setScenario(const AcksenPumpSimEvent *pEvents, uint16_t uiCount, unsigned long ulRepeatMillis = 0);
+
+/**************************************************************************/
+/*!
+    @brief  Generate a Phase Sync waveform (mains Zero Crossing detector output) on a simulated input pin.
+    @param  iPin
+            Input pin.  Rising edges are Zero Crossings.
+    @param  ui8Hz
+            Supply frequency, in Hz.  0 for no waveform.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setPhaseInput(int iPin, uint8_t ui8Hz);
+
+/**************************************************************************/
+/*!
+    @brief  Set the callback run by PUMP_SIM_ACTION_SCRIPT events, for anything scenarios cannot script directly.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setScript(AcksenPumpSimScript pfScript, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Set an additional invariant, checked for each pump after every step.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setInvariant(AcksenPumpSimInvariant pfInvariant, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Set a callback run for every transition, e.g. to stream the timeline.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setTransitionListener(AcksenPumpSimTransitionListener pfListener, void *pContext);
+
+/**************************************************************************/
+/*!
+    @brief  Record the timeline into a buffer.  Once full, further transitions are counted but not stored.
+    @param  pTimeline
+            Buffer for the timeline.  NULL to stop recording.
+    @param  uiLength
+            Buffer length, in entries.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setTimeline(AcksenPumpSimTransition *pTimeline, uint16_t uiLength);
+
+/**************************************************************************/
+/*!
+    @brief  Run the simulation.
+    @param  ulDurationMillis
+            Simulated time to run for, in Milliseconds.
+    @return Number of invariant violations found so far.
+*/
+/**************************************************************************/
+	unsigned long run(unsigned long ulDurationMillis);
+
+/**************************************************************************/
+/*!
+    @brief  Print the recorded timeline, one transition per line.
+    @param  pFile
+            Destination, e.g. stdout.
+    @return No return value.
+*/
+/**************************************************************************/
+	void printTimeline(FILE *pFile);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of transitions recorded.
+    @return Transition count, including any beyond the end of the timeline buffer.
+*/
+/**************************************************************************/
+	unsigned long transitionCount() { return this->_ulTransitionCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of times the pumps were stepped.
+    @return Step count.
+*/
+/**************************************************************************/
+	unsigned long stepCount() { return this->_ulStepCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of invariant violations.  Each violation is counted once, when it starts.
+    @return Violation count.
+*/
+/**************************************************************************/
+	unsigned long violationCount() { return this->_ulViolationCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the first invariant violation.
+    @param  ui8Pump
+            Receives the pump index.
+    @param  ullMicros
+            Receives the simulated time since the simulator started, in Microseconds.
+    @return PUMP_SIM_INVARIANT_ value.  PUMP_SIM_INVARIANT_NONE if there have been no violations.
+*/
+/**************************************************************************/
+	uint8_t firstViolation(uint8_t &ui8Pump, uint64_t &ullMicros);
+
+protected:
+
+	void applyEvents(uint64_t ullNow);
+	void applyEvent(const AcksenPumpSimEvent &evEvent);
+	uint64_t nextScenarioMicros();
+	uint64_t nextPhaseEdgeMicros(uint64_t ullNow);
+	void phaseEdge(uint64_t ullNow);
+	void recordTransition(uint8_t ui8Pump, uint64_t ullNow);
+	void checkInvariants(uint8_t ui8Pump, uint64_t ullNow);
+	void violation(uint8_t ui8Pump, uint8_t ui8Invariant, uint64_t ullNow);
+
+	AcksenPump *_pPumps[PUMP_SIM_MAX_PUMPS];
+	uint8_t _ui8PumpCount = 0;
+	uint8_t _ui8LastControlState[PUMP_SIM_MAX_PUMPS];
+	uint8_t _ui8LastOutputState[PUMP_SIM_MAX_PUMPS];
+	uint64_t _ullOverTemperatureSince[PUMP_SIM_MAX_PUMPS];
+	bool _bOverTemperatureViolated[PUMP_SIM_MAX_PUMPS];
+	bool _bCustomViolated[PUMP_SIM_MAX_PUMPS];
+
+	const AcksenPumpSimEvent *_pEvents = NULL;
+	uint16_t _uiEventCount = 0;
+	uint16_t _uiNextEvent = 0;
+	unsigned long _ulRepeatMillis = 0;
+	uint64_t _ullScenarioStart = 0;
+	uint64_t _ullStartMicros = 0;
+
+	int _iPhasePin = -1;
+	uint8_t _ui8PhaseHz = 0;
+
+	AcksenPumpSimScript _pfScript = NULL;
+	void *_pScriptContext = NULL;
+	AcksenPumpSimInvariant _pfInvariant = NULL;
+	void *_pInvariantContext = NULL;
+	AcksenPumpSimTransitionListener _pfTransitionListener = NULL;
+	void *_pTransitionContext = NULL;
+
+	AcksenPumpSimTransition *_pTimeline = NULL;
+	uint16_t _uiTimelineLength = 0;
+	unsigned long _ulTransitionCount = 0;
+
+	unsigned long _ulStepCount = 0;
+	unsigned long _ulViolationCount = 0;
+	uint8_t _ui8FirstViolation = PUMP_SIM_INVARIANT_NONE;
+	uint8_t _ui8FirstViolationPump = 0;
+	uint64_t _ullFirstViolationMicros = 0;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,317 @@
+/*!
+@file AcksenPumpSupply.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPumpSupply.h"
+#include "AcksenPump.h"
+
+#include <string.h>
+
+AcksenPumpSupply::AcksenPumpSupply()
+{
+	memset(this->_pPumps, 0, sizeof(this->_pPumps));
+	memset(this->_ui8States, 0, sizeof(this->_ui8States));
+	memset(this->_bInrush, 0, sizeof(this->_bInrush));
+	memset(this->_ulLatency, 0, sizeof(this->_ulLatency));
+	memset(this->_ulMaxLatency, 0, sizeof(this->_ulMaxLatency));
+}
+
+int AcksenPumpSupply::addPump(AcksenPump *pPump, uint8_t ui8Weight, uint8_t ui8Priority)
+{
+
+#if ACKSEN_PUMP_ATTACHMENTS
+	if ((pPump == NULL) || (this->_ui8PumpCount >= PUMP_SUPPLY_MAX_PUMPS))
+	{
+		return -1;
+	}
+
+	uint8_t i = this->_ui8PumpCount++;
+
+	this->_pPumps[i] = pPump;
+	this->_ui8Weights[i] = ui8Weight;
+	this->_ui8Priorities[i] = ui8Priority;
+
+	pPump->attachSupply(this);
+
+	return i;
+#else
+	// AcksenPump::attachSupply() is compiled out
+	(void)pPump;
+	(void)ui8Weight;
+	(void)ui8Priority;
+
+	return -1;
+#endif
+
+}
+
+bool AcksenPumpSupply::requestStart(AcksenPump *pPump, unsigned long ulTimeNow)
+{
+
+	int i = findPump(pPump);
+
+	if (i == -1)
+	{
+		// Not on this supply
+		return true;
+	}
+
+	if (this->_ui8States[i] == PUMP_SUPPLY_IDLE)
+	{
+		this->_ui8States[i] = PUMP_SUPPLY_QUEUED;
+		this->_ulRequestMillis[i] = ulTimeNow;
+	}
+
+	release(ulTimeNow);
+
+	if (this->_ui8States[i] != PUMP_SUPPLY_RELEASED)
+	{
+		return false;
+	}
+
+	// Taken
+	this->_ui8States[i] = PUMP_SUPPLY_IDLE;
+
+	return true;
+
+}
+
+void AcksenPumpSupply::requestCleared(AcksenPump *pPump)
+{
+
+	int i = findPump(pPump);
+
+	if ((i == -1) || (this->_ui8States[i] == PUMP_SUPPLY_IDLE))
+	{
+		return;
+	}
+
+	if (this->_ui8States[i] == PUMP_SUPPLY_RELEASED)
+	{
+		// Never switched ON - give the budget back
+		this->_bInrush[i] = false;
+	}
+
+	this->_ui8States[i] = PUMP_SUPPLY_IDLE;
+
+}
+
+bool AcksenPumpSupply::waiting(AcksenPump *pPump)
+{
+
+	int i = findPump(pPump);
+
+	return ((i != -1) && (this->_ui8States[i] != PUMP_SUPPLY_IDLE));
+
+}
+
+unsigned long AcksenPumpSupply::nextReleaseMillis(AcksenPump *pPump, unsigned long ulTimeNow)
+{
+
+	int i = findPump(pPump);
+
+	if ((i == -1) || (this->_ui8States[i] != PUMP_SUPPLY_QUEUED))
+	{
+		// Released (or not waiting) - ask again now
+		return ulTimeNow;
+	}
+
+	unsigned long ulRelease = ulTimeNow;
+
+	// Stagger gap after the last release
+	if ((this->_bReleased == true) && ((int32_t)((this->_ulLastReleaseMillis + this->ulStaggerTime) - ulRelease) > 0))
+	{
+		ulRelease = this->_ulLastReleaseMillis + this->ulStaggerTime;
+	}
+
+	// Earliest end of an inrush window, if the budget is in use
+	if ((activeWeight(ulTimeNow) + this->_ui8Weights[i]) > this->uiBudget)
+	{
+
+		bool bFound = false;
+		unsigned long ulEarliestEnd = ulTimeNow;
+
+		// Windows are held in pump order, not end order - take the earliest of them all
+		for (uint8_t j = 0; j < this->_ui8PumpCount; j++)
+		{
+
+			if (this->_bInrush[j] == true)
+			{
+
+				unsigned long ulInrushEnd = this->_ulReleaseMillis[j] + this->ulInrushTime;
+
+				if ((bFound == false) || ((int32_t)(ulInrushEnd - ulEarliestEnd) < 0))
+				{
+					ulEarliestEnd = ulInrushEnd;
+					bFound = true;
+				}
+
+			}
+
+		}
+
+		if ((bFound == true) && ((int32_t)(ulEarliestEnd - ulRelease) > 0))
+		{
+			ulRelease = ulEarliestEnd;
+		}
+
+	}
+
+	return ulRelease;
+
+}
+
+uint8_t AcksenPumpSupply::queueDepth(void)
+{
+
+	uint8_t ui8Depth = 0;
+
+	for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+	{
+
+		if (this->_ui8States[i] == PUMP_SUPPLY_QUEUED)
+		{
+			ui8Depth++;
+		}
+
+	}
+
+	return ui8Depth;
+
+}
+
+uint16_t AcksenPumpSupply::activeWeight(unsigned long ulTimeNow)
+{
+
+	uint16_t uiWeight = 0;
+
+	for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+	{
+
+		if (this->_bInrush[i] == false)
+		{
+			continue;
+		}
+
+		if ((uint32_t)(ulTimeNow - this->_ulReleaseMillis[i]) >= this->ulInrushTime)
+		{
+			// Inrush over
+			this->_bInrush[i] = false;
+			continue;
+		}
+
+		uiWeight += this->_ui8Weights[i];
+
+	}
+
+	return uiWeight;
+
+}
+
+unsigned long AcksenPumpSupply::startLatency(int iPump)
+{
+	return ((iPump >= 0) && (iPump < this->_ui8PumpCount)) ? this->_ulLatency[iPump] : 0;
+}
+
+unsigned long AcksenPumpSupply::maxStartLatency(int iPump)
+{
+	return ((iPump >= 0) && (iPump < this->_ui8PumpCount)) ? this->_ulMaxLatency[iPump] : 0;
+}
+
+int AcksenPumpSupply::findPump(AcksenPump *pPump)
+{
+
+	for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+	{
+
+		if (this->_pPumps[i] == pPump)
+		{
+			return i;
+		}
+
+	}
+
+	return -1;
+
+}
+
+void AcksenPumpSupply::release(unsigned long ulTimeNow)
+{
+
+	while (true)
+	{
+
+		// Head of the queue - highest priority, then longest waiting.  The queue is at most PUMP_SUPPLY_MAX_PUMPS long, so a scan beats keeping a heap.
+		int iHead = -1;
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+
+			if (this->_ui8States[i] != PUMP_SUPPLY_QUEUED)
+			{
+				continue;
+			}
+
+			if ((iHead == -1) || (this->_ui8Priorities[i] > this->_ui8Priorities[iHead]) ||
+				((this->_ui8Priorities[i] == this->_ui8Priorities[iHead]) && ((uint32_t)(ulTimeNow - this->_ulRequestMillis[i]) > (uint32_t)(ulTimeNow - this->_ulRequestMillis[iHead]))))
+			{
+				iHead = i;
+			}
+
+		}
+
+		if (iHead == -1)
+		{
+			return;
+		}
+
+		if ((this->_bReleased == true) && ((uint32_t)(ulTimeNow - this->_ulLastReleaseMillis) < this->ulStaggerTime))
+		{
+			return;
+		}
+
+		uint16_t uiActiveWeight = activeWeight(ulTimeNow);
+
+		// Lower priorities wait behind the head, even if they would fit, so heavy pumps are not starved
+		if ((uiActiveWeight != 0) && ((uiActiveWeight + this->_ui8Weights[iHead]) > this->uiBudget))
+		{
+			return;
+		}
+
+		this->_ui8States[iHead] = PUMP_SUPPLY_RELEASED;
+		this->_bInrush[iHead] = true;
+		this->_ulReleaseMillis[iHead] = ulTimeNow;
+
+		this->_ulLatency[iHead] = (uint32_t)(ulTimeNow - this->_ulRequestMillis[iHead]);
+
+		if (this->_ulLatency[iHead] > this->_ulMaxLatency[iHead])
+		{
+			this->_ulMaxLatency[iHead] = this->_ulLatency[iHead];
+		}
+
+		this->_ulLastReleaseMillis = ulTimeNow;
+		this->_bReleased = true;
+		this->_ulStartCount++;
+
+	}
+
+}
@@ -0,0 +1,200 @@
+/*!
+@file AcksenPumpSupply.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Inrush-aware start scheduler for pumps sharing one supply.  OFF to ON transitions wait in a priority queue, and are released one at a time,
+// staggered by a minimum gap, while the start-current weight of pumps still within their inrush window stays within the supply budget.
+//
+
+#ifndef AcksenPumpSupply_h
+#define AcksenPumpSupply_h
+
+#include "AcksenPumpHal.h"
+
+class AcksenPump;
+
+// *** SUPPLY CONSTANTS ***
+#define PUMP_SUPPLY_MAX_PUMPS					8		///< Maximum number of pumps on one AcksenPumpSupply.
+#define PUMP_SUPPLY_BUDGET_DEFAULT				1		///< Default total start weight allowed within the inrush window (1 = one pump starting at a time, with the default weight).
+#define PUMP_SUPPLY_WEIGHT_DEFAULT				1		///< Default start weight of a pump.
+#define PUMP_SUPPLY_STAGGER_DEFAULT				250		///< Default minimum gap between releasing two starts, in Milliseconds.
+#define PUMP_SUPPLY_INRUSH_DEFAULT				1000	///< Default time a start counts against the budget, in Milliseconds.
+
+// Pump Start States
+#define PUMP_SUPPLY_IDLE						0	///< No start wanted.
+#define PUMP_SUPPLY_QUEUED						1	///< Waiting to be released.
+#define PUMP_SUPPLY_RELEASED					2	///< Released, and not yet switched ON by the pump.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that schedules pump starts on a shared supply, to keep combined inrush current within a limit.
+			Pumps are added with addPump(), and then ask for every OFF to ON transition (including each Ventilation pulse), so starts across pumps are interleaved.
+			OFF transitions are never delayed.
+*/
+/**************************************************************************/
+class AcksenPumpSupply
+{
+
+public:
+
+	uint16_t uiBudget = PUMP_SUPPLY_BUDGET_DEFAULT;					///< Total start weight allowed within the inrush window.  A pump heavier than the budget can still start, alone.
+	unsigned long ulStaggerTime = PUMP_SUPPLY_STAGGER_DEFAULT;		///< Minimum gap between releasing two starts, in Milliseconds.
+	unsigned long ulInrushTime = PUMP_SUPPLY_INRUSH_DEFAULT;		///< Time each start counts against the budget, in Milliseconds.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpSupply();
+
+/**************************************************************************/
+/*!
+    @brief  Add a pump to the supply.  Attaches the supply to the pump, so its starts are scheduled.
+    @param  pPump
+            Pump to add.
+    @param  ui8Weight
+            Start-current weight of the pump, in any unit shared with uiBudget (e.g. Amps).
+    @param  ui8Priority
+            Priority of the pump's starts.  Higher priorities are released first, then the longest waiting.
+    @return Index of the pump in the supply, used by the statistics functions.  Returns -1 if the supply is full, or ACKSEN_PUMP_ATTACHMENTS is 0.
+*/
+/**************************************************************************/
+	int addPump(AcksenPump *pPump, uint8_t ui8Weight = PUMP_SUPPLY_WEIGHT_DEFAULT, uint8_t ui8Priority = 0);
+
+/**************************************************************************/
+/*!
+    @brief  Ask if a pump may switch ON now.  Called by AcksenPump each pass while an OFF to ON transition is wanted.
+    @param  pPump
+            Pump asking.
+    @param  ulTimeNow
+            Present millis() time.
+    @return Returns true if the pump may switch ON now.
+			Returns false if it must wait in the queue until nextReleaseMillis().
+*/
+/**************************************************************************/
+	bool requestStart(AcksenPump *pPump, unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Tell the supply that a pump no longer wants to start.  Removes it from the queue, and returns any unused release.
+    @param  pPump
+            Pump.
+    @return No return value.
+*/
+/**************************************************************************/
+	void requestCleared(AcksenPump *pPump);
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a pump is waiting to start.
+    @param  pPump
+            Pump.
+    @return Returns true if the pump is queued, or released but not yet switched ON.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool waiting(AcksenPump *pPump);
+
+/**************************************************************************/
+/*!
+    @brief  Get the earliest time a waiting pump could be released.  Pumps behind a higher priority start may have to wait longer.
+    @param  pPump
+            Pump.
+    @param  ulTimeNow
+            Present millis() time.
+    @return millis() time to next ask.
+*/
+/**************************************************************************/
+	unsigned long nextReleaseMillis(AcksenPump *pPump, unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of pumps waiting in the queue.
+    @return Queue depth.
+*/
+/**************************************************************************/
+	uint8_t queueDepth();
+
+/**************************************************************************/
+/*!
+    @brief  Get the start weight presently within its inrush window.
+    @param  ulTimeNow
+            Present millis() time.
+    @return Total weight.
+*/
+/**************************************************************************/
+	uint16_t activeWeight(unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Get the time the last start of a pump waited in the queue.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return Start latency, in Milliseconds.
+*/
+/**************************************************************************/
+	unsigned long startLatency(int iPump);
+
+/**************************************************************************/
+/*!
+    @brief  Get the longest time any start of a pump waited in the queue.
+    @param  iPump
+            Pump index, as returned by addPump().
+    @return Maximum start latency, in Milliseconds.
+*/
+/**************************************************************************/
+	unsigned long maxStartLatency(int iPump);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of starts released.
+    @return Start count.
+*/
+/**************************************************************************/
+	unsigned long startCount() { return this->_ulStartCount; }
+
+protected:
+
+	int findPump(AcksenPump *pPump);
+	void release(unsigned long ulTimeNow);
+
+	AcksenPump *_pPumps[PUMP_SUPPLY_MAX_PUMPS];
+	uint8_t _ui8Weights[PUMP_SUPPLY_MAX_PUMPS];
+	uint8_t _ui8Priorities[PUMP_SUPPLY_MAX_PUMPS];
+	uint8_t _ui8States[PUMP_SUPPLY_MAX_PUMPS];
+	bool _bInrush[PUMP_SUPPLY_MAX_PUMPS];				// Start released, and may still be within its inrush window
+	unsigned long _ulRequestMillis[PUMP_SUPPLY_MAX_PUMPS];
+	unsigned long _ulReleaseMillis[PUMP_SUPPLY_MAX_PUMPS];
+	unsigned long _ulLatency[PUMP_SUPPLY_MAX_PUMPS];
+	unsigned long _ulMaxLatency[PUMP_SUPPLY_MAX_PUMPS];
+	uint8_t _ui8PumpCount = 0;
+
+	unsigned long _ulLastReleaseMillis = 0;
+	bool _bReleased = false;
+	unsigned long _ulStartCount = 0;
+
+};
+
+#endif
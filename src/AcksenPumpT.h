@@ -0,0 +1,736 @@
+/*!
+@file AcksenPumpT.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Compile-time specialised Pump, with pins and switching logic fixed as template parameters, and unused features removed entirely.
+// Disabled features carry no fields (empty base classes) and no code (tag dispatch to empty overloads), so the hot path has no runtime feature checks.
+// AcksenPump remains the runtime-configurable flavour.
+//
+// AcksenPumpT runs its own Pump Ventilation, manual Grain Rest and Maximum Pump Temperature logic, rather than the AcksenPump Sequence engine, and always switches without blocking.
+// It does NOT support, and a pump needing any of these should be an AcksenPump:
+//   - Periodic Grain Rests (iGrainRestPeriod, mashing control and the Set Point inhibit) - call beginGrainRest() from the calling software instead
+//   - Pump Sequences (runSequence()) and Burst-Fire flow (setFlowPercent())
+//   - AcksenThermalGovernor, AcksenRelayGuard, AcksenPumpSupply and AcksenPrimeMonitor
+//   - AcksenPumpEventQueue, getConfig()/setConfig(), step(), profiling counters, AcksenPumpTelemetry and AcksenPumpSim
+//
+// Example:
+//   AcksenPumpT<13, -1, PUMP_LOGIC_POSITIVE, PUMP_FEATURE_VENTILATION | PUMP_FEATURE_MAX_TEMPERATURE> WaterPump;
+//
+
+#ifndef AcksenPumpT_h
+#define AcksenPumpT_h
+
+#include "AcksenPumpHal.h"
+#include "AcksenPump.h"
+#include "AcksenPhaseSync.h"
+
+// *** TEMPLATE PUMP CONSTANTS ***
+#define PUMP_LOGIC_POSITIVE						0	///< Pump Output uses Positive Logic (1=ON, 0=OFF).
+#define PUMP_LOGIC_NEGATIVE						1	///< Pump Output uses Negative Logic (0=ON, 1=OFF).
+
+// Features
+#define PUMP_FEATURE_VENTILATION				0x01	///< Include the Pump Ventilation system.
+#define PUMP_FEATURE_GRAIN_REST					0x02	///< Include the Grain Rest system.
+#define PUMP_FEATURE_PHASE_SYNC					0x04	///< Include Voltage Phase Sync for switching.
+#define PUMP_FEATURE_MAX_TEMPERATURE			0x08	///< Include the Maximum Pump Temperature system.
+#define PUMP_FEATURE_LCD_CALLBACK				0x10	///< Include the LCD reinitialisation callback, and attachNotifier().
+#define PUMP_FEATURES_ALL						0x1F	///< Include every feature.
+
+/// Tag type used to select the enabled or disabled implementation of a feature at compile time
+template <bool Enabled> struct AcksenPumpFeature {};
+
+/**************************************************************************/
+/*! 
+    @brief  Ventilation feature storage.  Empty when the feature is disabled.
+*/
+/**************************************************************************/
+template <bool Enabled> struct AcksenPumpVentilationStorage
+{
+	uint8_t iPumpVentilationCycles = PUMP_VENTILATION_CYCLE_COUNT_DEFAULT;	///< Number of Pump Ventilation ON/OFF cycles on startup
+	uint16_t uiPumpVentilationOnLengthMillis = PUMP_VENTILATION_CYCLE_ON_TIME_DEFAULT * 1000U;	///< Length of Pump being set to ON during Ventilation Cycle, in Milliseconds.
+	uint16_t uiPumpVentilationOffLengthMillis = PUMP_VENTILATION_CYCLE_OFF_TIME_DEFAULT * 1000U;	///< Length of Pump being set to OFF during Ventilation Cycle, in Milliseconds.
+	uint8_t iVentilationCycleRuntimeCount = 0;	///< Number of Pump Ventilation Cycles that have been executed in present Ventilation phase
+protected:
+	unsigned long _ulVentEndMillis = 0;
+};
+template <> struct AcksenPumpVentilationStorage<false> {};
+
+/**************************************************************************/
+/*! 
+    @brief  Grain Rest feature storage.  Empty when the feature is disabled.
+*/
+/**************************************************************************/
+template <bool Enabled> struct AcksenPumpGrainRestStorage
+{
+	uint8_t iGrainRestLength = GRAIN_REST_LENGTH_DEFAULT;	///< Length of Grain Rest (how long pump will be OFF for, before restarting), in Minutes.
+protected:
+	unsigned long _ulGrainRestEndMillis = 0;
+};
+template <> struct AcksenPumpGrainRestStorage<false> {};
+
+/**************************************************************************/
+/*! 
+    @brief  Phase Sync feature storage.  Empty when the feature is disabled.
+*/
+/**************************************************************************/
+template <bool Enabled> struct AcksenPumpPhaseSyncStorage
+{
+	uint8_t iPhaseSyncPreActivationDelay = PHASE_SYNC_PRE_ACTIVATION_DELAY_DEFAULT;	///< Delay between detecting Zero Crossing, and changing Pump Output State, in Milliseconds.
+protected:
+	AcksenPhaseSync *_pPhaseSync = NULL;
+	AcksenHal::FastPin _fpPhaseSyncInput;
+	uint8_t _ui8PhaseSyncLastLevel = HIGH;
+	bool _bPhaseSyncEdgeSeen = false;
+	unsigned long _ulPhaseSyncTarget = 0;	// millis() of the polled edge, micros() an AcksenPhaseSync wait started, or micros() of the shared or predicted edge plus delay
+	bool _bPhaseSyncPredicted = false;
+};
+template <> struct AcksenPumpPhaseSyncStorage<false> {};
+
+/**************************************************************************/
+/*! 
+    @brief  Maximum Pump Temperature feature storage.  Empty when the feature is disabled.
+*/
+/**************************************************************************/
+template <bool Enabled> struct AcksenPumpMaxTemperatureStorage
+{
+	int iMaxPumpTemperature = MAX_PUMP_TEMP_DEFAULT;	///< Maximum Pump Operating Temperature, in Celsius.
+protected:
+	int16_t _iPumpTemperatureCenti = 0;
+};
+template <> struct AcksenPumpMaxTemperatureStorage<false> {};
+
+/**************************************************************************/
+/*! 
+    @brief  LCD Callback feature storage.  Empty when the feature is disabled.
+*/
+/**************************************************************************/
+template <bool Enabled> struct AcksenPumpLcdCallbackStorage
+{
+	void (*callbackInitLCDs)() = NULL;	///< Callback to allow reinitialisation of any attached LCD displays after Pump Output Change.
+protected:
+	AcksenPumpNotifier *_pNotifier = NULL;
+};
+template <> struct AcksenPumpLcdCallbackStorage<false> {};
+
+/**************************************************************************/
+/*! 
+    @brief  Class that defines a compile-time specialised Pump.  Supports a subset of AcksenPump features - see the notes at the top of this file.
+    @tparam OutputPin
+            The Arduino I/O pin assigned to the Pump Output.
+    @tparam PhasePin
+            The Arduino I/O pin assigned to the Voltage Phase Sync Output, or -1 if not used (or if attachPhaseSync() is used instead).
+    @tparam Logic
+            PUMP_LOGIC_POSITIVE or PUMP_LOGIC_NEGATIVE.
+    @tparam Features
+            Combination of PUMP_FEATURE_* flags.
+*/
+/**************************************************************************/
+template <int OutputPin, int PhasePin = -1, int Logic = PUMP_LOGIC_POSITIVE, uint8_t Features = PUMP_FEATURES_ALL>
+class AcksenPumpT :
+	public AcksenPumpVentilationStorage<(Features & PUMP_FEATURE_VENTILATION) != 0>,
+	public AcksenPumpGrainRestStorage<(Features & PUMP_FEATURE_GRAIN_REST) != 0>,
+	public AcksenPumpPhaseSyncStorage<(Features & PUMP_FEATURE_PHASE_SYNC) != 0>,
+	public AcksenPumpMaxTemperatureStorage<(Features & PUMP_FEATURE_MAX_TEMPERATURE) != 0>,
+	public AcksenPumpLcdCallbackStorage<(Features & PUMP_FEATURE_LCD_CALLBACK) != 0>
+{
+
+	typedef AcksenPumpFeature<(Features & PUMP_FEATURE_VENTILATION) != 0> VentilationFeature;
+	typedef AcksenPumpFeature<(Features & PUMP_FEATURE_GRAIN_REST) != 0> GrainRestFeature;
+	typedef AcksenPumpFeature<(Features & PUMP_FEATURE_PHASE_SYNC) != 0> PhaseSyncFeature;
+	typedef AcksenPumpFeature<(Features & PUMP_FEATURE_MAX_TEMPERATURE) != 0> MaxTemperatureFeature;
+	typedef AcksenPumpFeature<(Features & PUMP_FEATURE_LCD_CALLBACK) != 0> LcdCallbackFeature;
+
+public:
+
+	static constexpr int iPumpOnState = (Logic == PUMP_LOGIC_NEGATIVE) ? PUMP_NEGATIVE_LOGIC_ON : PUMP_POSITIVE_LOGIC_ON;		///< Output State that is set when Pump is ON.
+	static constexpr int iPumpOffState = (Logic == PUMP_LOGIC_NEGATIVE) ? PUMP_NEGATIVE_LOGIC_OFF : PUMP_POSITIVE_LOGIC_OFF;	///< Output State that is set when Pump is OFF.
+
+	uint8_t iOperatingMode = PUMP_OPERATING_MODE_OFF;		///< Pump Operating Mode
+	uint8_t iControlState = PUMP_CONTROL_STOP;				///< Pump Control State
+	uint8_t iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;	///< Pump Output State that has been Requested
+	uint8_t iOutputStateActual = PUMP_OUTPUT_STATE_OFF;		///< Actual Pump Output State presently
+
+	unsigned int iPumpRelaySwitchingDelay = PUMP_RELAY_SWITCHING_DELAY;	///< Relay settling window after switching Pump Output ON/OFF, in Milliseconds.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.  Configures the pins, and sets the Pump OFF.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpT()
+	{
+
+		AcksenHal::setPinMode(OutputPin, OUTPUT);
+		AcksenHal::writePin(OutputPin, iPumpOffState);
+		AcksenHal::resolveFastPin(this->_fpPumpOutput, OutputPin);
+
+		initPhaseSync(PhaseSyncFeature());
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief 	Toggle the Pump State (from ON to OFF, or OFF to ON)
+    @return No return value.
+*/
+/**************************************************************************/
+	void ToggleState()
+	{
+
+		if (this->iControlState != PUMP_CONTROL_STOP)
+		{
+			turnOff();
+			return;
+		}
+
+		// Check to see if the Pump Temperature has exceeded Maximum Levels
+		if (overTemperature(MaxTemperatureFeature()) == true)
+		{
+			// Ignore Pump Activation
+			return;
+		}
+
+		startPump(VentilationFeature());
+		this->iOperatingMode = PUMP_OPERATING_MODE_ON;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Turn the Pump OFF.  The output change is applied by process().
+    @return No return value.
+*/
+/**************************************************************************/
+	void turnOff()
+	{
+		this->iControlState = PUMP_CONTROL_STOP;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		this->iOperatingMode = PUMP_OPERATING_MODE_OFF;
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Start a Grain Rest on a running Pump, of iGrainRestLength minutes.  Only available with PUMP_FEATURE_GRAIN_REST.
+    @return No return value.
+*/
+/**************************************************************************/
+	void beginGrainRest()
+	{
+
+		static_assert((Features & PUMP_FEATURE_GRAIN_REST) != 0, "beginGrainRest() requires PUMP_FEATURE_GRAIN_REST");
+
+		if (this->iOperatingMode != PUMP_OPERATING_MODE_ON)
+		{
+			return;
+		}
+
+		this->iControlState = PUMP_CONTROL_GRAIN_REST;
+		this->_ulGrainRestEndMillis = AcksenHal::timeMillis() + ((unsigned long)this->iGrainRestLength * 60000UL);
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Set the Pump Temperature, using an external temperature reading.  Ignored without PUMP_FEATURE_MAX_TEMPERATURE.
+			NaN or out of range readings are stored as PUMP_TEMPERATURE_FAIL_SAFE_CENTIDEGREES.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updatePumpTemperature(float fNewPumpTemperature)
+	{
+		storeTemperature(AcksenPumpCentidegrees(fNewPumpTemperature), MaxTemperatureFeature());
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Set the Pump Temperature, in hundredths of a degree Celsius.  Avoids floating point.  Ignored without PUMP_FEATURE_MAX_TEMPERATURE.
+    @return No return value.
+*/
+/**************************************************************************/
+	void updatePumpTemperatureCentidegrees(int16_t iCentidegrees)
+	{
+		storeTemperature(iCentidegrees, MaxTemperatureFeature());
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Use an interrupt-driven AcksenPhaseSync for Voltage Phase Sync.  Only available with PUMP_FEATURE_PHASE_SYNC.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachPhaseSync(AcksenPhaseSync *pPhaseSync)
+	{
+		static_assert((Features & PUMP_FEATURE_PHASE_SYNC) != 0, "attachPhaseSync() requires PUMP_FEATURE_PHASE_SYNC");
+		this->_pPhaseSync = pPhaseSync;
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Notify an AcksenPumpNotifier of each Pump Output transition, as well as calling callbackInitLCDs.  Only available with PUMP_FEATURE_LCD_CALLBACK.
+    @return No return value.
+*/
+/**************************************************************************/
+	void attachNotifier(AcksenPumpNotifier *pNotifier)
+	{
+		static_assert((Features & PUMP_FEATURE_LCD_CALLBACK) != 0, "attachNotifier() requires PUMP_FEATURE_LCD_CALLBACK");
+		this->_pNotifier = pNotifier;
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if the Actual Output State of the Pump has needed to change since last called.
+    @return Returns true if the state changed.
+			Returns false if the state did not change.
+*/
+/**************************************************************************/
+	bool stateChangeOccurred()
+	{
+
+		if (this->_bStateChangeOccurred == true)
+		{
+			this->_bStateChangeOccurred = false;
+			return true;
+		}
+
+		return false;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a Pump Output transition is still in progress.
+    @return Returns true if the Pump Output has settled, and no transition is pending.
+*/
+/**************************************************************************/
+	bool switchingSettled() { return (this->_ui8SwitchState == PUMP_SWITCH_STATE_SETTLED); }
+
+/**************************************************************************/
+/*!
+    @brief  Get the time at which process() next has work to do.
+    @return millis() time of the next deadline.  Equal to millis() if process() should be called again immediately.
+*/
+/**************************************************************************/
+	unsigned long nextEventMillis()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		if (this->_ui8SwitchState == PUMP_SWITCH_STATE_SETTLING)
+		{
+			return this->_ulSettlingEndTime;
+		}
+
+		if ((this->_ui8SwitchState == PUMP_SWITCH_STATE_PENDING) || (this->_ui8OutputLevel != demandLevel()))
+		{
+			return ulTimeNow;
+		}
+
+		unsigned long ulNextEvent = ulTimeNow + PUMP_NEXT_EVENT_IDLE_INTERVAL;
+
+		ventilationDeadline(ulNextEvent, VentilationFeature());
+		grainRestDeadline(ulNextEvent, GrainRestFeature());
+
+		return ulNextEvent;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Process any updates to automatic Pump operations, and advance any Pump Output transition.  This should be called regularly.  Never blocks.
+    @return No return value.
+*/
+/**************************************************************************/
+	void process()
+	{
+
+		unsigned long ulTimeNow = AcksenHal::timeMillis();
+
+		if (overTemperature(MaxTemperatureFeature()) == true)
+		{
+			// Ensure that the Pump is turned off!
+			this->iControlState = PUMP_CONTROL_STOP;
+			this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		}
+		else
+		{
+			processVentilation(ulTimeNow, VentilationFeature());
+			processGrainRest(ulTimeNow, GrainRestFeature());
+		}
+
+		processSwitching(ulTimeNow);
+
+	}
+
+protected:
+
+	AcksenHal::FastPin _fpPumpOutput;
+	uint8_t _ui8OutputLevel = iPumpOffState;	// Shadow copy of the level last written to the Pump Output
+	uint8_t _ui8SwitchState = PUMP_SWITCH_STATE_SETTLED;
+	bool _bStateChangeOccurred = false;
+	unsigned long _ulSwitchStartTime = 0;
+	unsigned long _ulSettlingEndTime = 0;
+
+	uint8_t demandLevel()
+	{
+		return (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON) ? iPumpOnState : iPumpOffState;
+	}
+
+	void processSwitching(unsigned long ulTimeNow)
+	{
+
+		uint8_t ui8DemandLevel = demandLevel();
+
+		if (this->iOutputStateRequested != this->iOutputStateActual)
+		{
+			// Set State Change Occurred flag for use by calling software
+			this->_bStateChangeOccurred = true;
+		}
+
+		if (this->_ui8SwitchState == PUMP_SWITCH_STATE_SETTLED)
+		{
+
+			if (this->_ui8OutputLevel == ui8DemandLevel)
+			{
+				this->iOutputStateActual = this->iOutputStateRequested;
+				return;
+			}
+
+			// Queue the transition
+			this->_ui8SwitchState = PUMP_SWITCH_STATE_PENDING;
+			this->_ulSwitchStartTime = ulTimeNow;
+			queuePhaseSync(PhaseSyncFeature());
+
+		}
+
+		if (this->_ui8SwitchState == PUMP_SWITCH_STATE_PENDING)
+		{
+
+			if (this->_ui8OutputLevel == ui8DemandLevel)
+			{
+				// Request was reversed before it was applied - nothing to do
+				this->_ui8SwitchState = PUMP_SWITCH_STATE_SETTLED;
+				this->iOutputStateActual = this->iOutputStateRequested;
+				return;
+			}
+
+			if (phaseSyncReady(ulTimeNow, PhaseSyncFeature()) == false)
+			{
+				return;
+			}
+
+			// Match the Demand State!
+			AcksenHal::writeFastPin(this->_fpPumpOutput, ui8DemandLevel);
+			this->_ui8OutputLevel = ui8DemandLevel;
+			this->iOutputStateActual = this->iOutputStateRequested;
+
+			// Start the relay settling window
+			this->_ui8SwitchState = PUMP_SWITCH_STATE_SETTLING;
+			this->_ulSettlingEndTime = ulTimeNow + this->iPumpRelaySwitchingDelay;
+
+		}
+
+		if (this->_ui8SwitchState == PUMP_SWITCH_STATE_SETTLING)
+		{
+
+			if ((int32_t)(ulTimeNow - this->_ulSettlingEndTime) >= 0)
+			{
+				this->_ui8SwitchState = PUMP_SWITCH_STATE_SETTLED;
+				launchCallbackInitLCDs(LcdCallbackFeature());
+			}
+
+		}
+
+	}
+
+	// *** Ventilation ***
+
+	void startPump(AcksenPumpFeature<true>)
+	{
+		// Pump set to ON, Pump Vent On
+		this->iControlState = PUMP_CONTROL_VENT;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+		this->iVentilationCycleRuntimeCount = 0;
+	}
+
+	void startPump(AcksenPumpFeature<false>)
+	{
+		// Pump set to ON, no Pump Vent
+		this->iControlState = PUMP_CONTROL_ON;
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+	}
+
+	void processVentilation(unsigned long ulTimeNow, AcksenPumpFeature<true>)
+	{
+
+		if (this->iControlState != PUMP_CONTROL_VENT)
+		{
+			return;
+		}
+
+		// Initial Setup Condition
+		if ((this->iVentilationCycleRuntimeCount == 0) && (this->iOutputStateRequested == PUMP_OUTPUT_STATE_OFF))
+		{
+			this->_ulVentEndMillis = ulTimeNow + this->uiPumpVentilationOnLengthMillis;
+			this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+		}
+
+		// Check to see if the present condition has elapsed (rollover safe)
+		if ((int32_t)(ulTimeNow - this->_ulVentEndMillis) >= 0)
+		{
+
+			if (this->iOutputStateRequested == PUMP_OUTPUT_STATE_ON)
+			{
+				// ON cycle completed
+				this->iVentilationCycleRuntimeCount++;
+				this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+				this->_ulVentEndMillis = ulTimeNow + this->uiPumpVentilationOffLengthMillis;
+			}
+			else
+			{
+				// OFF cycle completed
+				this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+				this->_ulVentEndMillis = ulTimeNow + this->uiPumpVentilationOnLengthMillis;
+			}
+
+		}
+
+		// Check to see if the pump ventilation phase has ended
+		if (this->iVentilationCycleRuntimeCount > this->iPumpVentilationCycles)
+		{
+
+			if (this->iOperatingMode == PUMP_OPERATING_MODE_ON)
+			{
+				this->iControlState = PUMP_CONTROL_ON;
+				this->iOutputStateRequested = PUMP_OUTPUT_STATE_ON;
+			}
+			else
+			{
+				this->iControlState = PUMP_CONTROL_STOP;
+				this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+			}
+
+		}
+
+	}
+
+	void processVentilation(unsigned long, AcksenPumpFeature<false>) {}
+
+	void ventilationDeadline(unsigned long &ulNextEvent, AcksenPumpFeature<true>)
+	{
+
+		if ((this->iControlState == PUMP_CONTROL_VENT) && ((int32_t)(this->_ulVentEndMillis - ulNextEvent) < 0))
+		{
+			ulNextEvent = this->_ulVentEndMillis;
+		}
+
+	}
+
+	void ventilationDeadline(unsigned long &, AcksenPumpFeature<false>) {}
+
+	// *** Grain Rest ***
+
+	void processGrainRest(unsigned long ulTimeNow, AcksenPumpFeature<true>)
+	{
+
+		if ((this->iControlState != PUMP_CONTROL_GRAIN_REST) || (this->iOperatingMode != PUMP_OPERATING_MODE_ON))
+		{
+			return;
+		}
+
+		// Ensure that the Pump is temporarily turned off
+		this->iOutputStateRequested = PUMP_OUTPUT_STATE_OFF;
+
+		if ((int32_t)(ulTimeNow - this->_ulGrainRestEndMillis) >= 0)
+		{
+			// Grain Rest Complete - restart the Pump, venting again if available
+			startPump(VentilationFeature());
+		}
+
+	}
+
+	void processGrainRest(unsigned long, AcksenPumpFeature<false>) {}
+
+	void grainRestDeadline(unsigned long &ulNextEvent, AcksenPumpFeature<true>)
+	{
+
+		if ((this->iControlState == PUMP_CONTROL_GRAIN_REST) && ((int32_t)(this->_ulGrainRestEndMillis - ulNextEvent) < 0))
+		{
+			ulNextEvent = this->_ulGrainRestEndMillis;
+		}
+
+	}
+
+	void grainRestDeadline(unsigned long &, AcksenPumpFeature<false>) {}
+
+	// *** Phase Sync ***
+
+	void initPhaseSync(AcksenPumpFeature<true>)
+	{
+
+		if (PhasePin != -1)
+		{
+			AcksenHal::setPinMode(PhasePin, INPUT);
+			AcksenHal::resolveFastPin(this->_fpPhaseSyncInput, PhasePin);
+		}
+
+	}
+
+	void initPhaseSync(AcksenPumpFeature<false>) {}
+
+	void queuePhaseSync(AcksenPumpFeature<true>)
+	{
+
+		this->_bPhaseSyncEdgeSeen = false;
+		this->_ui8PhaseSyncLastLevel = HIGH;	// Require a LOW to HIGH edge
+		this->_bPhaseSyncPredicted = false;
+
+		if (this->_pPhaseSync != NULL)
+		{
+
+			// Schedule the switch for the edge shared with any other pump still within its delay, or the predicted Zero Crossing, plus any additional delay
+			this->_bPhaseSyncPredicted = this->_pPhaseSync->switchMicros((unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL, this->_ulPhaseSyncTarget);
+
+			if (this->_bPhaseSyncPredicted == false)
+			{
+				// Not yet locked - wait for the next captured edge
+				this->_ulPhaseSyncTarget = AcksenHal::timeMicros();
+			}
+
+		}
+
+	}
+
+	void queuePhaseSync(AcksenPumpFeature<false>) {}
+
+	bool phaseSyncReady(unsigned long ulTimeNow, AcksenPumpFeature<true>)
+	{
+
+		if (this->_pPhaseSync != NULL)
+		{
+
+			unsigned long ulDelayMicros = (unsigned long)this->iPhaseSyncPreActivationDelay * 1000UL;
+
+			if (this->_bPhaseSyncPredicted == false)
+			{
+
+				unsigned long ulEdgeMicros;
+
+				// AcksenPhaseSync not yet locked - every pump waiting from before the next captured edge switches on it
+				if (this->_pPhaseSync->edgeSince(this->_ulPhaseSyncTarget, ulEdgeMicros) == false)
+				{
+
+					if ((uint32_t)(AcksenHal::timeMicros() - this->_ulPhaseSyncTarget) <= (2UL * PHASE_SYNC_TIMEOUT * 1000UL))
+					{
+						return false;
+					}
+
+					// No edge seen within the usual time limit - proceed regardless
+					ulEdgeMicros = AcksenHal::timeMicros();
+
+				}
+
+				this->_bPhaseSyncPredicted = true;
+				this->_ulPhaseSyncTarget = ulEdgeMicros + ulDelayMicros;
+
+			}
+
+			// Switch at the scheduled point in the mains cycle, or the same point after the next edge if this pass is too late for it
+			return this->_pPhaseSync->switchDue(ulDelayMicros, this->_ulPhaseSyncTarget);
+
+		}
+
+		if (PhasePin == -1)
+		{
+			// No AcksenPhaseSync, and no pin to poll
+			return true;
+		}
+
+		if (this->_bPhaseSyncEdgeSeen == false)
+		{
+
+			uint8_t ui8PhaseLevel = AcksenHal::readFastPin(this->_fpPhaseSyncInput);
+
+			// Rising edge, or no edge seen within the usual time limit - proceed regardless
+			if (((ui8PhaseLevel == HIGH) && (this->_ui8PhaseSyncLastLevel == LOW)) || ((uint32_t)(ulTimeNow - this->_ulSwitchStartTime) > (2 * PHASE_SYNC_TIMEOUT)))
+			{
+				this->_bPhaseSyncEdgeSeen = true;
+				this->_ulPhaseSyncTarget = ulTimeNow;
+			}
+
+			this->_ui8PhaseSyncLastLevel = ui8PhaseLevel;
+
+			if (this->_bPhaseSyncEdgeSeen == false)
+			{
+				return false;
+			}
+
+		}
+
+		return ((uint32_t)(ulTimeNow - this->_ulPhaseSyncTarget) >= this->iPhaseSyncPreActivationDelay);
+
+	}
+
+	bool phaseSyncReady(unsigned long, AcksenPumpFeature<false>) { return true; }
+
+	// *** Maximum Pump Temperature ***
+
+	bool overTemperature(AcksenPumpFeature<true>)
+	{
+		return (this->_iPumpTemperatureCenti >= AcksenPumpLimitCentidegrees(this->iMaxPumpTemperature));
+	}
+
+	bool overTemperature(AcksenPumpFeature<false>) { return false; }
+
+	void storeTemperature(int16_t iCentidegrees, AcksenPumpFeature<true>)
+	{
+		this->_iPumpTemperatureCenti = iCentidegrees;
+	}
+
+	void storeTemperature(int16_t, AcksenPumpFeature<false>) {}
+
+	// *** LCD Callback ***
+
+	void launchCallbackInitLCDs(AcksenPumpFeature<true>)
+	{
+
+		if (this->callbackInitLCDs != NULL)
+		{
+			(*this->callbackInitLCDs)();
+		}
+
+		if (this->_pNotifier != NULL)
+		{
+			this->_pNotifier->notify();
+		}
+
+	}
+
+	void launchCallbackInitLCDs(AcksenPumpFeature<false>) {}
+
+};
+
+template <int OutputPin, int PhasePin, int Logic, uint8_t Features> constexpr int AcksenPumpT<OutputPin, PhasePin, Logic, Features>::iPumpOnState;
+template <int OutputPin, int PhasePin, int Logic, uint8_t Features> constexpr int AcksenPumpT<OutputPin, PhasePin, Logic, Features>::iPumpOffState;
+
+#endif
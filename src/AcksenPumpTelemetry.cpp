@@ -0,0 +1,460 @@
+/*!
+@file AcksenPumpTelemetry.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenPumpTelemetry.h"
+
+#include <string.h>
+
+#if (PUMP_TELEMETRY_BUFFER_SIZE & (PUMP_TELEMETRY_BUFFER_SIZE - 1)) != 0 || PUMP_TELEMETRY_BUFFER_SIZE > 128
+#error "PUMP_TELEMETRY_BUFFER_SIZE must be a power of 2, no greater than 128"
+#endif
+
+#define PUMP_TELEMETRY_BUFFER_MASK		(PUMP_TELEMETRY_BUFFER_SIZE - 1)
+
+bool AcksenPumpTelemetry::addPump(AcksenPump *pPump, uint8_t ui8PumpId)
+{
+
+	if ((pPump == NULL) || (this->_ui8PumpCount >= PUMP_TELEMETRY_MAX_PUMPS))
+	{
+		return false;
+	}
+
+	uint8_t i = this->_ui8PumpCount++;
+
+	this->_pPumps[i] = pPump;
+	this->_ui8PumpIds[i] = ui8PumpId;
+
+	// First snapshot is a key frame
+	this->_ui8SnapshotsToKey[i] = 0;
+
+	return true;
+
+}
+
+uint8_t AcksenPumpTelemetry::sendSnapshots(void)
+{
+
+	uint8_t ui8Queued = 0;
+
+	for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+	{
+
+		AcksenPump *pPump = this->_pPumps[i];
+		bool bKey = (this->_ui8SnapshotsToKey[i] == 0);
+
+		uint8_t ui8ControlState = (uint8_t)pPump->iControlState;
+		uint8_t ui8OutputState = (uint8_t)pPump->iOutputStateActual;
+		int16_t iTemperatureCenti = pPump->pumpTemperatureCentidegrees();
+		uint8_t ui8FlowPercent = pPump->flowPercent();
+
+		uint8_t ui8Payload[7];
+		uint8_t ui8Length = 2;
+		uint8_t ui8Mask = (bKey == true) ? PUMP_TELEMETRY_FIELD_KEY : 0;
+
+		// Fields in bit order, leaving out any unchanged since the last snapshot
+		if ((bKey == true) || (ui8ControlState != this->_ui8SentControlState[i]))
+		{
+			ui8Mask |= PUMP_TELEMETRY_FIELD_CONTROL_STATE;
+			ui8Payload[ui8Length++] = ui8ControlState;
+		}
+
+		if ((bKey == true) || (ui8OutputState != this->_ui8SentOutputState[i]))
+		{
+			ui8Mask |= PUMP_TELEMETRY_FIELD_OUTPUT_STATE;
+			ui8Payload[ui8Length++] = ui8OutputState;
+		}
+
+		if ((bKey == true) || (iTemperatureCenti != this->_iSentTemperatureCenti[i]))
+		{
+			ui8Mask |= PUMP_TELEMETRY_FIELD_TEMPERATURE;
+			ui8Payload[ui8Length++] = (uint8_t)((uint16_t)iTemperatureCenti & 0xFF);
+			ui8Payload[ui8Length++] = (uint8_t)((uint16_t)iTemperatureCenti >> 8);
+		}
+
+		if ((bKey == true) || (ui8FlowPercent != this->_ui8SentFlowPercent[i]))
+		{
+			ui8Mask |= PUMP_TELEMETRY_FIELD_FLOW;
+			ui8Payload[ui8Length++] = ui8FlowPercent;
+		}
+
+		ui8Payload[0] = this->_ui8PumpIds[i];
+		ui8Payload[1] = ui8Mask;
+
+		if (queueFrame(PUMP_TELEMETRY_FRAME_SNAPSHOT, AcksenHal::timeMillis(), ui8Payload, ui8Length) == false)
+		{
+			// Dropped - queueFrame() has already scheduled key frames
+			continue;
+		}
+
+		this->_ui8SentControlState[i] = ui8ControlState;
+		this->_ui8SentOutputState[i] = ui8OutputState;
+		this->_iSentTemperatureCenti[i] = iTemperatureCenti;
+		this->_ui8SentFlowPercent[i] = ui8FlowPercent;
+		this->_ui8SnapshotsToKey[i] = (bKey == true) ? (PUMP_TELEMETRY_KEY_INTERVAL - 1) : (this->_ui8SnapshotsToKey[i] - 1);
+
+		ui8Queued++;
+
+	}
+
+	return ui8Queued;
+
+}
+
+bool AcksenPumpTelemetry::sendEvent(const AcksenPumpEvent &evEvent)
+{
+
+	uint8_t ui8Payload[3];
+
+	ui8Payload[0] = evEvent.ui8PumpId;
+	ui8Payload[1] = evEvent.ui8Type;
+	ui8Payload[2] = evEvent.ui8Value;
+
+	return queueFrame(PUMP_TELEMETRY_FRAME_EVENT, evEvent.ulTimeMillis, ui8Payload, sizeof(ui8Payload));
+
+}
+
+uint8_t AcksenPumpTelemetry::sendEvents(AcksenPumpEventQueue &eqQueue)
+{
+
+	uint8_t ui8Queued = 0;
+	AcksenPumpEvent evEvent;
+
+	// Only take events there is room for, so none are lost from the queue
+	while (((PUMP_TELEMETRY_BUFFER_SIZE - pending()) >= PUMP_TELEMETRY_EVENT_FRAME_MAX) && (eqQueue.pop(evEvent) == true))
+	{
+
+		if (sendEvent(evEvent) == true)
+		{
+			ui8Queued++;
+		}
+
+	}
+
+	return ui8Queued;
+
+}
+
+bool AcksenPumpTelemetry::queueFrame(uint8_t ui8Type, unsigned long ulTimeMillis, const uint8_t *pPayload, uint8_t ui8PayloadLength)
+{
+
+	uint8_t ui8Frame[PUMP_TELEMETRY_FRAME_MAX];
+	uint8_t ui8Length = 0;
+
+	// Full time once the previous frame is too far away for the 16-bit time to be unambiguous
+	int32_t lDelta = (int32_t)(ulTimeMillis - this->_ulLastFrameMillis);
+	bool bFullTime = (this->_bTimeSynced == false) || (lDelta > PUMP_TELEMETRY_FULL_TIME_INTERVAL) || (lDelta < -PUMP_TELEMETRY_FULL_TIME_INTERVAL);
+
+	ui8Frame[ui8Length++] = PUMP_TELEMETRY_SYNC;
+	ui8Length++;	// LENGTH, filled below
+	ui8Frame[ui8Length++] = this->_ui8Sequence;
+	ui8Frame[ui8Length++] = ui8Type | ((bFullTime == true) ? PUMP_TELEMETRY_FLAG_FULL_TIME : 0);
+
+	ui8Frame[ui8Length++] = (uint8_t)(ulTimeMillis & 0xFF);
+	ui8Frame[ui8Length++] = (uint8_t)((ulTimeMillis >> 8) & 0xFF);
+
+	if (bFullTime == true)
+	{
+		ui8Frame[ui8Length++] = (uint8_t)((ulTimeMillis >> 16) & 0xFF);
+		ui8Frame[ui8Length++] = (uint8_t)((ulTimeMillis >> 24) & 0xFF);
+	}
+
+	memcpy(&ui8Frame[ui8Length], pPayload, ui8PayloadLength);
+	ui8Length += ui8PayloadLength;
+
+	ui8Frame[1] = ui8Length - 2;
+
+	uint16_t uiCrc = AcksenPumpCrc16(&ui8Frame[1], ui8Length - 1);
+
+	ui8Frame[ui8Length++] = (uint8_t)(uiCrc & 0xFF);
+	ui8Frame[ui8Length++] = (uint8_t)(uiCrc >> 8);
+
+	// Sequence advances for dropped frames too, so the receiver sees the gap
+	this->_ui8Sequence++;
+
+	if ((PUMP_TELEMETRY_BUFFER_SIZE - pending()) < ui8Length)
+	{
+
+		this->_uiDroppedCount++;
+
+		// Receiver can no longer apply changes, or extend 16-bit times - restart from key frames and the full time
+		this->_bTimeSynced = false;
+
+		for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+		{
+			this->_ui8SnapshotsToKey[i] = 0;
+		}
+
+		return false;
+
+	}
+
+	for (uint8_t i = 0; i < ui8Length; i++)
+	{
+		this->_ui8Buffer[(uint8_t)(this->_ui8Head + i) & PUMP_TELEMETRY_BUFFER_MASK] = ui8Frame[i];
+	}
+
+	this->_ui8Head += ui8Length;
+
+	this->_bTimeSynced = true;
+	this->_ulLastFrameMillis = ulTimeMillis;
+
+	return true;
+
+}
+
+AcksenPumpTelemetryDecoder::AcksenPumpTelemetryDecoder()
+{
+	memset(this->_stPumps, 0, sizeof(this->_stPumps));
+	memset(&this->_evLastEvent, 0, sizeof(this->_evLastEvent));
+}
+
+uint8_t AcksenPumpTelemetryDecoder::feed(uint8_t ui8Byte)
+{
+
+	if (this->_ui8Expected == 0)
+	{
+
+		// Waiting for SYNC
+		if (ui8Byte == PUMP_TELEMETRY_SYNC)
+		{
+			this->_ui8FrameLength = 0;
+			this->_ui8Expected = 1;
+		}
+
+		return 0;
+
+	}
+
+	this->_ui8Frame[this->_ui8FrameLength++] = ui8Byte;
+
+	if (this->_ui8FrameLength == 1)
+	{
+
+		// LENGTH - at least SEQUENCE, TYPE and TIME, and the whole frame must fit
+		if ((ui8Byte < 4) || (ui8Byte > (PUMP_TELEMETRY_FRAME_MAX - 4)))
+		{
+			this->_ulErrorCount++;
+			this->_ui8Expected = 0;
+			return 0;
+		}
+
+		this->_ui8Expected = 1 + ui8Byte + 2;
+		return 0;
+
+	}
+
+	if (this->_ui8FrameLength < this->_ui8Expected)
+	{
+		return 0;
+	}
+
+	// Frame complete - resynchronise on the next SYNC either way
+	this->_ui8Expected = 0;
+
+	uint8_t ui8CrcOffset = this->_ui8FrameLength - 2;
+	uint16_t uiCrc = (uint16_t)this->_ui8Frame[ui8CrcOffset] | ((uint16_t)this->_ui8Frame[ui8CrcOffset + 1] << 8);
+
+	if (AcksenPumpCrc16(this->_ui8Frame, ui8CrcOffset) != uiCrc)
+	{
+		this->_ulErrorCount++;
+		return 0;
+	}
+
+	return decodeFrame();
+
+}
+
+uint8_t AcksenPumpTelemetryDecoder::decodeFrame(void)
+{
+
+	uint8_t ui8End = this->_ui8FrameLength - 2;
+	uint8_t ui8Sequence = this->_ui8Frame[1];
+	uint8_t ui8Type = this->_ui8Frame[2] & PUMP_TELEMETRY_FRAME_TYPE_MASK;
+	bool bFullTime = ((this->_ui8Frame[2] & PUMP_TELEMETRY_FLAG_FULL_TIME) != 0);
+	uint8_t i = 3;
+
+	if ((bFullTime == true) && (ui8End < 7))
+	{
+		this->_ulErrorCount++;
+		return 0;
+	}
+
+	// Any lost frame may have held changes the following snapshots depend on
+	if ((this->_bSequenceKnown == true) && (ui8Sequence != this->_ui8NextSequence))
+	{
+
+		this->_ulLostCount += (uint8_t)(ui8Sequence - this->_ui8NextSequence);
+
+		for (uint8_t j = 0; j < this->_ui8PumpCount; j++)
+		{
+			this->_stPumps[j].bValid = false;
+		}
+
+	}
+
+	this->_bSequenceKnown = true;
+	this->_ui8NextSequence = ui8Sequence + 1;
+
+	uint16_t uiTimeLow = (uint16_t)this->_ui8Frame[i] | ((uint16_t)this->_ui8Frame[i + 1] << 8);
+	i += 2;
+
+	if (bFullTime == true)
+	{
+		this->_ulTimeMillis = (unsigned long)uiTimeLow | ((unsigned long)this->_ui8Frame[i] << 16) | ((unsigned long)this->_ui8Frame[i + 1] << 24);
+		this->_bTimeKnown = true;
+		i += 2;
+	}
+	else if (this->_bTimeKnown == true)
+	{
+		// Nearest time with these low 16 bits, relative to the previous frame
+		this->_ulTimeMillis += (long)(int16_t)(uint16_t)(uiTimeLow - (uint16_t)this->_ulTimeMillis);
+	}
+	else
+	{
+		this->_ulTimeMillis = uiTimeLow;
+	}
+
+	this->_ulFrameCount++;
+
+	if (ui8Type == PUMP_TELEMETRY_FRAME_EVENT)
+	{
+
+		if ((ui8End - i) != 3)
+		{
+			this->_ulErrorCount++;
+			return 0;
+		}
+
+		this->_evLastEvent.ulTimeMillis = this->_ulTimeMillis;
+		this->_evLastEvent.ui8PumpId = this->_ui8Frame[i];
+		this->_evLastEvent.ui8Type = this->_ui8Frame[i + 1];
+		this->_evLastEvent.ui8Value = this->_ui8Frame[i + 2];
+
+		return PUMP_TELEMETRY_FRAME_EVENT;
+
+	}
+
+	if (ui8Type != PUMP_TELEMETRY_FRAME_SNAPSHOT)
+	{
+		// Unknown Frame Type, from a later library version - skip it
+		return 0;
+	}
+
+	if ((ui8End - i) < 2)
+	{
+		this->_ulErrorCount++;
+		return 0;
+	}
+
+	int iPump = findPump(this->_ui8Frame[i], true);
+	uint8_t ui8Mask = this->_ui8Frame[i + 1];
+	i += 2;
+
+	// Check the length matches the fields present before applying any
+	uint8_t ui8FieldBytes = (((ui8Mask & PUMP_TELEMETRY_FIELD_CONTROL_STATE) != 0) ? 1 : 0) + (((ui8Mask & PUMP_TELEMETRY_FIELD_OUTPUT_STATE) != 0) ? 1 : 0) +
+		(((ui8Mask & PUMP_TELEMETRY_FIELD_TEMPERATURE) != 0) ? 2 : 0) + (((ui8Mask & PUMP_TELEMETRY_FIELD_FLOW) != 0) ? 1 : 0);
+
+	if (((ui8End - i) != ui8FieldBytes) || (iPump == -1))
+	{
+		this->_ulErrorCount++;
+		return 0;
+	}
+
+	AcksenPumpTelemetryState &stState = this->_stPumps[iPump];
+
+	stState.ulTimeMillis = this->_ulTimeMillis;
+
+	if ((ui8Mask & PUMP_TELEMETRY_FIELD_CONTROL_STATE) != 0)
+	{
+		stState.ui8ControlState = this->_ui8Frame[i++];
+	}
+
+	if ((ui8Mask & PUMP_TELEMETRY_FIELD_OUTPUT_STATE) != 0)
+	{
+		stState.ui8OutputState = this->_ui8Frame[i++];
+	}
+
+	if ((ui8Mask & PUMP_TELEMETRY_FIELD_TEMPERATURE) != 0)
+	{
+		stState.iTemperatureCenti = (int16_t)((uint16_t)this->_ui8Frame[i] | ((uint16_t)this->_ui8Frame[i + 1] << 8));
+		i += 2;
+	}
+
+	if ((ui8Mask & PUMP_TELEMETRY_FIELD_FLOW) != 0)
+	{
+		stState.ui8FlowPercent = this->_ui8Frame[i++];
+	}
+
+	if ((ui8Mask & PUMP_TELEMETRY_FIELD_KEY) != 0)
+	{
+		stState.bValid = true;
+	}
+
+	this->_ui8LastPump = (uint8_t)iPump;
+
+	return PUMP_TELEMETRY_FRAME_SNAPSHOT;
+
+}
+
+bool AcksenPumpTelemetryDecoder::state(uint8_t ui8PumpId, AcksenPumpTelemetryState &stState)
+{
+
+	int iPump = findPump(ui8PumpId, false);
+
+	if (iPump == -1)
+	{
+		return false;
+	}
+
+	stState = this->_stPumps[iPump];
+
+	return stState.bValid;
+
+}
+
+int AcksenPumpTelemetryDecoder::findPump(uint8_t ui8PumpId, bool bAdd)
+{
+
+	for (uint8_t i = 0; i < this->_ui8PumpCount; i++)
+	{
+
+		if (this->_stPumps[i].ui8PumpId == ui8PumpId)
+		{
+			return i;
+		}
+
+	}
+
+	if ((bAdd == false) || (this->_ui8PumpCount >= PUMP_TELEMETRY_MAX_PUMPS))
+	{
+		return -1;
+	}
+
+	AcksenPumpTelemetryState &stState = this->_stPumps[this->_ui8PumpCount];
+
+	memset(&stState, 0, sizeof(stState));
+	stState.ui8PumpId = ui8PumpId;
+
+	return this->_ui8PumpCount++;
+
+}
@@ -0,0 +1,333 @@
+/*!
+@file AcksenPumpTelemetry.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Compact binary telemetry.  Pump snapshots and events are encoded into small CRC-checked frames, with snapshot fields that have not changed left out,
+// and queued in a ring buffer that is drained only as fast as the port will accept bytes, so reporting never blocks pump control.
+//
+// Frame layout (multi-byte values little-endian):
+//   SYNC (0xA5), LENGTH, SEQUENCE, TYPE, TIME (2 Bytes, or 4 with PUMP_TELEMETRY_FLAG_FULL_TIME), payload, CRC-16 (2 Bytes)
+//   LENGTH counts SEQUENCE to the end of the payload.  The CRC (AcksenPumpCrc16) covers LENGTH to the end of the payload.
+//   Without PUMP_TELEMETRY_FLAG_FULL_TIME, TIME is the low 16 bits of millis(), relative to the previous frame.
+//
+// Snapshot payload: PUMP ID, FIELD MASK, then each field present in the mask, in bit order.
+// Event payload: PUMP ID, EVENT TYPE, EVENT VALUE (as AcksenPumpEvent).
+//
+
+#ifndef AcksenPumpTelemetry_h
+#define AcksenPumpTelemetry_h
+
+#include "AcksenPump.h"
+
+// *** TELEMETRY CONSTANTS ***
+#define PUMP_TELEMETRY_BUFFER_SIZE				128		///< Capacity of the transmit ring buffer, in Bytes.  Must be a power of 2, no greater than 128.
+#define PUMP_TELEMETRY_MAX_PUMPS				4		///< Maximum number of pumps reported by one AcksenPumpTelemetry.
+#define PUMP_TELEMETRY_KEY_INTERVAL				16		///< Every Nth snapshot of each pump is a key frame, holding every field.
+#define PUMP_TELEMETRY_FULL_TIME_INTERVAL		30000	///< Frames further apart than this carry the full 32-bit time, in Milliseconds.
+#define PUMP_TELEMETRY_FRAME_MAX				20		///< Largest frame accepted by AcksenPumpTelemetryDecoder, in Bytes.
+#define PUMP_TELEMETRY_EVENT_FRAME_MAX			13		///< Largest event frame, in Bytes.
+
+#define PUMP_TELEMETRY_SYNC						0xA5	///< First Byte of every frame.
+
+// Frame Types
+#define PUMP_TELEMETRY_FRAME_SNAPSHOT			1		///< Pump snapshot.
+#define PUMP_TELEMETRY_FRAME_EVENT				2		///< Pump event, from an AcksenPumpEventQueue.
+#define PUMP_TELEMETRY_FRAME_TYPE_MASK			0x0F	///< Frame Type bits of the TYPE Byte.
+#define PUMP_TELEMETRY_FLAG_FULL_TIME			0x80	///< TIME holds all 32 bits of millis().
+
+// Snapshot Fields
+#define PUMP_TELEMETRY_FIELD_CONTROL_STATE		0x01	///< Control State (PUMP_CONTROL_), 1 Byte.
+#define PUMP_TELEMETRY_FIELD_OUTPUT_STATE		0x02	///< Actual Output State (PUMP_OUTPUT_STATE_), 1 Byte.
+#define PUMP_TELEMETRY_FIELD_TEMPERATURE		0x04	///< Pump Temperature, in hundredths of a degree Celsius, 2 Bytes.
+#define PUMP_TELEMETRY_FIELD_FLOW				0x08	///< Flow, in percent, 1 Byte.
+#define PUMP_TELEMETRY_FIELD_ALL				0x0F	///< Every field.
+#define PUMP_TELEMETRY_FIELD_KEY				0x80	///< Key frame - every field is present, whether changed or not.
+
+/**************************************************************************/
+/*! 
+    @brief  Decoded Pump snapshot
+*/
+/**************************************************************************/
+struct AcksenPumpTelemetryState
+{
+	unsigned long ulTimeMillis;		///< Sender millis() time of the last snapshot.
+	uint8_t ui8PumpId;				///< Pump Id, as given to AcksenPumpTelemetry::addPump().
+	uint8_t ui8ControlState;		///< Control State (PUMP_CONTROL_).
+	uint8_t ui8OutputState;			///< Actual Output State (PUMP_OUTPUT_STATE_).
+	uint8_t ui8FlowPercent;			///< Flow, in percent.
+	int16_t iTemperatureCenti;		///< Pump Temperature, in hundredths of a degree Celsius.
+	bool bValid;					///< Set once a key frame has been received, and cleared when frames are lost, until the next key frame.
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Encoder for the binary telemetry stream, with a non-blocking transmit ring buffer
+*/
+/**************************************************************************/
+class AcksenPumpTelemetry
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Add a pump to be reported by sendSnapshots().
+    @param  pPump
+            Pump to report.
+    @param  ui8PumpId
+            Id sent in its frames.  Use the same Id given to AcksenPump::attachEventQueue(), so snapshots and events match.
+    @return Returns true if the pump was added.
+			Returns false if PUMP_TELEMETRY_MAX_PUMPS pumps have already been added.
+*/
+/**************************************************************************/
+	bool addPump(AcksenPump *pPump, uint8_t ui8PumpId);
+
+/**************************************************************************/
+/*!
+    @brief  Queue a snapshot frame for every pump.  Only fields changed since the previous snapshot of each pump are sent, apart from key frames.
+    @return Number of frames queued.  Frames that do not fit in the buffer are dropped, and counted by droppedCount().
+*/
+/**************************************************************************/
+	uint8_t sendSnapshots();
+
+/**************************************************************************/
+/*!
+    @brief  Queue an event frame.
+    @param  evEvent
+            Event to send, e.g. from AcksenPumpEventQueue::pop().
+    @return Returns true if the frame was queued.
+			Returns false if the buffer was full.  The frame is dropped, and counted by droppedCount().
+*/
+/**************************************************************************/
+	bool sendEvent(const AcksenPumpEvent &evEvent);
+
+/**************************************************************************/
+/*!
+    @brief  Move events from an AcksenPumpEventQueue into the buffer, while there is room for them.  Events that do not fit stay in the queue.
+    @param  eqQueue
+            Event queue to read.
+    @return Number of events queued.
+*/
+/**************************************************************************/
+	uint8_t sendEvents(AcksenPumpEventQueue &eqQueue);
+
+/**************************************************************************/
+/*!
+    @brief  Write as much of the buffer as the port will accept without blocking.  Call from loop().
+    @param  port
+            Port with availableForWrite() and write(const uint8_t *, size_t), e.g. Serial.
+    @return Number of Bytes written.
+*/
+/**************************************************************************/
+	template <class Port>
+	size_t drain(Port &port)
+	{
+
+		size_t uiWritten = 0;
+		int iSpace = port.availableForWrite();
+
+		while ((iSpace > 0) && (pending() > 0))
+		{
+
+			// Largest contiguous block the port will take
+			uint8_t ui8Offset = this->_ui8Tail & (PUMP_TELEMETRY_BUFFER_SIZE - 1);
+			size_t uiBlock = PUMP_TELEMETRY_BUFFER_SIZE - ui8Offset;
+
+			if (uiBlock > pending())
+			{
+				uiBlock = pending();
+			}
+
+			if (uiBlock > (size_t)iSpace)
+			{
+				uiBlock = (size_t)iSpace;
+			}
+
+			size_t uiBlockWritten = port.write(&this->_ui8Buffer[ui8Offset], uiBlock);
+
+			this->_ui8Tail += (uint8_t)uiBlockWritten;
+			uiWritten += uiBlockWritten;
+			iSpace -= (int)uiBlockWritten;
+
+			if (uiBlockWritten < uiBlock)
+			{
+				// Port full
+				break;
+			}
+
+		}
+
+		return uiWritten;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of Bytes waiting to be written.
+    @return Byte count.
+*/
+/**************************************************************************/
+	uint8_t pending() { return (uint8_t)(this->_ui8Head - this->_ui8Tail); }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of frames dropped because the buffer was full.
+    @return Dropped frame count.
+*/
+/**************************************************************************/
+	unsigned int droppedCount() { return this->_uiDroppedCount; }
+
+protected:
+
+	bool queueFrame(uint8_t ui8Type, unsigned long ulTimeMillis, const uint8_t *pPayload, uint8_t ui8PayloadLength);
+
+	uint8_t _ui8Buffer[PUMP_TELEMETRY_BUFFER_SIZE];
+	uint8_t _ui8Head = 0;
+	uint8_t _ui8Tail = 0;
+
+	uint8_t _ui8Sequence = 0;
+	bool _bTimeSynced = false;
+	unsigned long _ulLastFrameMillis = 0;
+	unsigned int _uiDroppedCount = 0;
+
+	AcksenPump *_pPumps[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8PumpIds[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8PumpCount = 0;
+
+	// Last values sent for each pump
+	uint8_t _ui8SentControlState[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8SentOutputState[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8SentFlowPercent[PUMP_TELEMETRY_MAX_PUMPS];
+	int16_t _iSentTemperatureCenti[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8SnapshotsToKey[PUMP_TELEMETRY_MAX_PUMPS];
+
+};
+
+/**************************************************************************/
+/*! 
+    @brief  Decoder for the binary telemetry stream.  Resynchronises on the SYNC Byte, and detects lost frames from the sequence number.
+*/
+/**************************************************************************/
+class AcksenPumpTelemetryDecoder
+{
+
+public:
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenPumpTelemetryDecoder();
+
+/**************************************************************************/
+/*!
+    @brief  Decode the next Byte of the stream.
+    @param  ui8Byte
+            Received Byte.
+    @return Returns the Frame Type (PUMP_TELEMETRY_FRAME_) when a valid frame has been completed.
+			Returns 0 otherwise.
+*/
+/**************************************************************************/
+	uint8_t feed(uint8_t ui8Byte);
+
+/**************************************************************************/
+/*!
+    @brief  Get the pump state updated by the last snapshot frame.
+    @return Pump state.
+*/
+/**************************************************************************/
+	const AcksenPumpTelemetryState &snapshot() { return this->_stPumps[this->_ui8LastPump]; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the last event frame.
+    @return Event, with ui8PumpId holding the Pump Id.
+*/
+/**************************************************************************/
+	const AcksenPumpEvent &event() { return this->_evLastEvent; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the latest state of a pump.
+    @param  ui8PumpId
+            Pump Id.
+    @param  stState
+            Receives the state.
+    @return Returns true if a key frame has been received for the pump, and no frames have been lost since.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool state(uint8_t ui8PumpId, AcksenPumpTelemetryState &stState);
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of valid frames decoded.
+    @return Frame count.
+*/
+/**************************************************************************/
+	unsigned long frameCount() { return this->_ulFrameCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of frames rejected for a bad CRC or length.
+    @return Error count.
+*/
+/**************************************************************************/
+	unsigned long errorCount() { return this->_ulErrorCount; }
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of frames lost, from gaps in the sequence number.
+    @return Lost frame count.
+*/
+/**************************************************************************/
+	unsigned long lostCount() { return this->_ulLostCount; }
+
+protected:
+
+	uint8_t decodeFrame();
+	int findPump(uint8_t ui8PumpId, bool bAdd);
+
+	uint8_t _ui8Frame[PUMP_TELEMETRY_FRAME_MAX];
+	uint8_t _ui8FrameLength = 0;
+	uint8_t _ui8Expected = 0;
+
+	bool _bSequenceKnown = false;
+	uint8_t _ui8NextSequence = 0;
+	bool _bTimeKnown = false;
+	unsigned long _ulTimeMillis = 0;
+
+	AcksenPumpTelemetryState _stPumps[PUMP_TELEMETRY_MAX_PUMPS];
+	uint8_t _ui8PumpCount = 0;
+	uint8_t _ui8LastPump = 0;
+	AcksenPumpEvent _evLastEvent;
+
+	unsigned long _ulFrameCount = 0;
+	unsigned long _ulErrorCount = 0;
+	unsigned long _ulLostCount = 0;
+
+};
+
+#endif
@@ -0,0 +1,197 @@
+/*!
+@file AcksenRelayGuard.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenRelayGuard.h"
+
+AcksenRelayGuard::AcksenRelayGuard()
+{
+}
+
+bool AcksenRelayGuard::requestTransition(bool bTurnOn, unsigned long ulTimeNow)
+{
+
+	if (this->_bBypass == true)
+	{
+		return true;
+	}
+
+	refill(ulTimeNow);
+
+	// Earliest time allowed by the minimum dwell time in the present state
+	unsigned long ulAllowed = ulTimeNow;
+
+	if (this->_bSwitched == true)
+	{
+		ulAllowed = this->_ulLastTransitionMillis + (bTurnOn ? this->ulMinOffTime : this->ulMinOnTime);
+	}
+
+	// ...and by the token bucket
+	if ((this->ulRefillTime != 0) && (this->_ui8Tokens == 0))
+	{
+
+		unsigned long ulTokenMillis = this->_ulRefillMillis + this->ulRefillTime;
+
+		if ((int32_t)(ulTokenMillis - ulAllowed) > 0)
+		{
+			ulAllowed = ulTokenMillis;
+		}
+
+	}
+
+	if ((int32_t)(ulTimeNow - ulAllowed) >= 0)
+	{
+		return true;
+	}
+
+	// Defer, counting each deferred request once
+	if ((this->_bDeferred == false) || (this->_bDeferredTurnOn != bTurnOn))
+	{
+		this->_ulDeferredCount++;
+	}
+
+	this->_bDeferred = true;
+	this->_bDeferredTurnOn = bTurnOn;
+	this->_ulDeferredUntil = ulAllowed;
+
+	return false;
+
+}
+
+void AcksenRelayGuard::requestCleared(void)
+{
+
+	if (this->_bDeferred == true)
+	{
+		// Request reversed before it was applied - no transition needed
+		this->_ulCoalescedCount++;
+		this->_bDeferred = false;
+	}
+
+	this->_bBypass = false;
+
+}
+
+void AcksenRelayGuard::recordTransition(bool bTurnOn, unsigned long ulTimeNow)
+{
+
+	refill(ulTimeNow);
+
+	if (this->_ui8Tokens > 0)
+	{
+		this->_ui8Tokens--;
+	}
+
+	if (bTurnOn == true)
+	{
+		this->_ulOnCount++;
+	}
+	else
+	{
+		this->_ulOffCount++;
+	}
+
+	this->_ulLastTransitionMillis = ulTimeNow;
+	this->_bSwitched = true;
+	this->_bDeferred = false;
+	this->_bBypass = false;
+
+}
+
+void AcksenRelayGuard::refill(unsigned long ulTimeNow)
+{
+
+	if (this->_bPrimed == false)
+	{
+		// Start with a full bucket
+		this->_ui8Tokens = this->ui8BurstSize;
+		this->_ulRefillMillis = ulTimeNow;
+		this->_bPrimed = true;
+	}
+
+	if ((this->_ui8Tokens >= this->ui8BurstSize) || (this->ulRefillTime == 0))
+	{
+		// Bucket full - the next token starts to be earned from now
+		this->_ulRefillMillis = ulTimeNow;
+		return;
+	}
+
+	unsigned long ulEarned = (uint32_t)(ulTimeNow - this->_ulRefillMillis) / this->ulRefillTime;
+
+	if (ulEarned == 0)
+	{
+		return;
+	}
+
+	this->_ulRefillMillis += ulEarned * this->ulRefillTime;
+
+	if (ulEarned >= (unsigned long)(this->ui8BurstSize - this->_ui8Tokens))
+	{
+		this->_ui8Tokens = this->ui8BurstSize;
+	}
+	else
+	{
+		this->_ui8Tokens += (uint8_t)ulEarned;
+	}
+
+}
+
+void AcksenRelayGuard::bypassNext(void)
+{
+	this->_bBypass = true;
+}
+
+bool AcksenRelayGuard::deferred(void)
+{
+	return this->_bDeferred;
+}
+
+unsigned long AcksenRelayGuard::nextAllowedMillis(void)
+{
+	return this->_ulDeferredUntil;
+}
+
+unsigned long AcksenRelayGuard::onCount(void)
+{
+	return this->_ulOnCount;
+}
+
+unsigned long AcksenRelayGuard::offCount(void)
+{
+	return this->_ulOffCount;
+}
+
+unsigned long AcksenRelayGuard::deferredCount(void)
+{
+	return this->_ulDeferredCount;
+}
+
+unsigned long AcksenRelayGuard::coalescedCount(void)
+{
+	return this->_ulCoalescedCount;
+}
+
+void AcksenRelayGuard::setLifetimeCounts(unsigned long ulOnCount, unsigned long ulOffCount)
+{
+	this->_ulOnCount = ulOnCount;
+	this->_ulOffCount = ulOffCount;
+}
@@ -0,0 +1,185 @@
+/*!
+@file AcksenRelayGuard.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Relay wear limiter, enforcing minimum ON/OFF dwell times and a token bucket cap on Pump Output transitions, with lifetime switch counters.
+//
+
+#ifndef AcksenRelayGuard_h
+#define AcksenRelayGuard_h
+
+#include "AcksenPumpHal.h"
+
+// *** RELAY GUARD CONSTANTS ***
+#define RELAY_GUARD_MIN_ON_TIME_DEFAULT			2000	///< Minimum time the Pump Output is held ON before it can be switched OFF, in Milliseconds.
+#define RELAY_GUARD_MIN_OFF_TIME_DEFAULT		2000	///< Minimum time the Pump Output is held OFF before it can be switched ON, in Milliseconds.
+#define RELAY_GUARD_BURST_DEFAULT				10		///< Token bucket size - number of transitions allowed back-to-back.
+#define RELAY_GUARD_REFILL_TIME_DEFAULT			6000	///< Time to earn back one transition, in Milliseconds (6000 = 10 transitions per minute, sustained).  0 disables the token bucket.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that limits how often an AcksenPump can switch its relay.  Attach with AcksenPump::attachRelayGuard().
+			Transitions that would break the limits are deferred, not dropped.  If the request is reversed while deferred, no transition happens at all.
+*/
+/**************************************************************************/
+class AcksenRelayGuard
+{
+
+public:
+
+	unsigned long ulMinOnTime = RELAY_GUARD_MIN_ON_TIME_DEFAULT;		///< Minimum ON dwell time, in Milliseconds.
+	unsigned long ulMinOffTime = RELAY_GUARD_MIN_OFF_TIME_DEFAULT;		///< Minimum OFF dwell time, in Milliseconds.
+	unsigned long ulRefillTime = RELAY_GUARD_REFILL_TIME_DEFAULT;		///< Time to earn back one transition, in Milliseconds.  0 disables the token bucket.
+	uint8_t ui8BurstSize = RELAY_GUARD_BURST_DEFAULT;					///< Number of transitions allowed back-to-back.  Set before the first transition.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenRelayGuard();
+
+/**************************************************************************/
+/*!
+    @brief  Ask if a Pump Output transition may happen now.  Called by AcksenPump each pass while a transition is wanted.
+    @param  bTurnOn
+            Set to true for an OFF to ON transition.
+    @param  ulTimeNow
+            Present millis() time.
+    @return Returns true if the transition may be applied now.
+			Returns false if it must be deferred until nextAllowedMillis().
+*/
+/**************************************************************************/
+	bool requestTransition(bool bTurnOn, unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Tell the guard that no transition is wanted (the Pump Output matches the request).  A deferred transition is counted as coalesced.
+    @return No return value.
+*/
+/**************************************************************************/
+	void requestCleared();
+
+/**************************************************************************/
+/*!
+    @brief  Record a Pump Output transition.  Called by AcksenPump whenever the output is switched.
+    @param  bTurnOn
+            Set to true for an OFF to ON transition.
+    @param  ulTimeNow
+            Present millis() time.
+    @return No return value.
+*/
+/**************************************************************************/
+	void recordTransition(bool bTurnOn, unsigned long ulTimeNow);
+
+/**************************************************************************/
+/*!
+    @brief  Let the next transition through regardless of limits.  Used by AcksenPump for turnOff() and over temperature stops.
+    @return No return value.
+*/
+/**************************************************************************/
+	void bypassNext();
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a transition is presently being deferred.
+    @return Returns true if a transition is deferred.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool deferred();
+
+/**************************************************************************/
+/*!
+    @brief  Get the time the deferred transition will be allowed.
+    @return millis() time.  Only valid when deferred() returns true.
+*/
+/**************************************************************************/
+	unsigned long nextAllowedMillis();
+
+/**************************************************************************/
+/*!
+    @brief  Get the lifetime number of OFF to ON transitions.
+    @return Transition count.
+*/
+/**************************************************************************/
+	unsigned long onCount();
+
+/**************************************************************************/
+/*!
+    @brief  Get the lifetime number of ON to OFF transitions.
+    @return Transition count.
+*/
+/**************************************************************************/
+	unsigned long offCount();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of transitions that have been deferred.
+    @return Deferral count.
+*/
+/**************************************************************************/
+	unsigned long deferredCount();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of deferred transitions that were cancelled by a reversed request, and never applied.
+    @return Coalesced count.
+*/
+/**************************************************************************/
+	unsigned long coalescedCount();
+
+/**************************************************************************/
+/*!
+    @brief  Restore the lifetime transition counts, e.g. from EEPROM after a restart.
+    @param  ulOnCount
+            Lifetime OFF to ON transitions.
+    @param  ulOffCount
+            Lifetime ON to OFF transitions.
+    @return No return value.
+*/
+/**************************************************************************/
+	void setLifetimeCounts(unsigned long ulOnCount, unsigned long ulOffCount);
+
+protected:
+
+	unsigned long _ulLastTransitionMillis = 0;
+	unsigned long _ulRefillMillis = 0;			// Time the next token started to be earned
+	unsigned long _ulDeferredUntil = 0;
+	unsigned long _ulOnCount = 0;
+	unsigned long _ulOffCount = 0;
+	unsigned long _ulDeferredCount = 0;
+	unsigned long _ulCoalescedCount = 0;
+	uint8_t _ui8Tokens = 0;
+	bool _bPrimed = false;						// Token bucket filled
+	bool _bSwitched = false;					// At least one transition recorded, so dwell times apply
+	bool _bDeferred = false;
+	bool _bDeferredTurnOn = false;
+	bool _bBypass = false;
+
+	void refill(unsigned long ulTimeNow);
+
+};
+
+#endif
@@ -0,0 +1,212 @@
+/*!
+@file AcksenThermalGovernor.cpp
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+
+#include "AcksenThermalGovernor.h"
+
+AcksenThermalGovernor::AcksenThermalGovernor()
+{
+}
+
+void AcksenThermalGovernor::update(int16_t iTemperatureTenths, int16_t iLimitTenths, unsigned long ulTimeMillis)
+{
+
+	if (this->_bPrimed == false)
+	{
+		// First reading - start the filter and rate at this temperature
+		this->_lFilterAccumulator = (int32_t)iTemperatureTenths << this->ui8FilterShift;
+		this->_iRateTenthsPerMinute = 0;
+		this->_iRateReferenceTenths = iTemperatureTenths;
+		this->_ulRateReferenceMillis = ulTimeMillis;
+		this->_bPrimed = true;
+	}
+	else
+	{
+		// Exponential moving average, in fixed point
+		this->_lFilterAccumulator += (int32_t)iTemperatureTenths - (this->_lFilterAccumulator >> this->ui8FilterShift);
+	}
+
+	int16_t iFilteredTenths = filteredTenths();
+	unsigned long ulInterval = (uint32_t)(ulTimeMillis - this->_ulRateReferenceMillis);
+
+	// Measure the rate over at least THERMAL_RATE_INTERVAL_MIN, so fast readings don't amplify noise
+	if (ulInterval >= THERMAL_RATE_INTERVAL_MIN)
+	{
+
+		int32_t lRate = ((int32_t)(iFilteredTenths - this->_iRateReferenceTenths) * 60000L) / (int32_t)ulInterval;
+
+		// Limit to the int16_t range
+		if (lRate > 32767L)
+		{
+			lRate = 32767L;
+		}
+		else if (lRate < -32767L)
+		{
+			lRate = -32767L;
+		}
+
+		this->_iRateTenthsPerMinute += (int16_t)((lRate - this->_iRateTenthsPerMinute) / (1 << this->ui8FilterShift));
+		this->_iRateReferenceTenths = iFilteredTenths;
+		this->_ulRateReferenceMillis = ulTimeMillis;
+
+	}
+
+	uint8_t ui8Reason = tripCheck(iLimitTenths);
+
+	if (this->_bTripped == false)
+	{
+
+		if (ui8Reason != THERMAL_TRIP_NONE)
+		{
+			startTrip(ui8Reason, ulTimeMillis);
+		}
+
+		return;
+
+	}
+
+	// Check to see if the trip can clear - cooled by the hysteresis, no longer heading for the limit, and rested long enough
+	if ((ui8Reason == THERMAL_TRIP_NONE) &&
+		(iFilteredTenths <= (iLimitTenths - (int16_t)this->ui8Hysteresis)) &&
+		((uint32_t)(ulTimeMillis - this->_ulTripMillis) >= ((unsigned long)this->uiResumeDelay * 1000UL)))
+	{
+		this->_bTripped = false;
+		this->_bResumePending = ((this->_bResumeArmed == true) && (this->ui8ResumePolicy == THERMAL_RESUME_AUTO));
+		this->_bResumeArmed = false;
+	}
+
+}
+
+uint8_t AcksenThermalGovernor::tripCheck(int16_t iLimitTenths)
+{
+
+	int16_t iFilteredTenths = filteredTenths();
+
+	if (iFilteredTenths >= iLimitTenths)
+	{
+		return THERMAL_TRIP_LIMIT;
+	}
+
+	if ((this->ui8PredictionHorizon != 0) && (this->_iRateTenthsPerMinute > 0))
+	{
+
+		// Project the filtered temperature forward over the prediction horizon
+		int32_t lPredictedTenths = (int32_t)iFilteredTenths + (((int32_t)this->_iRateTenthsPerMinute * this->ui8PredictionHorizon) / 60);
+
+		if (lPredictedTenths >= iLimitTenths)
+		{
+			return THERMAL_TRIP_PREDICTED;
+		}
+
+	}
+
+	return THERMAL_TRIP_NONE;
+
+}
+
+bool AcksenThermalGovernor::tripped(void)
+{
+	return this->_bTripped;
+}
+
+uint8_t AcksenThermalGovernor::tripReason(void)
+{
+	return this->_ui8TripReason;
+}
+
+uint16_t AcksenThermalGovernor::tripCount(void)
+{
+	return this->_uiTripCount;
+}
+
+float AcksenThermalGovernor::filteredTemperature(void)
+{
+	return ((float)filteredTenths() / 10.0f);
+}
+
+float AcksenThermalGovernor::temperatureRate(void)
+{
+	return ((float)this->_iRateTenthsPerMinute / 10.0f);
+}
+
+void AcksenThermalGovernor::tripLimit(unsigned long ulTimeMillis)
+{
+
+	if (this->_bTripped == false)
+	{
+		startTrip(THERMAL_TRIP_LIMIT, ulTimeMillis);
+	}
+
+}
+
+void AcksenThermalGovernor::startTrip(uint8_t ui8Reason, unsigned long ulTimeMillis)
+{
+	this->_bTripped = true;
+	this->_ui8TripReason = ui8Reason;
+	this->_ulTripMillis = ulTimeMillis;
+	this->_uiTripCount++;
+	this->_bResumeArmed = false;
+	this->_bResumePending = false;
+}
+
+void AcksenThermalGovernor::recordTrip(bool bWasRunning)
+{
+
+	if (bWasRunning == true)
+	{
+		this->_bResumeArmed = true;
+	}
+
+}
+
+bool AcksenThermalGovernor::takeResume(void)
+{
+
+	bool bResume = this->_bResumePending;
+	this->_bResumePending = false;
+
+	return bResume;
+
+}
+
+void AcksenThermalGovernor::cancelResume(void)
+{
+	this->_bResumeArmed = false;
+	this->_bResumePending = false;
+}
+
+void AcksenThermalGovernor::reset(void)
+{
+	this->_lFilterAccumulator = 0;
+	this->_iRateTenthsPerMinute = 0;
+	this->_uiTripCount = 0;
+	this->_ui8TripReason = THERMAL_TRIP_NONE;
+	this->_bPrimed = false;
+	this->_bTripped = false;
+	this->_bResumeArmed = false;
+	this->_bResumePending = false;
+}
+
+int16_t AcksenThermalGovernor::filteredTenths(void)
+{
+	return (int16_t)(this->_lFilterAccumulator >> this->ui8FilterShift);
+}
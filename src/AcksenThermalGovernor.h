@@ -0,0 +1,194 @@
+/*!
+@file AcksenThermalGovernor.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Over temperature governor, with a filtered Pump Temperature, resume hysteresis, rate-of-change prediction and automatic resume.
+//
+
+#ifndef AcksenThermalGovernor_h
+#define AcksenThermalGovernor_h
+
+#include "AcksenPumpHal.h"
+
+// *** THERMAL GOVERNOR CONSTANTS ***
+#define THERMAL_FILTER_SHIFT_DEFAULT			2		///< Temperature filter weight, as a power of 2 (each new reading contributes 1/4 of its error).
+#define THERMAL_HYSTERESIS_DEFAULT				50		///< Filtered temperature must fall this far below the Maximum Pump Temperature before the Pump can run again, in tenths of a degree Celsius.
+#define THERMAL_PREDICTION_HORIZON_DEFAULT		30		///< Trip early if the Maximum Pump Temperature will be reached within this time at the present rate of rise, in Seconds.  0 disables prediction.
+#define THERMAL_RESUME_DELAY_DEFAULT			60		///< Minimum time after a trip before the Pump can run again, in Seconds.
+#define THERMAL_RATE_INTERVAL_MIN				1000	///< Shortest interval over which the rate of change is measured, in Milliseconds.  Faster readings are accumulated.
+
+// Resume Policies
+#define THERMAL_RESUME_MANUAL					0		///< After a trip, the Pump stays stopped until restarted by the calling software.
+#define THERMAL_RESUME_AUTO						1		///< After a trip, the Pump restarts by itself once cooled (if it was running when it tripped).
+
+// Trip Reasons
+#define THERMAL_TRIP_NONE						0		///< No trip has occurred.
+#define THERMAL_TRIP_LIMIT						1		///< Filtered temperature reached the Maximum Pump Temperature.
+#define THERMAL_TRIP_PREDICTED					2		///< Filtered temperature was rising fast enough to reach the Maximum Pump Temperature within the prediction horizon.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that decides when an AcksenPump must stop for over temperature, and when it may run again.  Attach with AcksenPump::attachThermalGovernor().
+*/
+/**************************************************************************/
+class AcksenThermalGovernor
+{
+
+public:
+
+	uint8_t ui8FilterShift = THERMAL_FILTER_SHIFT_DEFAULT;				///< Temperature filter weight, as a power of 2.  Set before the first reading.
+	uint8_t ui8Hysteresis = THERMAL_HYSTERESIS_DEFAULT;				///< Resume hysteresis, in tenths of a degree Celsius.
+	uint8_t ui8PredictionHorizon = THERMAL_PREDICTION_HORIZON_DEFAULT;	///< Prediction horizon, in Seconds.  0 disables prediction.
+	uint8_t ui8ResumePolicy = THERMAL_RESUME_MANUAL;					///< THERMAL_RESUME_MANUAL or THERMAL_RESUME_AUTO.
+	uint16_t uiResumeDelay = THERMAL_RESUME_DELAY_DEFAULT;				///< Minimum time after a trip before the Pump can run again, in Seconds.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenThermalGovernor();
+
+/**************************************************************************/
+/*!
+    @brief  Add a temperature reading, and re-evaluate the trip.  Called by AcksenPump::updatePumpTemperature() when attached.
+    @param  iTemperatureTenths
+            Pump Temperature, in tenths of a degree Celsius.
+    @param  iLimitTenths
+            Maximum Pump Temperature, in tenths of a degree Celsius.
+    @param  ulTimeMillis
+            millis() time of the reading.
+    @return No return value.
+*/
+/**************************************************************************/
+	void update(int16_t iTemperatureTenths, int16_t iLimitTenths, unsigned long ulTimeMillis);
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if the Pump must be stopped.
+    @return Returns true from a trip until the Pump has cooled by the hysteresis, the temperature is no longer predicted to reach the limit, and the resume delay has elapsed.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool tripped();
+
+/**************************************************************************/
+/*!
+    @brief  Get the reason for the present, or most recent, trip.
+    @return THERMAL_TRIP_NONE, THERMAL_TRIP_LIMIT or THERMAL_TRIP_PREDICTED.
+*/
+/**************************************************************************/
+	uint8_t tripReason();
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of trips since initialisation or reset().
+    @return Number of trips.
+*/
+/**************************************************************************/
+	uint16_t tripCount();
+
+/**************************************************************************/
+/*!
+    @brief  Get the filtered Pump Temperature.
+    @return Filtered temperature in Celsius.
+*/
+/**************************************************************************/
+	float filteredTemperature();
+
+/**************************************************************************/
+/*!
+    @brief  Get the filtered rate of change of the Pump Temperature.
+    @return Rate of change in Celsius per Minute.  Positive when rising.
+*/
+/**************************************************************************/
+	float temperatureRate();
+
+/**************************************************************************/
+/*!
+    @brief  Trip at the Maximum Pump Temperature now, without waiting for the filter.  Called by AcksenPump when the unfiltered reading reaches the limit.
+			The trip then clears as any other, once the filtered temperature has cooled by the hysteresis and the resume delay has elapsed.
+    @param  ulTimeMillis
+            millis() time of the trip.
+    @return No return value.
+*/
+/**************************************************************************/
+	void tripLimit(unsigned long ulTimeMillis);
+
+/**************************************************************************/
+/*!
+    @brief  Record that the Pump has been stopped by a trip.  Called by AcksenPump.
+    @param  bWasRunning
+            Set to true if the Pump was running when it tripped, so it can be resumed under THERMAL_RESUME_AUTO.
+    @return No return value.
+*/
+/**************************************************************************/
+	void recordTrip(bool bWasRunning);
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a tripped Pump should now be restarted.  Called by AcksenPump.  Clears the pending resume.
+    @return Returns true once, after a trip clears, if the Pump was running and THERMAL_RESUME_AUTO is set.
+			Returns false otherwise.
+*/
+/**************************************************************************/
+	bool takeResume();
+
+/**************************************************************************/
+/*!
+    @brief  Cancel any pending automatic resume, e.g. when the Pump is turned off by the calling software.
+    @return No return value.
+*/
+/**************************************************************************/
+	void cancelResume();
+
+/**************************************************************************/
+/*!
+    @brief  Clear the filter, rate, trip and trip count.  The next reading restarts the filter.
+    @return No return value.
+*/
+/**************************************************************************/
+	void reset();
+
+protected:
+
+	int32_t _lFilterAccumulator = 0;		// Filtered temperature in tenths, scaled by 2^ui8FilterShift
+	int16_t _iRateTenthsPerMinute = 0;
+	int16_t _iRateReferenceTenths = 0;		// Filtered temperature at the start of the present rate interval
+	unsigned long _ulRateReferenceMillis = 0;
+	unsigned long _ulTripMillis = 0;
+	uint16_t _uiTripCount = 0;
+	uint8_t _ui8TripReason = THERMAL_TRIP_NONE;
+	bool _bPrimed = false;
+	bool _bTripped = false;
+	bool _bResumeArmed = false;				// Pump was running when it tripped
+	bool _bResumePending = false;
+
+	int16_t filteredTenths();
+	uint8_t tripCheck(int16_t iLimitTenths);
+	void startTrip(uint8_t ui8Reason, unsigned long ulTimeMillis);
+
+};
+
+#endif
@@ -0,0 +1,360 @@
+/*!
+@file AcksenTimerWheel.h
+ 
+*/
+ 
+/***********************************************************
+This source file is licenced using the 3-Clause BSD License.
+
+Copyright (c) 2026 Acksen Ltd, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission. 
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************/
+
+// Acksen Pump Library v1.9.0
+// (c) Acksen Ltd 2026
+//
+// Hashed timer wheel for pump deadlines.  Timers are kept in per-tick slots, so arming, cancelling and checking for expiry take constant time,
+// however many timers are armed.
+//
+
+#ifndef AcksenTimerWheel_h
+#define AcksenTimerWheel_h
+
+#include "AcksenPumpHal.h"
+
+// *** TIMER WHEEL CONSTANTS ***
+#define TIMER_WHEEL_SLOTS_DEFAULT				16		///< Default number of slots.  Must be a power of 2, no greater than 128.
+#define TIMER_WHEEL_TICK_DEFAULT				250		///< Default slot width, in Milliseconds.  One turn of the wheel is slots x tick.
+#define TIMER_WHEEL_NONE						0xFF	///< No timer / empty slot.
+
+/**************************************************************************/
+/*! 
+    @brief  Class that holds T timers (numbered 0 to T-1) on a wheel of S slots, each ulTickMillis wide.
+			Each timer is linked into the slot its deadline falls in, so expired() only looks at the slot under the cursor.
+			Deadlines more than one turn away stay in their slot until the cursor comes round to them again.
+*/
+/**************************************************************************/
+template <uint8_t T, uint8_t S = TIMER_WHEEL_SLOTS_DEFAULT>
+class AcksenTimerWheel
+{
+
+	static_assert((S != 0) && ((S & (S - 1)) == 0) && (S <= 128), "AcksenTimerWheel slot count must be a power of 2, no greater than 128");
+	static_assert(T < TIMER_WHEEL_NONE, "AcksenTimerWheel holds at most 254 timers");
+
+public:
+
+	unsigned long ulTickMillis = TIMER_WHEEL_TICK_DEFAULT;	///< Slot width, in Milliseconds.  Only change while no timer is armed.
+
+/**************************************************************************/
+/*!
+    @brief  Class initialisation.  All timers start disarmed.
+    @return No return value.
+*/
+/**************************************************************************/
+	AcksenTimerWheel()
+	{
+
+		for (uint8_t i = 0; i < S; i++)
+		{
+			this->_ui8Head[i] = TIMER_WHEEL_NONE;
+		}
+
+		for (uint8_t i = 0; i < T; i++)
+		{
+			this->_ui8Slot[i] = TIMER_WHEEL_NONE;
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Arm a timer, replacing any deadline it already had.
+    @param  ui8Timer
+            Timer number.
+    @param  ulTimeNow
+            Present millis() time.
+    @param  ulDelayMillis
+            Time until the timer expires, in Milliseconds.
+    @return No return value.
+*/
+/**************************************************************************/
+	void arm(uint8_t ui8Timer, unsigned long ulTimeNow, unsigned long ulDelayMillis)
+	{
+
+		cancel(ui8Timer);
+
+		if (this->_ui8Armed == 0)
+		{
+			// Empty wheel - bring the cursor up to date, rather than stepping through the idle time later
+			this->_ulCursorMillis = ulTimeNow;
+		}
+
+		unsigned long ulDeadline = ulTimeNow + ulDelayMillis;
+		uint8_t ui8Slot = this->_ui8Cursor;
+
+		if ((int32_t)(ulDeadline - this->_ulCursorMillis) > 0)
+		{
+			ui8Slot = (uint8_t)((this->_ui8Cursor + ((uint32_t)(ulDeadline - this->_ulCursorMillis) / this->ulTickMillis)) & (S - 1));
+		}
+
+		// Push onto the front of the slot list
+		this->_ulDeadline[ui8Timer] = ulDeadline;
+		this->_ui8Slot[ui8Timer] = ui8Slot;
+		this->_ui8Prev[ui8Timer] = TIMER_WHEEL_NONE;
+		this->_ui8Next[ui8Timer] = this->_ui8Head[ui8Slot];
+
+		if (this->_ui8Head[ui8Slot] != TIMER_WHEEL_NONE)
+		{
+			this->_ui8Prev[this->_ui8Head[ui8Slot]] = ui8Timer;
+		}
+
+		this->_ui8Head[ui8Slot] = ui8Timer;
+		this->_ui8Armed++;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Disarm a timer.  Does nothing if it is not armed.
+    @param  ui8Timer
+            Timer number.
+    @return No return value.
+*/
+/**************************************************************************/
+	void cancel(uint8_t ui8Timer)
+	{
+
+		uint8_t ui8Slot = this->_ui8Slot[ui8Timer];
+
+		if (ui8Slot == TIMER_WHEEL_NONE)
+		{
+			return;
+		}
+
+		// Unlink from the slot list
+		if (this->_ui8Prev[ui8Timer] != TIMER_WHEEL_NONE)
+		{
+			this->_ui8Next[this->_ui8Prev[ui8Timer]] = this->_ui8Next[ui8Timer];
+		}
+		else
+		{
+			this->_ui8Head[ui8Slot] = this->_ui8Next[ui8Timer];
+		}
+
+		if (this->_ui8Next[ui8Timer] != TIMER_WHEEL_NONE)
+		{
+			this->_ui8Prev[this->_ui8Next[ui8Timer]] = this->_ui8Prev[ui8Timer];
+		}
+
+		this->_ui8Slot[ui8Timer] = TIMER_WHEEL_NONE;
+		this->_ui8Armed--;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Used to determine if a timer is armed.
+    @param  ui8Timer
+            Timer number.
+    @return Returns true if the timer is armed, and has not yet been returned by expired().
+*/
+/**************************************************************************/
+	bool armed(uint8_t ui8Timer) { return (this->_ui8Slot[ui8Timer] != TIMER_WHEEL_NONE); }
+
+/**************************************************************************/
+/*!
+    @brief  Get the deadline of a timer.
+    @param  ui8Timer
+            Timer number.
+    @return millis() time the timer expires (or last expired, if no longer armed).
+*/
+/**************************************************************************/
+	unsigned long deadline(uint8_t ui8Timer) { return this->_ulDeadline[ui8Timer]; }
+
+/**************************************************************************/
+/*!
+    @brief  Take the next expired timer off the wheel.  Call repeatedly until it returns -1, to handle every expired timer.
+    @param  ulTimeNow
+            Present millis() time.
+    @return Number of an expired timer, which is disarmed.  Returns -1 if no timer has expired.
+*/
+/**************************************************************************/
+	int expired(unsigned long ulTimeNow)
+	{
+
+		if (this->_ui8Armed == 0)
+		{
+			return -1;
+		}
+
+		if ((uint32_t)(ulTimeNow - this->_ulCursorMillis) >= ((unsigned long)S * this->ulTickMillis))
+		{
+			// A full turn or more since the last call - every slot may hold an expired timer
+			for (uint8_t i = 0; i < S; i++)
+			{
+
+				int iTimer = takeExpired(i, ulTimeNow);
+
+				if (iTimer != -1)
+				{
+					return iTimer;
+				}
+
+			}
+
+			// None left - jump the cursor to the present slot
+			unsigned long ulTicks = (uint32_t)(ulTimeNow - this->_ulCursorMillis) / this->ulTickMillis;
+
+			this->_ui8Cursor = (uint8_t)((this->_ui8Cursor + ulTicks) & (S - 1));
+			this->_ulCursorMillis += ulTicks * this->ulTickMillis;
+
+			return -1;
+
+		}
+
+		while (true)
+		{
+
+			int iTimer = takeExpired(this->_ui8Cursor, ulTimeNow);
+
+			if (iTimer != -1)
+			{
+				return iTimer;
+			}
+
+			if ((uint32_t)(ulTimeNow - this->_ulCursorMillis) < this->ulTickMillis)
+			{
+				// Cursor is on the present slot
+				return -1;
+			}
+
+			// Slot passed - move on
+			this->_ui8Cursor = (this->_ui8Cursor + 1) & (S - 1);
+			this->_ulCursorMillis += this->ulTickMillis;
+
+		}
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the time the next timer expires, for sleeping until it is due.  Looks at each slot in turn from the cursor, then at every timer if all are more than a turn away,
+			so is not intended to be called every pass.
+    @param  ulTimeNow
+            Present millis() time.
+    @param  ulNextMillis
+            Receives the millis() time of the next expiry.
+    @return Returns true if any timer is armed.
+			Returns false if no timer is armed, with ulNextMillis unchanged.
+*/
+/**************************************************************************/
+	bool nextDeadline(unsigned long ulTimeNow, unsigned long &ulNextMillis)
+	{
+
+		if (this->_ui8Armed == 0)
+		{
+			return false;
+		}
+
+		unsigned long ulSlotMillis = this->_ulCursorMillis;
+
+		for (uint8_t i = 0; i < S; i++)
+		{
+
+			uint8_t ui8Slot = (this->_ui8Cursor + i) & (S - 1);
+			bool bFound = false;
+			unsigned long ulEarliest = 0;
+
+			// Deadlines on this turn (or overdue, in the cursor slot)
+			for (uint8_t j = this->_ui8Head[ui8Slot]; j != TIMER_WHEEL_NONE; j = this->_ui8Next[j])
+			{
+
+				if (((int32_t)(this->_ulDeadline[j] - (ulSlotMillis + this->ulTickMillis)) < 0) &&
+					((bFound == false) || ((int32_t)(this->_ulDeadline[j] - ulEarliest) < 0)))
+				{
+					ulEarliest = this->_ulDeadline[j];
+					bFound = true;
+				}
+
+			}
+
+			if (bFound == true)
+			{
+				ulNextMillis = ((int32_t)(ulEarliest - ulTimeNow) > 0) ? ulEarliest : ulTimeNow;
+				return true;
+			}
+
+			ulSlotMillis += this->ulTickMillis;
+
+		}
+
+		// Everything is at least a turn away - find the earliest deadline directly, so a host can sleep right through to it
+		bool bFound = false;
+		unsigned long ulEarliest = 0;
+
+		for (uint8_t i = 0; i < T; i++)
+		{
+
+			if ((this->_ui8Slot[i] != TIMER_WHEEL_NONE) && ((bFound == false) || ((int32_t)(this->_ulDeadline[i] - ulEarliest) < 0)))
+			{
+				ulEarliest = this->_ulDeadline[i];
+				bFound = true;
+			}
+
+		}
+
+		ulNextMillis = ulEarliest;
+		return true;
+
+	}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of armed timers.
+    @return Timer count.
+*/
+/**************************************************************************/
+	uint8_t armedCount() { return this->_ui8Armed; }
+
+protected:
+
+	unsigned long _ulDeadline[T];
+	uint8_t _ui8Slot[T];		// Slot each timer is linked into, or TIMER_WHEEL_NONE when disarmed
+	uint8_t _ui8Next[T];
+	uint8_t _ui8Prev[T];
+	uint8_t _ui8Head[S];		// First timer in each slot
+
+	uint8_t _ui8Cursor = 0;
+	unsigned long _ulCursorMillis = 0;	// Start of the cursor slot
+	uint8_t _ui8Armed = 0;
+
+	int takeExpired(uint8_t ui8Slot, unsigned long ulTimeNow)
+	{
+
+		for (uint8_t i = this->_ui8Head[ui8Slot]; i != TIMER_WHEEL_NONE; i = this->_ui8Next[i])
+		{
+
+			if ((int32_t)(ulTimeNow - this->_ulDeadline[i]) >= 0)
+			{
+				cancel(i);
+				return i;
+			}
+
+		}
+
+		return -1;
+
+	}
+
+};
+
+#endif